@@ -0,0 +1,420 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ntgcalls.h>
+
+namespace {
+    struct Options {
+        int calls = 10;
+        int duration = 30;
+        int rampMs = 50;
+        bool loopback = false;
+        bool sfu = false;
+        // Below zero keeps the library default, zero generates a certificate on every join
+        int certPool = -1;
+        std::string audio, video;
+        int16_t width = 1280, height = 720;
+        uint8_t fps = 30;
+    };
+
+    struct Counters {
+        std::atomic_uint64_t connected = 0;
+        std::atomic_uint64_t streamEnds = 0;
+        std::atomic_uint64_t audioFrames = 0;
+        std::atomic_uint64_t videoFrames = 0;
+        std::mutex mutex;
+        std::map<int64_t, std::chrono::steady_clock::time_point> joinStarted;
+        std::vector<double> joinSeconds;
+        // From the start of the join to the first decoded frame, the frames callback only locks while some are missing
+        std::atomic_int awaitingFirstFrame = 0;
+        std::map<int64_t, std::chrono::steady_clock::time_point> firstFrameStarted;
+        std::vector<double> firstFrameSeconds;
+    };
+
+    void printTimes(const char* label, std::vector<double>& times, const char* unit) {
+        if (times.empty()) {
+            return;
+        }
+        std::ranges::sort(times);
+        double total = 0;
+        for (const auto time : times) {
+            total += time;
+        }
+        printf("%s%.1f ms avg, %.1f ms p50, %.1f ms max (%zu %s)\n",
+            label,
+            total / static_cast<double>(times.size()) * 1000,
+            times[times.size() / 2] * 1000,
+            times.back() * 1000,
+            times.size(),
+            unit
+        );
+    }
+
+    class Future {
+        std::promise<void> done;
+        int errorCode = 0;
+        char* errorMessage = nullptr;
+
+    public:
+        ntg_async_struct get() {
+            return {this, &errorCode, &errorMessage, [](void* userData) {
+                static_cast<Future*>(userData)->done.set_value();
+            }};
+        }
+
+        int wait(const int result) {
+            if (result != 0) {
+                return result;
+            }
+            done.get_future().wait();
+            if (errorMessage) {
+                fprintf(stderr, "ntgcalls: %s\n", errorMessage);
+                delete[] errorMessage;
+                errorMessage = nullptr;
+            }
+            return errorCode;
+        }
+    };
+
+    struct Sample {
+        std::chrono::steady_clock::time_point time;
+        uint64_t cpuTime = 0;
+        uint64_t residentBytes = 0;
+        uint64_t ticks = 0, lateTicks = 0;
+        // Transport bytes include SRTP and ICE overhead, media bytes are the RTP stream counters
+        uint64_t bytesSent = 0, bytesReceived = 0;
+        uint64_t mediaSent = 0, mediaReceived = 0;
+    };
+
+    void usage(const char* name) {
+        fprintf(stderr,
+            "usage: %s --audio <file> [--video <file>] [options]\n"
+            "  --calls <n>        concurrent calls (default 10)\n"
+            "  --duration <s>     seconds to measure once every call is up (default 30)\n"
+            "  --ramp <ms>        delay between call creations (default 50)\n"
+            "  --loopback         hand sent packets back to the call and decode them\n"
+            "  --sfu              join every call to the local SFU, which forwards media between them (audio is decoded)\n"
+            "                     --sfu --calls 50 --ramp 0 gives the time to first frame of a 50 participant join\n"
+            "  --cert-pool <n>    DTLS certificates kept ready, 0 generates one per join (default library setting)\n"
+            "                     compare the join time of --sfu runs with and without --cert-pool 0\n"
+            "  --width <px> --height <px> --fps <n>   raw video geometry (default 1280x720@30)\n"
+            "Audio is raw s16le 48kHz stereo, video is raw I420, both read with the file source.\n",
+            name
+        );
+    }
+
+    bool parseOptions(const int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            const auto next = [&]() -> const char* {
+                return i + 1 < argc ? argv[++i] : nullptr;
+            };
+            const char* value = nullptr;
+            if (arg == "--loopback") {
+                options.loopback = true;
+                continue;
+            }
+            if (arg == "--sfu") {
+                options.sfu = true;
+                continue;
+            }
+            if (value = next(); !value) {
+                return false;
+            }
+            if (arg == "--calls") {
+                options.calls = std::max(1, atoi(value));
+            } else if (arg == "--duration") {
+                options.duration = std::max(1, atoi(value));
+            } else if (arg == "--ramp") {
+                options.rampMs = std::max(0, atoi(value));
+            } else if (arg == "--cert-pool") {
+                options.certPool = std::max(0, atoi(value));
+            } else if (arg == "--audio") {
+                options.audio = value;
+            } else if (arg == "--video") {
+                options.video = value;
+            } else if (arg == "--width") {
+                options.width = static_cast<int16_t>(atoi(value));
+            } else if (arg == "--height") {
+                options.height = static_cast<int16_t>(atoi(value));
+            } else if (arg == "--fps") {
+                options.fps = static_cast<uint8_t>(atoi(value));
+            } else {
+                return false;
+            }
+        }
+        return !options.audio.empty() || !options.video.empty();
+    }
+
+    Sample sample(const uintptr_t ptr, const int calls) {
+        Sample result;
+        result.time = std::chrono::steady_clock::now();
+        ntg_resource_usage_struct usage{};
+        if (ntg_get_resource_usage(ptr, &usage) == 0) {
+            result.residentBytes = usage.residentBytes;
+            for (int i = 0; i < usage.sizeThreads; i++) {
+                result.cpuTime += usage.threads[i].cpuTime;
+            }
+            delete[] usage.threads;
+            delete[] usage.calls;
+        }
+        ntg_playout_stats_struct playout{};
+        if (ntg_get_playout_stats(&playout) == 0) {
+            result.ticks = playout.ticks;
+            result.lateTicks = playout.lateTicks;
+        }
+        for (int chatId = 1; chatId <= calls; chatId++) {
+            ntg_call_stats_struct stats{};
+            Future future;
+            if (future.wait(ntg_get_stats(ptr, chatId, true, &stats, future.get())) == 0) {
+                result.bytesSent += stats.transportBytesSent;
+                result.bytesReceived += stats.transportBytesReceived;
+                for (int i = 0; i < stats.sizeStreams; i++) {
+                    (stats.streams[i].outgoing ? result.mediaSent : result.mediaReceived) += stats.streams[i].bytes;
+                }
+                delete[] stats.streams;
+            }
+        }
+        return result;
+    }
+
+    // Audio ssrc of a join payload, which also identifies the participant on the local SFU
+    uint32_t payloadSsrc(const std::string& payload) {
+        const auto position = payload.find("\"ssrc\":");
+        return position == std::string::npos ? 0 : static_cast<uint32_t>(atoll(payload.c_str() + position + 7));
+    }
+
+    bool joinLocalSfu(const uintptr_t ptr, const int64_t chatId, std::vector<uint32_t>& ssrcs) {
+        char* joinPayload = nullptr;
+        Future create;
+        if (const auto result = create.wait(ntg_create(ptr, chatId, &joinPayload, create.get())); result != 0) {
+            fprintf(stderr, "call %lld: create failed (%d)\n", static_cast<long long>(chatId), result);
+            return false;
+        }
+        const std::string payload = joinPayload;
+        delete[] joinPayload;
+        char* answer = nullptr;
+        Future join;
+        if (const auto result = join.wait(ntg_join_local_sfu(ptr, const_cast<char*>(payload.c_str()), &answer, join.get())); result != 0) {
+            fprintf(stderr, "call %lld: local SFU join failed (%d)\n", static_cast<long long>(chatId), result);
+            return false;
+        }
+        ssrcs.push_back(payloadSsrc(payload));
+        Future connect;
+        const auto result = connect.wait(ntg_connect(ptr, chatId, answer, false, connect.get()));
+        delete[] answer;
+        if (result != 0) {
+            fprintf(stderr, "call %lld: connect failed (%d)\n", static_cast<long long>(chatId), result);
+            return false;
+        }
+        return true;
+    }
+
+    double megabits(const uint64_t bytes, const double seconds) {
+        return seconds > 0 ? static_cast<double>(bytes) * 8 / seconds / 1e6 : 0;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const auto ptr = ntg_init();
+    if (options.certPool >= 0) {
+        ntg_configure_certificate_pool(static_cast<uint32_t>(options.certPool), 0);
+    }
+    Counters counters;
+    ntg_on_connection_change(ptr, [](uintptr_t, const int64_t chatId, const ntg_network_info_struct info, void* userData) {
+        if (info.kind == NTG_KIND_NORMAL && info.state == NTG_STATE_CONNECTED) {
+            auto* c = static_cast<Counters*>(userData);
+            c->connected++;
+            std::lock_guard lock(c->mutex);
+            if (const auto started = c->joinStarted.find(chatId); started != c->joinStarted.end()) {
+                c->joinSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - started->second).count());
+                c->joinStarted.erase(started);
+            }
+        }
+    }, &counters);
+    ntg_on_stream_end(ptr, [](uintptr_t, int64_t, ntg_stream_type_enum, ntg_stream_device_enum, void* userData) {
+        static_cast<Counters*>(userData)->streamEnds++;
+    }, &counters);
+    ntg_on_frames(ptr, [](uintptr_t, const int64_t chatId, const ntg_stream_mode_enum mode, const ntg_stream_device_enum device, ntg_frame_struct*, const uint64_t size, void* userData) {
+        auto* c = static_cast<Counters*>(userData);
+        (device == NTG_STREAM_MICROPHONE ? c->audioFrames : c->videoFrames) += size;
+        if (mode != NTG_STREAM_PLAYBACK || c->awaitingFirstFrame == 0) {
+            return;
+        }
+        std::lock_guard lock(c->mutex);
+        if (const auto started = c->firstFrameStarted.find(chatId); started != c->firstFrameStarted.end()) {
+            c->firstFrameSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - started->second).count());
+            c->firstFrameStarted.erase(started);
+            c->awaitingFirstFrame--;
+        }
+    }, &counters);
+
+    ntg_audio_description_struct audio{NTG_FILE, options.audio.data(), 48000, 2, false};
+    ntg_video_description_struct video{NTG_FILE, options.video.data(), options.width, options.height, options.fps, false, NTG_PIXEL_FORMAT_I420, 0};
+    ntg_media_description_struct capture{};
+    capture.microphone = options.audio.empty() ? nullptr : &audio;
+    capture.camera = options.video.empty() ? nullptr : &video;
+
+    // Decoded loopback or forwarded media is handed to the frames callback, which only counts it
+    char externalInput[] = "";
+    ntg_audio_description_struct audioOut{NTG_EXTERNAL, externalInput, 48000, 2, false};
+    ntg_video_description_struct videoOut{NTG_EXTERNAL, externalInput, options.width, options.height, options.fps, false, NTG_PIXEL_FORMAT_I420, 0};
+    ntg_media_description_struct playback{};
+    playback.microphone = capture.microphone ? &audioOut : nullptr;
+    playback.camera = capture.camera ? &videoOut : nullptr;
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    const auto baseline = sample(ptr, 0);
+    const bool receives = options.loopback || options.sfu;
+    int created = 0;
+    std::vector<uint32_t> sfuSsrcs;
+    for (int chatId = 1; chatId <= options.calls; chatId++) {
+        if (receives) {
+            std::lock_guard lock(counters.mutex);
+            counters.firstFrameStarted[chatId] = std::chrono::steady_clock::now();
+            counters.awaitingFirstFrame++;
+        }
+        if (options.sfu) {
+            {
+                std::lock_guard lock(counters.mutex);
+                counters.joinStarted[chatId] = std::chrono::steady_clock::now();
+            }
+            if (!joinLocalSfu(ptr, chatId, sfuSsrcs)) {
+                break;
+            }
+        } else {
+            Future create;
+            if (const auto result = create.wait(ntg_create_null(ptr, chatId, options.loopback, create.get())); result != 0) {
+                fprintf(stderr, "call %d: create failed (%d)\n", chatId, result);
+                break;
+            }
+        }
+        created++;
+        if (receives) {
+            Future future;
+            if (const auto result = future.wait(ntg_set_stream_sources(ptr, chatId, NTG_STREAM_PLAYBACK, playback, future.get())); result != 0) {
+                fprintf(stderr, "call %d: playback setup failed (%d)\n", chatId, result);
+            }
+        }
+        Future future;
+        if (const auto result = future.wait(ntg_set_stream_sources(ptr, chatId, NTG_STREAM_CAPTURE, capture, future.get())); result != 0) {
+            fprintf(stderr, "call %d: capture setup failed (%d)\n", chatId, result);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.rampMs));
+    }
+    const auto rampSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count();
+    const auto rampResident = sample(ptr, 0).residentBytes;
+    const auto perCallResident = created && rampResident > baseline.residentBytes ? (rampResident - baseline.residentBytes) / created : 0;
+    printf("%d/%d calls up in %.2fs, %llu connected, %.1f KiB resident per call\n",
+        created,
+        options.calls,
+        rampSeconds,
+        static_cast<unsigned long long>(counters.connected.load()),
+        static_cast<double>(perCallResident) / 1024
+    );
+
+    const auto first = sample(ptr, created);
+    auto previous = first;
+    uint64_t peakResident = first.residentBytes;
+    for (int second = 1; second <= options.duration; second++) {
+        std::this_thread::sleep_until(first.time + std::chrono::seconds(second));
+        const auto current = sample(ptr, created);
+        const auto elapsed = std::chrono::duration<double>(current.time - previous.time).count();
+        peakResident = std::max(peakResident, current.residentBytes);
+        printf("t=%3ds cpu=%6.1f%% rss=%8.1fMiB late=%llu/%llu tx=%8.2fMbps rx=%8.2fMbps media tx=%8.2fMbps rx=%8.2fMbps\n",
+            second,
+            static_cast<double>(current.cpuTime - previous.cpuTime) / 1e4 / elapsed,
+            static_cast<double>(current.residentBytes) / (1024 * 1024),
+            static_cast<unsigned long long>(current.lateTicks - previous.lateTicks),
+            static_cast<unsigned long long>(current.ticks - previous.ticks),
+            megabits(current.bytesSent - previous.bytesSent, elapsed),
+            megabits(current.bytesReceived - previous.bytesReceived, elapsed),
+            megabits(current.mediaSent - previous.mediaSent, elapsed),
+            megabits(current.mediaReceived - previous.mediaReceived, elapsed)
+        );
+        fflush(stdout);
+        previous = current;
+    }
+
+    int64_t audioSendP99 = 0, videoSendP99 = 0;
+    for (int chatId = 1; chatId <= created; chatId++) {
+        ntg_call_latency_struct latency{};
+        Future future;
+        if (future.wait(ntg_get_latency(ptr, chatId, &latency, future.get())) == 0) {
+            audioSendP99 = std::max(audioSendP99, latency.audioSend.p99);
+            videoSendP99 = std::max(videoSendP99, latency.videoSend.p99);
+        }
+    }
+
+    const auto seconds = std::chrono::duration<double>(previous.time - first.time).count();
+    const auto cpu = static_cast<double>(previous.cpuTime - first.cpuTime) / 1e4 / seconds;
+    printf("\ncalls           %d\n", created);
+    printf("cpu             %.1f%% (%.2f%% per call)\n", cpu, created ? cpu / created : 0);
+    printf("peak rss        %.1f MiB\n", static_cast<double>(peakResident) / (1024 * 1024));
+    printf("late ticks      %llu of %llu\n",
+        static_cast<unsigned long long>(previous.lateTicks - first.lateTicks),
+        static_cast<unsigned long long>(previous.ticks - first.ticks)
+    );
+    printf("sent            %.2f Mbps (%.3f per call)\n",
+        megabits(previous.bytesSent - first.bytesSent, seconds),
+        created ? megabits(previous.bytesSent - first.bytesSent, seconds) / created : 0
+    );
+    printf("media sent      %.2f Mbps\n", megabits(previous.mediaSent - first.mediaSent, seconds));
+    if (receives) {
+        printf("received        %.2f Mbps\n", megabits(previous.bytesReceived - first.bytesReceived, seconds));
+        printf("media received  %.2f Mbps\n", megabits(previous.mediaReceived - first.mediaReceived, seconds));
+        printf("decoded frames  %llu audio, %llu video\n",
+            static_cast<unsigned long long>(counters.audioFrames.load()),
+            static_cast<unsigned long long>(counters.videoFrames.load())
+        );
+    }
+    printf("send p99        %.2f ms audio, %.2f ms video\n",
+        static_cast<double>(audioSendP99) / 1000,
+        static_cast<double>(videoSendP99) / 1000
+    );
+    {
+        std::lock_guard lock(counters.mutex);
+        printTimes("join time       ", counters.joinSeconds, options.certPool == 0 ? "joined, unpooled certificates" : "joined");
+        printTimes("first frame     ", counters.firstFrameSeconds, "received");
+        if (receives && !counters.firstFrameStarted.empty()) {
+            printf("                %zu calls never received a frame\n", counters.firstFrameStarted.size());
+        }
+    }
+    if (ntg_socket_batch_stats_struct batch{}; ntg_get_socket_batch_stats(&batch) == 0 && batch.readWakeups) {
+        printf("socket batches  %.1f packets per read wakeup, %.1f per send flush, %llu gso sends\n",
+            static_cast<double>(batch.packetsReceived) / static_cast<double>(batch.readWakeups),
+            batch.sendFlushes ? static_cast<double>(batch.packetsSent) / static_cast<double>(batch.sendFlushes) : 0,
+            static_cast<unsigned long long>(batch.gsoSends)
+        );
+    }
+    if (counters.streamEnds) {
+        printf("stream ends     %llu, use longer inputs to keep every call busy\n", static_cast<unsigned long long>(counters.streamEnds.load()));
+    }
+
+    Future stop;
+    stop.wait(ntg_stop_all(ptr, 5000, stop.get()));
+    for (const auto ssrc : sfuSsrcs) {
+        Future leave;
+        leave.wait(ntg_leave_local_sfu(ptr, ssrc, leave.get()));
+    }
+    ntg_destroy(ptr);
+    return 0;
+}
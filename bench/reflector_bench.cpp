@@ -0,0 +1,174 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <api/environment/environment_factory.h>
+#include <p2p/base/basic_packet_socket_factory.h>
+#include <p2p/client/relay_port_factory_interface.h>
+#include <rtc_base/async_packet_socket.h>
+#include <rtc_base/byte_order.h>
+#include <rtc_base/logging.h>
+#include <rtc_base/network.h>
+#include <rtc_base/physical_socket_server.h>
+#include <rtc_base/thread.h>
+#include <wrtc/interfaces/reflector_port.hpp>
+
+namespace {
+    constexpr uint8_t kServerId = 1;
+    constexpr uint16_t kServerPort = 599;
+    // 16 byte peer tag as the signaling hands it over, the last 4 bytes are replaced by the port
+    constexpr char kPeerTag[] = "00112233445566778899aabbccddeeff";
+
+    // Swallows every write, the port only ever sends to the reflector address
+    class NullSocket final : public webrtc::AsyncPacketSocket {
+    public:
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+
+        webrtc::SocketAddress GetLocalAddress() const override {
+            return {"127.0.0.1", 50000};
+        }
+
+        webrtc::SocketAddress GetRemoteAddress() const override {
+            return {};
+        }
+
+        int Send(const void*, const size_t size, const webrtc::AsyncSocketPacketOptions&) override {
+            packets++;
+            bytes += size;
+            return static_cast<int>(size);
+        }
+
+        int SendTo(const void* data, const size_t size, const webrtc::SocketAddress&, const webrtc::AsyncSocketPacketOptions& options) override {
+            return Send(data, size, options);
+        }
+
+        int Close() override {
+            return 0;
+        }
+
+        State GetState() const override {
+            return STATE_BOUND;
+        }
+
+        int GetOption(webrtc::Socket::Option, int*) override {
+            return -1;
+        }
+
+        int SetOption(webrtc::Socket::Option, int) override {
+            return 0;
+        }
+
+        int GetError() const override {
+            return 0;
+        }
+
+        void SetError(int) override {}
+    };
+
+    std::string peerHostname(const uint32_t tag) {
+        return "reflector-" + std::to_string(kServerId) + "-" + std::to_string(tag) + ".reflector";
+    }
+
+    double rate(const uint64_t packets, const std::chrono::steady_clock::duration elapsed) {
+        const auto seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0 ? static_cast<double>(packets) / seconds : 0;
+    }
+}
+
+// Packets per second through the reflector data path, without a server or a real socket
+int main(const int argc, char** argv) {
+    const uint64_t packets = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+    const uint32_t peers = argc > 2 ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 8;
+    if (!packets || !peers) {
+        fprintf(stderr, "usage: %s [packets] [peers]\n", argv[0]);
+        return 1;
+    }
+    webrtc::LogMessage::LogToDebug(webrtc::LS_NONE);
+
+    webrtc::PhysicalSocketServer socketServer;
+    webrtc::AutoSocketServerThread thread(&socketServer);
+    webrtc::BasicPacketSocketFactory socketFactory(&socketServer);
+    const auto env = webrtc::CreateEnvironment();
+    const webrtc::IPAddress loopback(INADDR_LOOPBACK);
+    webrtc::Network network("lo", "loopback", loopback, 8);
+    network.AddIP(loopback);
+
+    const webrtc::ProtocolAddress serverAddress(webrtc::SocketAddress(loopback, kServerPort), webrtc::PROTO_UDP);
+    webrtc::RelayServerConfig config;
+    config.credentials = webrtc::RelayCredentials("reflector", kPeerTag);
+    webrtc::CreateRelayPortArgs args{env};
+    args.network_thread = &thread;
+    args.socket_factory = &socketFactory;
+    args.network = &network;
+    args.server_address = &serverAddress;
+    args.config = &config;
+    args.username = "benchufrag";
+    args.password = "benchpasswordbenchpassword";
+
+    auto* socket = new NullSocket();
+    const auto port = wrtc::ReflectorPort::Create(args, socket, kServerId, 0, false, 0);
+    if (!port) {
+        fprintf(stderr, "could not create the reflector port\n");
+        return 1;
+    }
+
+    std::vector<webrtc::SocketAddress> destinations;
+    for (uint32_t tag = 1; tag <= peers; tag++) {
+        webrtc::SocketAddress destination(peerHostname(tag), kServerPort);
+        destination.SetResolvedIP(loopback);
+        webrtc::Candidate candidate;
+        candidate.set_component(1);
+        candidate.set_protocol(webrtc::UDP_PROTOCOL_NAME);
+        candidate.set_address(destination);
+        // Received packets reach a connection instead of the unknown address path
+        port->CreateConnection(candidate, webrtc::PortInterface::ORIGIN_MESSAGE);
+        destinations.push_back(std::move(destination));
+    }
+
+    printf("%llu packets across %u peers\n", static_cast<unsigned long long>(packets), peers);
+    for (const size_t payloadSize : {200, 1200}) {
+        const std::vector<uint8_t> payload(payloadSize, 0x5a);
+        const webrtc::AsyncSocketPacketOptions options;
+        const auto sendStarted = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < packets; i++) {
+            port->SendTo(payload.data(), payload.size(), destinations[i % peers], options, true);
+        }
+        const auto sendElapsed = std::chrono::steady_clock::now() - sendStarted;
+
+        // Data packets as the reflector relays them: peer tag, sender tag, size and payload
+        std::vector<std::vector<uint8_t>> incoming;
+        for (uint32_t tag = 1; tag <= peers; tag++) {
+            std::vector<uint8_t> packet(16 + 4 + 4 + payloadSize, 0x5a);
+            for (size_t i = 0; i < 16; i++) {
+                packet[i] = static_cast<uint8_t>(strtoul(std::string(kPeerTag + i * 2, 2).c_str(), nullptr, 16));
+            }
+            memcpy(packet.data() + 16, &tag, 4);
+            webrtc::SetBE32(packet.data() + 16 + 4, static_cast<uint32_t>(payloadSize));
+            incoming.push_back(std::move(packet));
+        }
+        const auto receiveStarted = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < packets; i++) {
+            const auto& packet = incoming[i % peers];
+            port->HandleIncomingPacket(socket, webrtc::ReceivedIpPacket::CreateFromLegacy(packet.data(), packet.size(), -1, serverAddress.address));
+        }
+        const auto receiveElapsed = std::chrono::steady_clock::now() - receiveStarted;
+
+        printf("%4zu bytes  send %10.0f pps  receive %10.0f pps\n",
+            payloadSize,
+            rate(packets, sendElapsed),
+            rate(packets, receiveElapsed)
+        );
+    }
+    printf("socket writes   %llu packets, %llu bytes\n",
+        static_cast<unsigned long long>(socket->packets),
+        static_cast<unsigned long long>(socket->bytes)
+    );
+    return 0;
+}
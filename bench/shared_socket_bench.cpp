@@ -0,0 +1,157 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(IS_LINUX)
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <api/environment/environment_factory.h>
+#include <p2p/base/basic_packet_socket_factory.h>
+#include <rtc_base/logging.h>
+#include <rtc_base/physical_socket_server.h>
+#include <rtc_base/task_utils/repeating_task.h>
+#include <rtc_base/thread.h>
+#include <wrtc/interfaces/batched_udp_socket.hpp>
+#include <wrtc/interfaces/shared_udp_socket.hpp>
+
+namespace {
+    struct Options {
+        uint32_t calls = 200;
+        uint32_t socketsPerAddress = 4;
+        int duration = 5;
+        int intervalMs = 20;
+    };
+
+    struct Result {
+        double wakeupsPerSecond = 0;
+        double packetsPerWakeup = 0;
+        uint32_t sockets = 0;
+        uint32_t overflowSockets = 0;
+        uint64_t received = 0;
+        uint64_t misrouted = 0;
+    };
+
+    // Every call sends one packet per interval to its remote, which echoes it back
+    Result run(webrtc::Thread* thread, webrtc::PhysicalSocketServer* server, const Options& options, const uint32_t remotes, const bool shared) {
+        const auto env = webrtc::CreateEnvironment();
+        webrtc::BasicPacketSocketFactory echoFactory(server);
+        const webrtc::SocketAddress loopback("127.0.0.1", 0);
+        std::unique_ptr<wrtc::SharedUdpSocketPool> pool;
+        std::vector<std::unique_ptr<webrtc::AsyncPacketSocket>> echoes, calls;
+        webrtc::RepeatingTaskHandle sender;
+        Result result;
+
+        thread->BlockingCall([&] {
+            for (uint32_t i = 0; i < remotes; i++) {
+                auto echo = echoFactory.CreateUdpSocket(env, loopback, 0, 0);
+                echo->RegisterReceivedPacketCallback([](webrtc::AsyncPacketSocket* socket, const webrtc::ReceivedIpPacket& packet) {
+                    socket->SendTo(packet.payload().data(), packet.payload().size(), packet.source_address(), webrtc::AsyncSocketPacketOptions());
+                });
+                echoes.push_back(std::move(echo));
+            }
+            if (shared) {
+                pool = std::make_unique<wrtc::SharedUdpSocketPool>(server, options.socketsPerAddress);
+            }
+            for (uint32_t i = 0; i < options.calls; i++) {
+                std::unique_ptr<webrtc::AsyncPacketSocket> socket;
+                if (shared) {
+                    socket = pool->CreateSocket(loopback);
+                } else {
+                    socket = wrtc::BatchedUdpSocket::Create(server, loopback, 0, 0);
+                }
+                socket->RegisterReceivedPacketCallback([&result, i](webrtc::AsyncPacketSocket*, const webrtc::ReceivedIpPacket& packet) {
+                    uint32_t owner = 0;
+                    memcpy(&owner, packet.payload().data(), sizeof(owner));
+                    result.received++;
+                    if (owner != i) {
+                        result.misrouted++;
+                    }
+                });
+                calls.push_back(std::move(socket));
+            }
+            sender = webrtc::RepeatingTaskHandle::Start(thread, [&] {
+                std::vector<uint8_t> payload(160, 0x5a);
+                for (uint32_t i = 0; i < options.calls; i++) {
+                    memcpy(payload.data(), &i, sizeof(i));
+                    calls[i]->SendTo(payload.data(), payload.size(), echoes[i % remotes]->GetLocalAddress(), webrtc::AsyncSocketPacketOptions());
+                }
+                return webrtc::TimeDelta::Millis(options.intervalMs);
+            });
+        });
+
+        const auto before = wrtc::BatchedUdpSocket::GetStats();
+        const auto started = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::seconds(options.duration));
+        const auto after = wrtc::BatchedUdpSocket::GetStats();
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        const auto poolStats = wrtc::SharedUdpSocketPool::GetStats();
+
+        thread->BlockingCall([&] {
+            sender.Stop();
+            calls.clear();
+            echoes.clear();
+            pool = nullptr;
+        });
+        const auto wakeups = after.readWakeups - before.readWakeups;
+        result.wakeupsPerSecond = static_cast<double>(wakeups) / seconds;
+        result.packetsPerWakeup = wakeups ? static_cast<double>(after.packetsReceived - before.packetsReceived) / static_cast<double>(wakeups) : 0;
+        result.sockets = shared ? poolStats.sockets : options.calls;
+        result.overflowSockets = shared ? poolStats.overflowSockets : 0;
+        return result;
+    }
+
+    void print(const char* name, const Result& result) {
+        printf("%-24s %5u sockets  %5.1f%% overflow  %9.0f wakeups/s  %5.2f packets/wakeup  %llu misrouted of %llu\n",
+            name,
+            result.sockets,
+            result.sockets ? static_cast<double>(result.overflowSockets) * 100 / result.sockets : 0,
+            result.wakeupsPerSecond,
+            result.packetsPerWakeup,
+            static_cast<unsigned long long>(result.misrouted),
+            static_cast<unsigned long long>(result.received)
+        );
+    }
+}
+
+// Read wakeups and socket count of N calls on per-call sockets and on the shared pool
+int main(const int argc, char** argv) {
+    Options options;
+    options.calls = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : options.calls;
+    options.socketsPerAddress = argc > 2 ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : options.socketsPerAddress;
+    options.duration = argc > 3 ? atoi(argv[3]) : options.duration;
+    if (!options.calls || !options.socketsPerAddress || options.duration <= 0) {
+        fprintf(stderr, "usage: %s [calls] [shared sockets per address] [seconds]\n", argv[0]);
+        return 1;
+    }
+    webrtc::LogMessage::LogToDebug(webrtc::LS_NONE);
+
+    webrtc::PhysicalSocketServer socketServer;
+    const auto thread = std::make_unique<webrtc::Thread>(&socketServer);
+    thread->Start();
+
+    printf("%u calls, one packet every %dms each, %u shared sockets per address, %ds per run\n",
+        options.calls,
+        options.intervalMs,
+        options.socketsPerAddress,
+        options.duration
+    );
+    print("per-call sockets", run(thread.get(), &socketServer, options, options.calls, false));
+    print("shared, one remote each", run(thread.get(), &socketServer, options, options.calls, true));
+    print("shared, 8 SFUs", run(thread.get(), &socketServer, options, 8, true));
+    print("shared, one SFU", run(thread.get(), &socketServer, options, 1, true));
+    thread->Stop();
+    return 0;
+}
+#else
+int main() {
+    fprintf(stderr, "shared UDP sockets are only built on Linux\n");
+    return 1;
+}
+#endif
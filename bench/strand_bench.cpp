@@ -0,0 +1,213 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ntgcalls.h>
+
+namespace {
+    struct Options {
+        int calls = 500;
+        int threads = 16;
+        int duration = 10;
+        bool hot = false;
+    };
+
+    // Waits for one async API call, errors are only counted so a busy run does not flood stderr
+    class Future {
+        std::promise<void> done;
+        int errorCode = 0;
+        char* errorMessage = nullptr;
+
+    public:
+        ntg_async_struct get() {
+            return {this, &errorCode, &errorMessage, [](void* userData) {
+                static_cast<Future*>(userData)->done.set_value();
+            }};
+        }
+
+        int wait(const int result) {
+            if (result != 0) {
+                return result;
+            }
+            done.get_future().wait();
+            delete[] errorMessage;
+            errorMessage = nullptr;
+            return errorCode;
+        }
+    };
+
+    void usage(const char* name) {
+        fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --calls <n>        null calls created up front (default 500)\n"
+            "  --threads <n>      client threads issuing operations back to back (default 16)\n"
+            "  --duration <s>     seconds of operations (default 10)\n"
+            "  --hot              one more thread keeps chat 1 busy with uncached stats, the others skip it\n"
+            "Each operation targets a random call, latency is measured from the call until its future resolves.\n",
+            name
+        );
+    }
+
+    bool parseOptions(const int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (arg == "--hot") {
+                options.hot = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            const int value = atoi(argv[++i]);
+            if (arg == "--calls") {
+                options.calls = std::max(2, value);
+            } else if (arg == "--threads") {
+                options.threads = std::max(1, value);
+            } else if (arg == "--duration") {
+                options.duration = std::max(1, value);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int runOperation(const uintptr_t ptr, const int64_t chatId, const int kind) {
+        Future future;
+        switch (kind) {
+            case 0:
+                return future.wait(ntg_mute(ptr, chatId, future.get()));
+            case 1:
+                return future.wait(ntg_unmute(ptr, chatId, future.get()));
+            case 2:
+                return future.wait(ntg_pause(ptr, chatId, future.get()));
+            case 3:
+                return future.wait(ntg_resume(ptr, chatId, future.get()));
+            case 4: {
+                ntg_call_latency_struct latency{};
+                return future.wait(ntg_get_latency(ptr, chatId, &latency, future.get()));
+            }
+            default: {
+                ntg_call_stats_struct stats{};
+                return future.wait(ntg_get_stats(ptr, chatId, true, &stats, future.get()));
+            }
+        }
+    }
+
+    void printLatency(const char* label, std::vector<double>& times) {
+        if (times.empty()) {
+            return;
+        }
+        std::ranges::sort(times);
+        double total = 0;
+        for (const auto time : times) {
+            total += time;
+        }
+        printf("%s%.3f ms avg, %.3f ms p50, %.3f ms p99, %.3f ms max (%zu ops)\n",
+            label,
+            total / static_cast<double>(times.size()) * 1000,
+            times[times.size() / 2] * 1000,
+            times[times.size() * 99 / 100] * 1000,
+            times.back() * 1000,
+            times.size()
+        );
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const auto ptr = ntg_init();
+
+    // Every creation is issued before any is awaited, unrelated chats are set up in parallel
+    const auto createStarted = std::chrono::steady_clock::now();
+    std::vector<Future> creates(options.calls);
+    std::vector<int> results(options.calls);
+    for (int i = 0; i < options.calls; i++) {
+        results[i] = ntg_create_null(ptr, i + 1, false, creates[i].get());
+    }
+    int created = 0;
+    for (int i = 0; i < options.calls; i++) {
+        if (creates[i].wait(results[i]) == 0) {
+            created++;
+        }
+    }
+    printf("%d/%d null calls created in %.2fs\n",
+        created,
+        options.calls,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - createStarted).count()
+    );
+
+    std::atomic_bool running = true;
+    std::atomic_uint64_t failures = 0;
+    std::vector<std::vector<double>> latencies(options.threads);
+    std::vector<std::thread> clients;
+    for (int t = 0; t < options.threads; t++) {
+        clients.emplace_back([&, t] {
+            std::mt19937 random(t + 1);
+            std::uniform_int_distribution<int64_t> chats(options.hot ? 2 : 1, options.calls);
+            std::uniform_int_distribution kinds(0, 5);
+            while (running) {
+                const auto started = std::chrono::steady_clock::now();
+                if (runOperation(ptr, chats(random), kinds(random)) != 0) {
+                    failures++;
+                }
+                latencies[t].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+            }
+        });
+    }
+    std::vector<double> hotLatencies;
+    std::thread hot;
+    if (options.hot) {
+        hot = std::thread([&] {
+            while (running) {
+                const auto started = std::chrono::steady_clock::now();
+                Future future;
+                ntg_call_stats_struct stats{};
+                if (future.wait(ntg_get_stats(ptr, 1, false, &stats, future.get())) != 0) {
+                    failures++;
+                }
+                hotLatencies.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(options.duration));
+    running = false;
+    for (auto& client : clients) {
+        client.join();
+    }
+    if (hot.joinable()) {
+        hot.join();
+    }
+
+    std::vector<double> all;
+    for (auto& times : latencies) {
+        all.insert(all.end(), times.begin(), times.end());
+    }
+    printf("%.0f ops/s across %d threads, %llu failed\n",
+        static_cast<double>(all.size()) / options.duration,
+        options.threads,
+        static_cast<unsigned long long>(failures.load())
+    );
+    printLatency("per-chat ops    ", all);
+    printLatency("hot chat stats  ", hotLatencies);
+
+    Future stop;
+    stop.wait(ntg_stop_all(ptr, 5000, stop.get()));
+    ntg_destroy(ptr);
+    return 0;
+}
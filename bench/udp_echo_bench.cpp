@@ -0,0 +1,149 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(IS_LINUX)
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <api/environment/environment_factory.h>
+#include <p2p/base/basic_packet_socket_factory.h>
+#include <rtc_base/logging.h>
+#include <rtc_base/physical_socket_server.h>
+#include <rtc_base/thread.h>
+#include <wrtc/interfaces/batched_udp_socket.hpp>
+
+namespace {
+    struct Result {
+        uint64_t roundTrips;
+        double seconds;
+        double cpuSeconds;
+    };
+
+    double cpuSeconds() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+    // Echo server and client on loopback, the client keeps a fixed window of packets in flight
+    Result run(webrtc::Thread* thread, const std::function<std::unique_ptr<webrtc::AsyncPacketSocket>()>& create, const size_t payloadSize, const int window, const int duration) {
+        std::unique_ptr<webrtc::AsyncPacketSocket> server, client;
+        std::atomic_uint64_t roundTrips = 0;
+        std::atomic_bool stopped = false;
+        const std::vector<uint8_t> payload(payloadSize, 0x5a);
+        const webrtc::AsyncSocketPacketOptions options;
+
+        thread->BlockingCall([&] {
+            server = create();
+            client = create();
+            if (!server || !client) {
+                return;
+            }
+            server->RegisterReceivedPacketCallback([&](webrtc::AsyncPacketSocket* socket, const webrtc::ReceivedIpPacket& packet) {
+                socket->SendTo(packet.payload().data(), packet.payload().size(), packet.source_address(), options);
+            });
+            client->RegisterReceivedPacketCallback([&](webrtc::AsyncPacketSocket* socket, const webrtc::ReceivedIpPacket&) {
+                roundTrips++;
+                if (!stopped) {
+                    socket->SendTo(payload.data(), payload.size(), server->GetLocalAddress(), options);
+                }
+            });
+        });
+        if (!server || !client) {
+            fprintf(stderr, "could not create the echo sockets\n");
+            return {};
+        }
+
+        const auto cpuBefore = cpuSeconds();
+        const auto started = std::chrono::steady_clock::now();
+        thread->BlockingCall([&] {
+            for (int i = 0; i < window; i++) {
+                client->SendTo(payload.data(), payload.size(), server->GetLocalAddress(), options);
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::seconds(duration));
+        const auto completed = roundTrips.load();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        const auto cpuAfter = cpuSeconds();
+        thread->BlockingCall([&] {
+            stopped = true;
+            client = nullptr;
+            server = nullptr;
+        });
+        return {completed, elapsed, cpuAfter - cpuBefore};
+    }
+
+    void print(const char* name, const Result& result) {
+        const auto rate = result.seconds > 0 ? static_cast<double>(result.roundTrips) / result.seconds : 0;
+        const auto cpuPerPacket = result.roundTrips ? result.cpuSeconds / static_cast<double>(result.roundTrips * 2) * 1e9 : 0;
+        printf("%-10s %10.0f round trips/s  %7.0f ns cpu per packet\n", name, rate, cpuPerPacket);
+    }
+}
+
+// Loopback UDP echo through the per-packet sockets of webrtc and through the batched sockets
+int main(const int argc, char** argv) {
+    const int duration = argc > 1 ? atoi(argv[1]) : 5;
+    const int window = argc > 2 ? atoi(argv[2]) : 64;
+    const size_t payloadSize = argc > 3 ? strtoul(argv[3], nullptr, 10) : 1200;
+    if (duration <= 0 || window <= 0 || payloadSize == 0 || payloadSize > 1400) {
+        fprintf(stderr, "usage: %s [seconds] [window] [payload bytes up to 1400]\n", argv[0]);
+        return 1;
+    }
+    webrtc::LogMessage::LogToDebug(webrtc::LS_NONE);
+
+    webrtc::PhysicalSocketServer socketServer;
+    const auto thread = std::make_unique<webrtc::Thread>(&socketServer);
+    thread->Start();
+    const auto env = webrtc::CreateEnvironment();
+    webrtc::BasicPacketSocketFactory socketFactory(&socketServer);
+    const webrtc::SocketAddress loopback("127.0.0.1", 0);
+
+    printf("%d packets in flight, %zu byte payloads, %ds per run\n", window, payloadSize, duration);
+    const auto perPacket = run(thread.get(), [&] {
+        return socketFactory.CreateUdpSocket(env, loopback, 0, 0);
+    }, payloadSize, window, duration);
+    print("per-packet", perPacket);
+
+    const auto before = wrtc::BatchedUdpSocket::GetStats();
+    const auto batched = run(thread.get(), [&]() -> std::unique_ptr<webrtc::AsyncPacketSocket> {
+        return wrtc::BatchedUdpSocket::Create(&socketServer, loopback, 0, 0);
+    }, payloadSize, window, duration);
+    print("batched", batched);
+
+    // Same counters as NTgCalls::getSocketBatchStats, limited to the batched run
+    const auto after = wrtc::BatchedUdpSocket::GetStats();
+    const auto readWakeups = after.readWakeups - before.readWakeups;
+    const auto packetsReceived = after.packetsReceived - before.packetsReceived;
+    const auto sendFlushes = after.sendFlushes - before.sendFlushes;
+    const auto packetsSent = after.packetsSent - before.packetsSent;
+    printf("\nread wakeups    %llu (%.1f packets each, max %u)\n",
+        static_cast<unsigned long long>(readWakeups),
+        readWakeups ? static_cast<double>(packetsReceived) / static_cast<double>(readWakeups) : 0,
+        after.maxReadBatch
+    );
+    printf("send flushes    %llu (%.1f packets each, max %u)\n",
+        static_cast<unsigned long long>(sendFlushes),
+        sendFlushes ? static_cast<double>(packetsSent) / static_cast<double>(sendFlushes) : 0,
+        after.maxSendBatch
+    );
+    printf("gso sends       %llu\n", static_cast<unsigned long long>(after.gsoSends - before.gsoSends));
+    if (perPacket.roundTrips) {
+        printf("speedup         %.2fx\n", static_cast<double>(batched.roundTrips) / batched.seconds / (static_cast<double>(perPacket.roundTrips) / perPacket.seconds));
+    }
+    thread->Stop();
+    return 0;
+}
+#else
+int main() {
+    fprintf(stderr, "batched UDP sockets are only built on Linux\n");
+    return 1;
+}
+#endif
@@ -2,4 +2,5 @@ package ntgcalls
 
 type CallInfo struct {
 	Playback, Capture StreamStatus
+	SuppressedFrames  uint64
 }
@@ -0,0 +1,13 @@
+package ntgcalls
+
+// LatencySummary values are in microseconds
+type LatencySummary struct {
+	Count               uint64
+	Min, Mean, Max      int64
+	P50, P90, P99, P999 int64
+}
+
+type CallLatency struct {
+	AudioSend, VideoSend       LatencySummary
+	AudioReceive, VideoReceive LatencySummary
+}
@@ -0,0 +1,10 @@
+package ntgcalls
+
+type CallSnapshot struct {
+	State                     MediaState
+	Playback, Capture         StreamStatus
+	PlaybackTime, CaptureTime uint64
+	SuppressedFrames          uint64
+	HasConnection             bool
+	ConnectionMode            ConnectionMode
+}
@@ -0,0 +1,25 @@
+package ntgcalls
+
+type RtpStreamStats struct {
+	Ssrc                uint32
+	Outgoing, Video     bool
+	Bytes, Packets      uint64
+	PacketsLost         int64
+	FractionLost        float64
+	JitterMs            float64
+	Nacks, Plis         uint64
+	Bitrate             uint64
+	FrameTimeMs         float64
+	JitterBufferDelayMs float64
+}
+
+type CallStats struct {
+	Timestamp              int64
+	RttMs                  float64
+	SendBandwidth          uint64
+	ReceiveBandwidth       uint64
+	PacerDelayMs           int64
+	TransportBytesSent     uint64
+	TransportBytesReceived uint64
+	Streams                []RtpStreamStats
+}
@@ -0,0 +1,7 @@
+package ntgcalls
+
+type ConnectionPoolStats struct {
+	Ready  uint32
+	Hits   uint64
+	Misses uint64
+}
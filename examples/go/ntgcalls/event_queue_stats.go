@@ -0,0 +1,10 @@
+package ntgcalls
+
+type EventQueueStats struct {
+	Depth     uint32
+	MaxDepth  uint32
+	Batches   uint64
+	Delivered uint64
+	Coalesced uint64
+	Dropped   uint64
+}
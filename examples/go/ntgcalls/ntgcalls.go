@@ -274,6 +274,61 @@ func (ctx *Client) GetConnectionMode(chatId int64) (ConnectionMode, error) {
 	}
 }
 
+func (ctx *Client) GetStats(chatId int64, cached bool) (CallStats, error) {
+	f := CreateFuture()
+	var buffer C.ntg_call_stats_struct
+	C.ntg_get_stats(C.uintptr_t(ctx.ptr), C.int64_t(chatId), C.bool(cached), &buffer, f.ParseToC())
+	f.wait()
+	if err := parseErrorCode(f); err != nil {
+		return CallStats{}, err
+	}
+	defer C.free(unsafe.Pointer(buffer.streams))
+	stats := CallStats{
+		Timestamp:              int64(buffer.timestamp),
+		RttMs:                  float64(buffer.rttMs),
+		SendBandwidth:          uint64(buffer.sendBandwidth),
+		ReceiveBandwidth:       uint64(buffer.receiveBandwidth),
+		PacerDelayMs:           int64(buffer.pacerDelayMs),
+		TransportBytesSent:     uint64(buffer.transportBytesSent),
+		TransportBytesReceived: uint64(buffer.transportBytesReceived),
+	}
+	for i := 0; i < int(buffer.sizeStreams); i++ {
+		raw := *(*C.ntg_rtp_stream_stats_struct)(unsafe.Pointer(uintptr(unsafe.Pointer(buffer.streams)) + uintptr(i)*unsafe.Sizeof(C.ntg_rtp_stream_stats_struct{})))
+		stats.Streams = append(stats.Streams, RtpStreamStats{
+			Ssrc:                uint32(raw.ssrc),
+			Outgoing:            bool(raw.outgoing),
+			Video:               bool(raw.video),
+			Bytes:               uint64(raw.bytes),
+			Packets:             uint64(raw.packets),
+			PacketsLost:         int64(raw.packetsLost),
+			FractionLost:        float64(raw.fractionLost),
+			JitterMs:            float64(raw.jitterMs),
+			Nacks:               uint64(raw.nacks),
+			Plis:                uint64(raw.plis),
+			Bitrate:             uint64(raw.bitrate),
+			FrameTimeMs:         float64(raw.frameTimeMs),
+			JitterBufferDelayMs: float64(raw.jitterBufferDelayMs),
+		})
+	}
+	return stats, nil
+}
+
+func (ctx *Client) GetLatency(chatId int64) (CallLatency, error) {
+	f := CreateFuture()
+	var buffer C.ntg_call_latency_struct
+	C.ntg_get_latency(C.uintptr_t(ctx.ptr), C.int64_t(chatId), &buffer, f.ParseToC())
+	f.wait()
+	if err := parseErrorCode(f); err != nil {
+		return CallLatency{}, err
+	}
+	return CallLatency{
+		AudioSend:    parseLatencySummary(buffer.audioSend),
+		VideoSend:    parseLatencySummary(buffer.videoSend),
+		AudioReceive: parseLatencySummary(buffer.audioReceive),
+		VideoReceive: parseLatencySummary(buffer.videoReceive),
+	}, nil
+}
+
 func (ctx *Client) CreateCall(chatId int64) (string, error) {
 	var buffer *C.char
 	f := CreateFuture()
@@ -283,6 +338,13 @@ func (ctx *Client) CreateCall(chatId int64) (string, error) {
 	return C.GoString(buffer), parseErrorCode(f)
 }
 
+func (ctx *Client) CreateNullCall(chatId int64, loopback bool) error {
+	f := CreateFuture()
+	C.ntg_create_null(C.uintptr_t(ctx.ptr), C.int64_t(chatId), C.bool(loopback), f.ParseToC())
+	f.wait()
+	return parseErrorCode(f)
+}
+
 func (ctx *Client) InitPresentation(chatId int64) (string, error) {
 	var buffer *C.char
 	f := CreateFuture()
@@ -474,6 +536,92 @@ func GetMediaDevices() MediaDevices {
 	}
 }
 
+//goland:noinspection GoUnusedExportedFunction
+func SetPlayoutThreads(threads uint32) {
+	C.ntg_set_playout_threads(C.uint32_t(threads))
+}
+
+//goland:noinspection GoUnusedExportedFunction
+func GetPlayoutStats() PlayoutStats {
+	var buffer C.ntg_playout_stats_struct
+	C.ntg_get_playout_stats(&buffer)
+	return PlayoutStats{
+		Threads:   uint32(buffer.threads),
+		Ticks:     uint64(buffer.ticks),
+		LateTicks: uint64(buffer.lateTicks),
+	}
+}
+
+//goland:noinspection GoUnusedExportedFunction
+func GetSocketBatchStats() SocketBatchStats {
+	var buffer C.ntg_socket_batch_stats_struct
+	C.ntg_get_socket_batch_stats(&buffer)
+	return SocketBatchStats{
+		ReadWakeups:     uint64(buffer.readWakeups),
+		PacketsReceived: uint64(buffer.packetsReceived),
+		MaxReadBatch:    uint32(buffer.maxReadBatch),
+		SendFlushes:     uint64(buffer.sendFlushes),
+		PacketsSent:     uint64(buffer.packetsSent),
+		MaxSendBatch:    uint32(buffer.maxSendBatch),
+		GsoSends:        uint64(buffer.gsoSends),
+		SharedSockets:   uint32(buffer.sharedSockets),
+		SharedHandles:   uint32(buffer.sharedHandles),
+		OverflowSockets: uint32(buffer.overflowSockets),
+		UnroutedPackets: uint64(buffer.unroutedPackets),
+	}
+}
+
+//goland:noinspection GoUnusedExportedFunction
+func SetSharedSockets(socketsPerAddress uint32) {
+	C.ntg_set_shared_sockets(C.uint32_t(socketsPerAddress))
+}
+
+//goland:noinspection GoUnusedExportedFunction
+func EnableTracing(enable bool, eventsPerThread uint32) {
+	C.ntg_enable_tracing(C.bool(enable), C.uint32_t(eventsPerThread))
+}
+
+//goland:noinspection GoUnusedExportedFunction
+func ExportTrace(path string) error {
+	cPath := C.CString(path)
+	defer C.free(unsafe.Pointer(cPath))
+	if code := C.ntg_export_trace(cPath); code != 0 {
+		return fmt.Errorf("error code: %d", int(code))
+	}
+	return nil
+}
+
+//goland:noinspection GoUnusedExportedFunction
+func ExportMetrics() (string, error) {
+	var buffer *C.char
+	if code := C.ntg_export_metrics(&buffer); code != 0 {
+		return "", fmt.Errorf("error code: %d", int(code))
+	}
+	defer C.free(unsafe.Pointer(buffer))
+	return C.GoString(buffer), nil
+}
+
+//goland:noinspection GoUnusedExportedFunction
+func ConfigureCertificatePool(size uint32, lifetime uint32) {
+	C.ntg_configure_certificate_pool(C.uint32_t(size), C.uint32_t(lifetime))
+}
+
+func (ctx *Client) JoinLocalSfu(payload string) (string, error) {
+	var buffer *C.char
+	f := CreateFuture()
+	C.ntg_join_local_sfu(C.uintptr_t(ctx.ptr), C.CString(payload), &buffer, f.ParseToC())
+	f.wait()
+	defer C.free(unsafe.Pointer(buffer))
+	return C.GoString(buffer), parseErrorCode(f)
+}
+
+func (ctx *Client) LeaveLocalSfu(ssrc uint32) (bool, error) {
+	f := CreateFuture()
+	C.ntg_leave_local_sfu(C.uintptr_t(ctx.ptr), C.uint32_t(ssrc), f.ParseToC())
+	f.wait()
+	return parseBool(f)
+}
+
 func (ctx *Client) CpuUsage() (float64, error) {
 	f := CreateFuture()
 	var buffer C.double
@@ -486,6 +634,151 @@ func (ctx *Client) EnableGLibLoop(enable bool) {
 	C.ntg_enable_g_lib_loop(C.bool(enable))
 }
 
+func (ctx *Client) StopAll(timeout uint32) error {
+	f := CreateFuture()
+	C.ntg_stop_all(C.uintptr_t(ctx.ptr), C.uint32_t(timeout), f.ParseToC())
+	f.wait()
+	return parseErrorCode(f)
+}
+
+func (ctx *Client) EnableFastExit(enable bool) {
+	C.ntg_enable_fast_exit(C.uintptr_t(ctx.ptr), C.bool(enable))
+}
+
+func (ctx *Client) ConfigureConnectionPool(size uint32, idleTimeout uint32) {
+	C.ntg_configure_connection_pool(C.uintptr_t(ctx.ptr), C.uint32_t(size), C.uint32_t(idleTimeout))
+}
+
+func (ctx *Client) ConnectionPoolStats() ConnectionPoolStats {
+	var buffer C.ntg_connection_pool_stats_struct
+	C.ntg_get_connection_pool_stats(C.uintptr_t(ctx.ptr), &buffer)
+	return ConnectionPoolStats{
+		Ready:  uint32(buffer.ready),
+		Hits:   uint64(buffer.hits),
+		Misses: uint64(buffer.misses),
+	}
+}
+
+func (ctx *Client) EventQueueStats() EventQueueStats {
+	var buffer C.ntg_event_queue_stats_struct
+	C.ntg_get_event_queue_stats(C.uintptr_t(ctx.ptr), &buffer)
+	return EventQueueStats{
+		Depth:     uint32(buffer.depth),
+		MaxDepth:  uint32(buffer.maxDepth),
+		Batches:   uint64(buffer.batches),
+		Delivered: uint64(buffer.delivered),
+		Coalesced: uint64(buffer.coalesced),
+		Dropped:   uint64(buffer.dropped),
+	}
+}
+
+func (ctx *Client) GetSnapshot(chatId int64) (CallSnapshot, error) {
+	var buffer C.ntg_call_snapshot_struct
+	if code := C.ntg_get_snapshot(C.uintptr_t(ctx.ptr), C.int64_t(chatId), &buffer); code != 0 {
+		return CallSnapshot{}, fmt.Errorf("error code: %d", int(code))
+	}
+	return parseCallSnapshot(buffer), nil
+}
+
+func (ctx *Client) GetSnapshots() map[int64]CallSnapshot {
+	mapReturn := make(map[int64]CallSnapshot)
+	var buffer *C.ntg_call_snapshot_struct
+	var size C.int
+	C.ntg_get_snapshots(C.uintptr_t(ctx.ptr), &buffer, &size)
+	for i := 0; i < int(size); i++ {
+		raw := *(*C.ntg_call_snapshot_struct)(unsafe.Pointer(uintptr(unsafe.Pointer(buffer)) + uintptr(i)*unsafe.Sizeof(C.ntg_call_snapshot_struct{})))
+		mapReturn[int64(raw.chatId)] = parseCallSnapshot(raw)
+	}
+	defer C.free(unsafe.Pointer(buffer))
+	return mapReturn
+}
+
+func (ctx *Client) GetResourceUsage() (ResourceUsage, error) {
+	var buffer C.ntg_resource_usage_struct
+	if code := C.ntg_get_resource_usage(C.uintptr_t(ctx.ptr), &buffer); code != 0 {
+		return ResourceUsage{}, fmt.Errorf("error code: %d", int(code))
+	}
+	defer C.free(unsafe.Pointer(buffer.threads))
+	defer C.free(unsafe.Pointer(buffer.calls))
+	usage := ResourceUsage{
+		ResidentBytes: uint64(buffer.residentBytes),
+		Calls:         make(map[int64]CallResourceUsage),
+	}
+	for i := 0; i < int(buffer.sizeThreads); i++ {
+		raw := (*C.ntg_thread_resource_usage_struct)(unsafe.Pointer(uintptr(unsafe.Pointer(buffer.threads)) + uintptr(i)*unsafe.Sizeof(C.ntg_thread_resource_usage_struct{})))
+		usage.Threads = append(usage.Threads, ThreadResourceUsage{
+			ThreadId: int64(raw.threadId),
+			Name:     C.GoString(&raw.name[0]),
+			CpuTime:  uint64(raw.cpuTime),
+		})
+	}
+	for i := 0; i < int(buffer.sizeCalls); i++ {
+		raw := *(*C.ntg_call_resource_usage_struct)(unsafe.Pointer(uintptr(unsafe.Pointer(buffer.calls)) + uintptr(i)*unsafe.Sizeof(C.ntg_call_resource_usage_struct{})))
+		usage.Calls[int64(raw.chatId)] = CallResourceUsage{
+			ReaderCpuTime:  uint64(raw.readerCpuTime),
+			MixerCpuTime:   uint64(raw.mixerCpuTime),
+			EncoderCpuTime: uint64(raw.encoderCpuTime),
+			DecoderCpuTime: uint64(raw.decoderCpuTime),
+			BufferedBytes:  int64(raw.bufferedBytes),
+		}
+	}
+	return usage, nil
+}
+
+func (ctx *Client) DumpResourceUsage() (string, error) {
+	var buffer *C.char
+	if code := C.ntg_dump_resource_usage(C.uintptr_t(ctx.ptr), &buffer); code != 0 {
+		return "", fmt.Errorf("error code: %d", int(code))
+	}
+	defer C.free(unsafe.Pointer(buffer))
+	return C.GoString(buffer), nil
+}
+
+func (ctx *Client) EnableEventPolling(capacity uint32) (int, error) {
+	var fd C.int
+	if code := C.ntg_enable_event_polling(C.uintptr_t(ctx.ptr), C.uint32_t(capacity), &fd); code != 0 {
+		return -1, fmt.Errorf("error code: %d", int(code))
+	}
+	return int(fd), nil
+}
+
+// PollEvents runs the registered callbacks for every queued event without blocking
+func (ctx *Client) PollEvents() (int, uint64, error) {
+	return ctx.WaitEvents(0)
+}
+
+// WaitEvents blocks up to timeout milliseconds for events, then runs the registered callbacks for them.
+// It also returns the state updates dropped since the previous read, read the snapshots again when they are not zero
+func (ctx *Client) WaitEvents(timeout uint32) (int, uint64, error) {
+	var buffer [64]C.ntg_event_struct
+	var count C.int
+	var dropped C.uint64_t
+	if code := C.ntg_wait_events(C.uintptr_t(ctx.ptr), &buffer[0], C.int(len(buffer)), &count, &dropped, C.uint32_t(timeout)); code != 0 {
+		return 0, 0, fmt.Errorf("error code: %d", int(code))
+	}
+	selfPointer := unsafe.Pointer(ctx)
+	for _, event := range buffer[:count] {
+		switch event.kind {
+		case C.NTG_EVENT_STREAM_END:
+			handleStreamEnd(0, event.chatId, event.streamType, event.device, selfPointer)
+		case C.NTG_EVENT_UPGRADE:
+			handleUpgrade(0, event.chatId, event.mediaState, selfPointer)
+		case C.NTG_EVENT_CONNECTION_CHANGE:
+			handleConnectionChange(0, event.chatId, event.networkInfo, selfPointer)
+		case C.NTG_EVENT_SIGNALING_DATA:
+			handleSignal(0, event.chatId, event.data, event.sizeData, selfPointer)
+			C.free(unsafe.Pointer(event.data))
+		case C.NTG_EVENT_REMOTE_SOURCE_CHANGE:
+			handleRemoteSourceChange(0, event.chatId, event.remoteSource, selfPointer)
+		case C.NTG_EVENT_REQUEST_BROADCAST_PART:
+			handleRequestBroadcastPart(0, event.chatId, event.partRequest, selfPointer)
+		case C.NTG_EVENT_REQUEST_BROADCAST_TIMESTAMP:
+			handleRequestBroadcastTimestamp(0, event.chatId, selfPointer)
+		}
+	}
+	return int(count), uint64(dropped), nil
+}
+
 func (ctx *Client) Calls() map[int64]*CallInfo {
 	mapReturn := make(map[int64]*CallInfo)
 	f := CreateFuture()
@@ -496,8 +789,9 @@ func (ctx *Client) Calls() map[int64]*CallInfo {
 	for i := 0; i < int(size); i++ {
 		rawCall := *(*C.ntg_call_info_struct)(unsafe.Pointer(uintptr(unsafe.Pointer(buffer)) + uintptr(i)*unsafe.Sizeof(C.ntg_call_info_struct{})))
 		mapReturn[int64(rawCall.chatId)] = &CallInfo{
-			Playback: parseStreamStatus(rawCall.playback),
-			Capture:  parseStreamStatus(rawCall.capture),
+			Playback:         parseStreamStatus(rawCall.playback),
+			Capture:          parseStreamStatus(rawCall.capture),
+			SuppressedFrames: uint64(rawCall.suppressedFrames),
 		}
 	}
 	defer C.free(unsafe.Pointer(buffer))
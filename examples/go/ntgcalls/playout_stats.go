@@ -0,0 +1,7 @@
+package ntgcalls
+
+type PlayoutStats struct {
+	Threads   uint32
+	Ticks     uint64
+	LateTicks uint64
+}
@@ -0,0 +1,20 @@
+package ntgcalls
+
+// CPU times are in microseconds
+type ThreadResourceUsage struct {
+	ThreadId int64
+	Name     string
+	CpuTime  uint64
+}
+
+type CallResourceUsage struct {
+	ReaderCpuTime, MixerCpuTime    uint64
+	EncoderCpuTime, DecoderCpuTime uint64
+	BufferedBytes                  int64
+}
+
+type ResourceUsage struct {
+	ResidentBytes uint64
+	Threads       []ThreadResourceUsage
+	Calls         map[int64]CallResourceUsage
+}
@@ -0,0 +1,15 @@
+package ntgcalls
+
+type SocketBatchStats struct {
+	ReadWakeups     uint64
+	PacketsReceived uint64
+	MaxReadBatch    uint32
+	SendFlushes     uint64
+	PacketsSent     uint64
+	MaxSendBatch    uint32
+	GsoSends        uint64
+	SharedSockets   uint32
+	SharedHandles   uint32
+	OverflowSockets uint32
+	UnroutedPackets uint64
+}
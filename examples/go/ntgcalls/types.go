@@ -13,6 +13,7 @@ type StreamDevice int
 type MediaSource int
 type MediaSegmentQuality int
 type MediaSegmentStatus int
+type PixelFormat int
 
 type StreamEndCallback func(chatId int64, streamType StreamType, streamDevice StreamDevice)
 type UpgradeCallback func(chatId int64, state MediaState)
@@ -88,6 +89,12 @@ const (
 	SegmentStatusSuccess
 )
 
+const (
+	PixelFormatI420 PixelFormat = iota
+	PixelFormatNV12
+	PixelFormatRGBA
+)
+
 func (ctx MediaSource) ParseToC() C.ntg_media_source_enum {
 	switch ctx {
 	case MediaSourceFile:
@@ -145,3 +152,16 @@ func (ctx MediaSegmentStatus) ParseToC() C.ntg_media_segment_status_enum {
 		return C.NTG_MEDIA_SEGMENT_NOT_READY
 	}
 }
+
+func (ctx PixelFormat) ParseToC() C.ntg_pixel_format_enum {
+	switch ctx {
+	case PixelFormatI420:
+		return C.NTG_PIXEL_FORMAT_I420
+	case PixelFormatNV12:
+		return C.NTG_PIXEL_FORMAT_NV12
+	case PixelFormatRGBA:
+		return C.NTG_PIXEL_FORMAT_RGBA
+	default:
+		return C.NTG_PIXEL_FORMAT_I420
+	}
+}
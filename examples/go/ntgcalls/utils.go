@@ -115,6 +115,50 @@ func parseStreamStatus(status C.ntg_stream_status_enum) StreamStatus {
 	return ActiveStream
 }
 
+func parseConnectionMode(mode C.ntg_connection_mode_enum) (ConnectionMode, bool) {
+	switch mode {
+	case C.NTG_CONNECTION_MODE_RTC:
+		return RtcConnection, true
+	case C.NTG_CONNECTION_MODE_STREAM:
+		return StreamConnection, true
+	case C.NTG_CONNECTION_MODE_RTMP:
+		return RTMPConnection, true
+	}
+	return ConnectionMode(0), false
+}
+
+func parseCallSnapshot(raw C.ntg_call_snapshot_struct) CallSnapshot {
+	mode, hasConnection := parseConnectionMode(raw.connectionMode)
+	return CallSnapshot{
+		State: MediaState{
+			Muted:              bool(raw.state.muted),
+			VideoPaused:        bool(raw.state.videoPaused),
+			VideoStopped:       bool(raw.state.videoStopped),
+			PresentationPaused: bool(raw.state.presentationPaused),
+		},
+		Playback:         parseStreamStatus(raw.playback),
+		Capture:          parseStreamStatus(raw.capture),
+		PlaybackTime:     uint64(raw.playbackTime),
+		CaptureTime:      uint64(raw.captureTime),
+		SuppressedFrames: uint64(raw.suppressedFrames),
+		HasConnection:    hasConnection,
+		ConnectionMode:   mode,
+	}
+}
+
+func parseLatencySummary(raw C.ntg_latency_summary_struct) LatencySummary {
+	return LatencySummary{
+		Count: uint64(raw.count),
+		Min:   int64(raw.min),
+		Mean:  int64(raw.mean),
+		Max:   int64(raw.max),
+		P50:   int64(raw.p50),
+		P90:   int64(raw.p90),
+		P99:   int64(raw.p99),
+		P999:  int64(raw.p999),
+	}
+}
+
 func parseRtcServers(rtcServers []RTCServer) *C.ntg_rtc_server_struct {
 	if len(rtcServers) > 0 {
 		rawServers := make([]C.ntg_rtc_server_struct, len(rtcServers))
@@ -5,11 +5,13 @@ package ntgcalls
 import "C"
 
 type VideoDescription struct {
-	MediaSource   MediaSource
-	Input         string
-	Width, Height int16
-	Fps           uint8
-	KeepOpen      bool
+	MediaSource     MediaSource
+	Input           string
+	Width, Height   int16
+	Fps             uint8
+	KeepOpen        bool
+	PixelFormat     PixelFormat
+	StaticRefreshMs uint16
 }
 
 func (ctx *VideoDescription) ParseToC() C.ntg_video_description_struct {
@@ -20,5 +22,7 @@ func (ctx *VideoDescription) ParseToC() C.ntg_video_description_struct {
 	x.height = C.int16_t(ctx.Height)
 	x.fps = C.uint8_t(ctx.Fps)
 	x.keepOpen = C.bool(ctx.KeepOpen)
+	x.pixelFormat = ctx.PixelFormat.ParseToC()
+	x.staticRefreshMs = C.uint16_t(ctx.StaticRefreshMs)
 	return x
 }
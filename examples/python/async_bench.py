@@ -0,0 +1,61 @@
+import asyncio
+import statistics
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from ntgcalls import NTgCalls, ConnectionNotFound
+
+concurrency = 5000
+# Size of the executor the binding used to resolve every async method through
+executor_workers = 32
+
+
+async def timed(coro) -> float:
+    start = time.perf_counter()
+    try:
+        await coro
+    except ConnectionNotFound:
+        pass
+    return time.perf_counter() - start
+
+
+def blocking(loop, call):
+    # Parks an executor thread until the native call resolves, as the old binding did
+    async def wait():
+        return await call()
+    return asyncio.run_coroutine_threadsafe(wait(), loop).result()
+
+
+async def run(name, factory):
+    start = time.perf_counter()
+    latencies = await asyncio.gather(*(timed(factory(i)) for i in range(concurrency)))
+    elapsed = time.perf_counter() - start
+    latencies.sort()
+    print(
+        f"{name}: {concurrency / elapsed:.0f} calls/s, "
+        f"p50 {statistics.median(latencies) * 1000:.2f} ms, "
+        f"p99 {latencies[int(len(latencies) * 0.99)] * 1000:.2f} ms"
+    )
+
+
+async def main():
+    wrtc = NTgCalls()
+    loop = asyncio.get_running_loop()
+    executor = ThreadPoolExecutor(max_workers=executor_workers)
+    # Warm up the workers
+    await wrtc.cpu_usage()
+    await loop.run_in_executor(executor, blocking, loop, wrtc.cpu_usage)
+
+    for name, factory in (
+        ("cpu_usage", lambda i: wrtc.cpu_usage()),
+        ("get_state (missing chat)", lambda i: wrtc.get_state(-1000000000000 - i)),
+    ):
+        await run(f"{name}, asyncio futures", factory)
+        await run(
+            f"{name}, run_in_executor ({executor_workers} threads)",
+            lambda i: loop.run_in_executor(executor, blocking, loop, lambda: factory(i)),
+        )
+    executor.shutdown()
+
+
+asyncio.run(main())
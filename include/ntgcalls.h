@@ -61,6 +61,12 @@ typedef enum {
     NTG_EXTERNAL = 1 << 5
 } ntg_media_source_enum;
 
+typedef enum {
+    NTG_PIXEL_FORMAT_I420,
+    NTG_PIXEL_FORMAT_NV12,
+    NTG_PIXEL_FORMAT_RGBA
+} ntg_pixel_format_enum;
+
 typedef enum {
     NTG_STREAM_MICROPHONE,
     NTG_STREAM_SPEAKER,
@@ -110,6 +116,16 @@ typedef enum {
     NTG_MEDIA_SEGMENT_SUCCESS,
 } ntg_media_segment_status_enum;
 
+typedef enum {
+    NTG_EVENT_STREAM_END,
+    NTG_EVENT_UPGRADE,
+    NTG_EVENT_CONNECTION_CHANGE,
+    NTG_EVENT_SIGNALING_DATA,
+    NTG_EVENT_REMOTE_SOURCE_CHANGE,
+    NTG_EVENT_REQUEST_BROADCAST_PART,
+    NTG_EVENT_REQUEST_BROADCAST_TIMESTAMP,
+} ntg_event_kind_enum;
+
 typedef enum {
     NTG_CONNECTION_MODE_NONE,
     NTG_CONNECTION_MODE_RTC,
@@ -136,6 +152,8 @@ typedef struct {
     int16_t width, height;
     uint8_t fps;
     bool keepOpen;
+    ntg_pixel_format_enum pixelFormat;
+    uint16_t staticRefreshMs;
 } ntg_video_description_struct;
 
 typedef struct {
@@ -155,6 +173,7 @@ typedef struct {
     int64_t chatId;
     ntg_stream_status_enum capture;
     ntg_stream_status_enum playback;
+    uint64_t suppressedFrames;
 } ntg_call_info_struct;
 
 typedef struct {
@@ -187,6 +206,121 @@ typedef struct {
     int libraryVersionsSize;
 } ntg_protocol_struct;
 
+typedef struct {
+    uint32_t threads;
+    uint64_t ticks;
+    uint64_t lateTicks;
+} ntg_playout_stats_struct;
+
+typedef struct {
+    uint64_t readWakeups;
+    uint64_t packetsReceived;
+    uint32_t maxReadBatch;
+    uint64_t sendFlushes;
+    uint64_t packetsSent;
+    uint32_t maxSendBatch;
+    uint64_t gsoSends;
+    uint32_t sharedSockets;
+    uint32_t sharedHandles;
+    uint32_t overflowSockets;
+    uint64_t unroutedPackets;
+} ntg_socket_batch_stats_struct;
+
+typedef struct {
+    uint32_t ready;
+    uint64_t hits;
+    uint64_t misses;
+} ntg_connection_pool_stats_struct;
+
+typedef struct {
+    uint32_t depth;
+    uint32_t maxDepth;
+    uint64_t batches;
+    uint64_t delivered;
+    uint64_t coalesced;
+    uint64_t dropped;
+} ntg_event_queue_stats_struct;
+
+typedef struct {
+    int64_t chatId;
+    ntg_media_state_struct state;
+    ntg_stream_status_enum playback;
+    ntg_stream_status_enum capture;
+    uint64_t playbackTime;
+    uint64_t captureTime;
+    uint64_t suppressedFrames;
+    ntg_connection_mode_enum connectionMode;
+} ntg_call_snapshot_struct;
+
+typedef struct {
+    uint32_t ssrc;
+    bool outgoing;
+    bool video;
+    uint64_t bytes;
+    uint64_t packets;
+    int64_t packetsLost;
+    double fractionLost;
+    double jitterMs;
+    uint64_t nacks;
+    uint64_t plis;
+    uint64_t bitrate;
+    double frameTimeMs;
+    double jitterBufferDelayMs;
+} ntg_rtp_stream_stats_struct;
+
+typedef struct {
+    int64_t timestamp;
+    double rttMs;
+    uint64_t sendBandwidth;
+    uint64_t receiveBandwidth;
+    int64_t pacerDelayMs;
+    uint64_t transportBytesSent;
+    uint64_t transportBytesReceived;
+    ntg_rtp_stream_stats_struct* streams;
+    int sizeStreams;
+} ntg_call_stats_struct;
+
+typedef struct {
+    uint64_t count;
+    int64_t min;
+    int64_t mean;
+    int64_t max;
+    int64_t p50;
+    int64_t p90;
+    int64_t p99;
+    int64_t p999;
+} ntg_latency_summary_struct;
+
+typedef struct {
+    ntg_latency_summary_struct audioSend;
+    ntg_latency_summary_struct videoSend;
+    ntg_latency_summary_struct audioReceive;
+    ntg_latency_summary_struct videoReceive;
+} ntg_call_latency_struct;
+
+typedef struct {
+    int64_t threadId;
+    char name[16];
+    uint64_t cpuTime;
+} ntg_thread_resource_usage_struct;
+
+typedef struct {
+    int64_t chatId;
+    uint64_t readerCpuTime;
+    uint64_t mixerCpuTime;
+    uint64_t encoderCpuTime;
+    uint64_t decoderCpuTime;
+    int64_t bufferedBytes;
+} ntg_call_resource_usage_struct;
+
+typedef struct {
+    uint64_t residentBytes;
+    ntg_thread_resource_usage_struct* threads;
+    int sizeThreads;
+    ntg_call_resource_usage_struct* calls;
+    int sizeCalls;
+} ntg_resource_usage_struct;
+
 typedef struct {
     int32_t g;
     const uint8_t* p;
@@ -255,6 +389,19 @@ typedef struct {
     ntg_media_segment_quality_enum quality;
 } ntg_segment_part_request_struct;
 
+typedef struct {
+    ntg_event_kind_enum kind;
+    int64_t chatId;
+    ntg_stream_type_enum streamType;
+    ntg_stream_device_enum device;
+    ntg_media_state_struct mediaState;
+    ntg_network_info_struct networkInfo;
+    uint8_t* data;
+    int sizeData;
+    ntg_remote_source_struct remoteSource;
+    ntg_segment_part_request_struct partRequest;
+} ntg_event_struct;
+
 typedef void (*ntg_stream_callback)(uintptr_t, int64_t, ntg_stream_type_enum, ntg_stream_device_enum, void*);
 
 typedef void (*ntg_upgrade_callback)(uintptr_t, int64_t, ntg_media_state_struct, void*);
@@ -322,8 +469,30 @@ NTG_C_EXPORT int ntg_send_signaling_data(uintptr_t ptr, int64_t userId, uint8_t*
 
 NTG_C_EXPORT int ntg_get_protocol(ntg_protocol_struct* buffer);
 
+NTG_C_EXPORT int ntg_set_playout_threads(uint32_t threads);
+
+NTG_C_EXPORT int ntg_get_playout_stats(ntg_playout_stats_struct* buffer);
+
+NTG_C_EXPORT int ntg_get_socket_batch_stats(ntg_socket_batch_stats_struct* buffer);
+
+NTG_C_EXPORT int ntg_set_shared_sockets(uint32_t socketsPerAddress);
+
+NTG_C_EXPORT int ntg_enable_tracing(bool enable, uint32_t eventsPerThread);
+
+NTG_C_EXPORT int ntg_export_trace(char* path);
+
+NTG_C_EXPORT int ntg_export_metrics(char** buffer);
+
+NTG_C_EXPORT int ntg_configure_certificate_pool(uint32_t size, uint32_t lifetime);
+
+NTG_C_EXPORT int ntg_join_local_sfu(uintptr_t ptr, char* joinPayload, char** buffer, ntg_async_struct future);
+
+NTG_C_EXPORT int ntg_leave_local_sfu(uintptr_t ptr, uint32_t ssrc, ntg_async_struct future);
+
 NTG_C_EXPORT int ntg_create(uintptr_t ptr, int64_t chatID, char** buffer, ntg_async_struct future);
 
+NTG_C_EXPORT int ntg_create_null(uintptr_t ptr, int64_t chatID, bool loopback, ntg_async_struct future);
+
 NTG_C_EXPORT int ntg_connect(uintptr_t ptr, int64_t chatID, char* params, bool isPresentation, ntg_async_struct future);
 
 NTG_C_EXPORT int ntg_set_stream_sources(uintptr_t ptr, int64_t chatID, ntg_stream_mode_enum streamMode, ntg_media_description_struct desc, ntg_async_struct future);
@@ -344,6 +513,10 @@ NTG_C_EXPORT int ntg_get_state(uintptr_t ptr, int64_t chatID, ntg_media_state_st
 
 NTG_C_EXPORT int ntg_get_connection_mode(uintptr_t ptr, int64_t chatID, ntg_connection_mode_enum* mode, ntg_async_struct future);
 
+NTG_C_EXPORT int ntg_get_stats(uintptr_t ptr, int64_t chatID, bool cached, ntg_call_stats_struct* buffer, ntg_async_struct future);
+
+NTG_C_EXPORT int ntg_get_latency(uintptr_t ptr, int64_t chatID, ntg_call_latency_struct* buffer, ntg_async_struct future);
+
 NTG_C_EXPORT int ntg_send_external_frame(uintptr_t ptr, int64_t chatID, ntg_stream_device_enum device, uint8_t* frame, int frameSize, ntg_frame_data_struct frameData, ntg_async_struct future);
 
 NTG_C_EXPORT int ntg_send_broadcast_timestamp(uintptr_t ptr, int64_t chatId, int64_t timestamp, ntg_async_struct future);
@@ -376,6 +549,31 @@ NTG_C_EXPORT int ntg_cpu_usage(uintptr_t ptr, double* buffer, ntg_async_struct f
 
 NTG_C_EXPORT int ntg_enable_g_lib_loop(bool enable);
 
+NTG_C_EXPORT int ntg_stop_all(uintptr_t ptr, uint32_t timeout, ntg_async_struct future);
+
+NTG_C_EXPORT int ntg_enable_fast_exit(uintptr_t ptr, bool enable);
+
+NTG_C_EXPORT int ntg_configure_connection_pool(uintptr_t ptr, uint32_t size, uint32_t idleTimeout);
+
+NTG_C_EXPORT int ntg_get_connection_pool_stats(uintptr_t ptr, ntg_connection_pool_stats_struct* buffer);
+
+NTG_C_EXPORT int ntg_get_event_queue_stats(uintptr_t ptr, ntg_event_queue_stats_struct* buffer);
+
+NTG_C_EXPORT int ntg_get_snapshot(uintptr_t ptr, int64_t chatID, ntg_call_snapshot_struct* buffer);
+
+NTG_C_EXPORT int ntg_get_snapshots(uintptr_t ptr, ntg_call_snapshot_struct** buffer, int* size);
+
+NTG_C_EXPORT int ntg_get_resource_usage(uintptr_t ptr, ntg_resource_usage_struct* buffer);
+
+NTG_C_EXPORT int ntg_dump_resource_usage(uintptr_t ptr, char** buffer);
+
+NTG_C_EXPORT int ntg_enable_event_polling(uintptr_t ptr, uint32_t capacity, int* fd);
+
+// dropped, when not NULL, receives the state updates lost to a full ring since the previous read
+NTG_C_EXPORT int ntg_poll_events(uintptr_t ptr, ntg_event_struct* buffer, int size, int* count, uint64_t* dropped);
+
+NTG_C_EXPORT int ntg_wait_events(uintptr_t ptr, ntg_event_struct* buffer, int size, int* count, uint64_t* dropped, uint32_t timeout);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,7 @@
 #include <wrtc/utils/sync_helper.hpp>
 #include <ntgcalls/devices/device_info.hpp>
 #include <ntgcalls/models/media_description.hpp>
+#include <common_video/include/video_frame_buffer_pool.h>
 #include <modules/desktop_capture/desktop_and_cursor_composer.h>
 
 namespace ntgcalls {
@@ -21,11 +22,29 @@ namespace ntgcalls {
         VideoDescription desc;
         webrtc::PlatformThread thread;
 
+        // Persistent I420 image at capture resolution, only damaged rectangles are converted into it
+        bytes::unique_binary canvas;
+        webrtc::DesktopSize canvasSize;
+        // Last emitted frame at the requested resolution, handed out again when nothing changed
+        webrtc::scoped_refptr<webrtc::I420Buffer> output;
+        webrtc::VideoFrameBufferPool outputPool;
+        bool hasFrame = false;
+
         static std::unique_ptr<webrtc::DesktopCapturer> CreateCapturer();
 
+        void resizeCanvas(const webrtc::DesktopSize& size);
+
+        void convertRegion(const webrtc::DesktopFrame& frame, const webrtc::DesktopRect& rect) const;
+
+        void updateOutput();
+
+        void emitFrame();
+
     public:
         DesktopCapturerModule(const VideoDescription& desc, BaseSink* sink);
 
+        DesktopCapturerModule(const VideoDescription& desc, BaseSink* sink, std::unique_ptr<webrtc::DesktopCapturer> capturer);
+
         ~DesktopCapturerModule() override;
 
         void OnCaptureResult(webrtc::DesktopCapturer::Result result, std::unique_ptr<webrtc::DesktopFrame> frame) override;
@@ -66,4 +66,12 @@ namespace ntgcalls {
     class EOFError final : public wrtc::BaseRTCException {
         using BaseRTCException::BaseRTCException;
     };
+
+    class OperationCancelled final : public wrtc::BaseRTCException {
+        using BaseRTCException::BaseRTCException;
+    };
+
+    class OperationTimeout final : public wrtc::BaseRTCException {
+        using BaseRTCException::BaseRTCException;
+    };
 }
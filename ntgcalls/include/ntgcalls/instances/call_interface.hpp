@@ -3,10 +3,13 @@
 //
 
 #pragma once
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <ntgcalls/stream_manager.hpp>
 #include <ntgcalls/models/call_network_state.hpp>
+#include <ntgcalls/models/call_snapshot.hpp>
 #include <ntgcalls/models/remote_source_state.hpp>
 #include <ntgcalls/signaling/messages/media_state_message.hpp>
 #include <wrtc/interfaces/network_interface.hpp>
@@ -20,9 +23,26 @@ namespace ntgcalls {
         wrtc::synchronized_callback<NetworkInfo> connectionChangeCallback;
         wrtc::synchronized_callback<RemoteSource> remoteSourceCallback;
         webrtc::Thread* updateThread;
+        std::shared_ptr<ResourceAccount> account;
         StreamManager::Status lastCameraState = StreamManager::Status::Idling;
         StreamManager::Status lastScreenState = StreamManager::Status::Idling;
         StreamManager::Status lastMicState = StreamManager::Status::Idling;
+        // Guards swapping connection and streamManager against readers on other threads, stop() may run on any of them
+        mutable std::mutex snapshotMutex;
+        // Mirrors what the stream manager publishes, null once the call was stopped
+        std::shared_ptr<AtomicSnapshot<StreamManager::Snapshot>> streamState;
+        // Published when the connection is set and on its connection events
+        std::atomic<wrtc::ConnectionMode> connectionMode = wrtc::ConnectionMode::None;
+
+        void setConnection(std::shared_ptr<wrtc::NetworkInterface> conn);
+
+        // Copies taken under snapshotMutex, throw ConnectionNotFound once the call was stopped
+        std::shared_ptr<StreamManager> lockedStreamManager() const;
+
+        std::shared_ptr<wrtc::NetworkInterface> lockedConnection() const;
+
+        // Lock free, throws ConnectionNotFound once the call was stopped
+        std::shared_ptr<const StreamManager::Snapshot> publishedStreams() const;
 
         void setConnectionObserver(
             const std::shared_ptr<wrtc::NetworkInterface>& conn,
@@ -31,8 +51,10 @@ namespace ntgcalls {
 
         static StreamManager::Status parseVideoState(signaling::MediaStateMessage::VideoState state);
 
+        static void abandonConnection(std::shared_ptr<wrtc::NetworkInterface> conn);
+
     public:
-        virtual ~CallInterface() = default;
+        virtual ~CallInterface();
 
         explicit CallInterface(webrtc::Thread* updateThread);
 
@@ -45,8 +67,13 @@ namespace ntgcalls {
 
         virtual void stop();
 
+        // Releases the call without closing its RTC channels, only meant for process exit
+        virtual void abandon();
+
         wrtc::ConnectionMode getConnectionMode() const;
 
+        wrtc::CallStats getStats(bool cached) const;
+
         bool pause() const;
 
         bool resume() const;
@@ -71,6 +98,13 @@ namespace ntgcalls {
 
         StreamManager::Status status(StreamManager::Mode mode) const;
 
+        uint64_t suppressedFrames() const;
+
+        // Built from the published state without taking any lock, empty once the call was stopped
+        std::optional<CallSnapshot> snapshot() const;
+
+        const std::shared_ptr<ResourceAccount>& resourceAccount() const;
+
         virtual Type type() const = 0;
 
         void sendExternalFrame(StreamManager::Device device, const bytes::binary& data, wrtc::FrameData frameData) const;
@@ -22,7 +22,12 @@ namespace ntgcalls {
 
         void stop() override;
 
-        std::string init();
+        void abandon() override;
+
+        std::string init(std::shared_ptr<wrtc::GroupConnection> warmConnection = nullptr);
+
+        // Joins without signaling, media goes through a NullTransport
+        void initNull(wrtc::NullTransport::Mode mode);
 
         std::string initPresentation();
 
@@ -38,6 +38,8 @@ namespace ntgcalls {
 
         void stop() override;
 
+        void abandon() override;
+
         void init() const;
 
         bytes::vector initExchange(const DhConfig &dhConfig, const std::optional<bytes::vector> &g_a_hash);
@@ -3,16 +3,24 @@
 //
 
 #pragma once
+#include <atomic>
 #include <chrono>
+#include <ntgcalls/utils/resource_account.hpp>
 
 namespace ntgcalls {
 
     class BaseSink {
+        std::atomic<std::chrono::nanoseconds::rep> cachedFrameTime = 0;
+
     protected:
-        uint64_t frames = 0;
+        std::atomic_uint64_t frames = 0;
+        std::shared_ptr<ResourceAccount> resourceAccount;
 
         void clear();
 
+        // Called by setConfig, so the position can be read without the stream lock
+        void cacheFrameTime();
+
     public:
         virtual ~BaseSink();
 
@@ -25,6 +33,11 @@ namespace ntgcalls {
         virtual uint8_t frameRate() = 0;
 
         virtual std::chrono::nanoseconds frameTime() = 0;
+
+        // Set once before any reader or writer is attached to the sink
+        void setAccount(std::shared_ptr<ResourceAccount> account);
+
+        const std::shared_ptr<ResourceAccount>& account() const;
     };
 
 } // ntgcalls
@@ -0,0 +1,26 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace ntgcalls {
+
+    class StaticFrameDetector {
+        // Luma is hashed in horizontal tiles of this many rows, each tile is contiguous in memory
+        static constexpr int kTileRows = 16;
+
+        std::vector<uint32_t> tileHashes;
+        uint16_t lastWidth = 0, lastHeight = 0;
+        std::chrono::steady_clock::time_point lastForwarded;
+
+    public:
+        bool isStatic(const uint8_t* yPlane, uint16_t width, uint16_t height, std::chrono::milliseconds refreshInterval);
+
+        void reset();
+    };
+
+} // ntgcalls
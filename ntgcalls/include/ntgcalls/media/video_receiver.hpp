@@ -3,6 +3,7 @@
 //
 
 #pragma once
+#include <api/video/video_frame_buffer.h>
 #include <ntgcalls/media/video_sink.hpp>
 #include <ntgcalls/media/base_receiver.hpp>
 #include <wrtc/interfaces/media/remote_video_sink.hpp>
@@ -13,13 +14,32 @@
 namespace ntgcalls {
 
     class VideoReceiver final: public VideoSink, public BaseReceiver {
+        // Output and scaling buffers are reused across frames, the callback
+        // is invoked synchronously under the receiver mutex
+        class FramePool {
+            bytes::unique_binary buffer;
+            size_t capacity = 0;
+
+        public:
+            uint8_t* acquire(size_t size);
+
+            const bytes::unique_binary& get() const;
+
+            size_t size() const;
+        };
+
         std::shared_ptr<wrtc::RemoteVideoSink> sink;
-        wrtc::synchronized_callback<uint32_t, bytes::unique_binary, size_t, wrtc::FrameData> frameCallback;
+        wrtc::synchronized_callback<uint32_t, const bytes::unique_binary&, size_t, wrtc::FrameData> frameCallback;
+        FramePool outputPool, scalePool;
+
+        static size_t outputSize(VideoDescription::PixelFormat format, uint16_t width, uint16_t height);
+
+        void convertFrame(const webrtc::I420BufferInterface* buffer, uint16_t width, uint16_t height);
 
     public:
         ~VideoReceiver() override;
 
-        void onFrame(const std::function<void(uint32_t, bytes::unique_binary, size_t, wrtc::FrameData)>& callback);
+        void onFrame(const std::function<void(uint32_t, const bytes::unique_binary&, size_t, wrtc::FrameData)>& callback);
 
         std::weak_ptr<wrtc::RemoteVideoSink> remoteSink();
 
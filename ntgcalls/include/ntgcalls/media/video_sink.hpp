@@ -22,7 +22,7 @@ namespace ntgcalls {
         std::optional<VideoDescription> description;
 
     public:
-        bool setConfig(const std::optional<VideoDescription>& desc);
+        virtual bool setConfig(const std::optional<VideoDescription>& desc);
 
         std::optional<VideoDescription> getConfig();
 
@@ -4,13 +4,19 @@
 
 #pragma once
 
+#include <atomic>
 #include <wrtc/wrtc.hpp>
 #include <ntgcalls/media/video_sink.hpp>
 #include <ntgcalls/media/base_streamer.hpp>
+#include <ntgcalls/media/static_frame_detector.hpp>
 
 namespace ntgcalls {
     class VideoStreamer final : public VideoSink, public BaseStreamer {
         std::unique_ptr<wrtc::RTCVideoSource> video;
+        StaticFrameDetector staticDetector;
+        std::atomic_uint64_t suppressed = 0;
+        // Set by setConfig and consumed by the capture thread, which owns the detector
+        std::atomic_bool resetDetector = false;
 
     public:
         VideoStreamer();
@@ -19,7 +25,11 @@ namespace ntgcalls {
 
         webrtc::scoped_refptr<webrtc::MediaStreamTrackInterface> createTrack() override;
 
+        bool setConfig(const std::optional<VideoDescription>& desc) override;
+
         void sendData(uint8_t* sample, size_t size, wrtc::FrameData additionalData) override;
+
+        uint64_t suppressedFrames() const;
     };
 }
 
@@ -0,0 +1,25 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace ntgcalls {
+
+    // Latencies are in microseconds, percentiles are exact to about 3%
+    struct LatencySummary {
+        uint64_t count;
+        int64_t min, mean, max;
+        int64_t p50, p90, p99, p999;
+    };
+
+    // Send runs from the reader producing a frame to its first packet leaving the socket, sampled once per packet for audio,
+    // receive from the packet arrival (decoded playout for audio) to the frames callback
+    struct CallLatency {
+        LatencySummary audioSend, videoSend;
+        LatencySummary audioReceive, videoReceive;
+    };
+
+} // ntgcalls
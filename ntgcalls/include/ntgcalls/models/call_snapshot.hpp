@@ -0,0 +1,22 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <ntgcalls/stream_manager.hpp>
+#include <ntgcalls/models/media_state.hpp>
+#include <wrtc/enums.hpp>
+
+namespace ntgcalls {
+
+    struct CallSnapshot {
+        MediaState state;
+        StreamManager::Status playback, capture;
+        uint64_t playbackTime, captureTime;
+        uint64_t suppressedFrames;
+        wrtc::ConnectionMode connectionMode;
+    };
+
+} // ntgcalls
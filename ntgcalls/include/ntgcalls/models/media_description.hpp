@@ -47,19 +47,30 @@ namespace ntgcalls {
 
     class VideoDescription final : public BaseMediaDescription {
     public:
+        enum class PixelFormat {
+            I420,
+            NV12,
+            RGBA
+        };
+
         int16_t width, height;
         uint8_t fps;
+        PixelFormat pixelFormat;
+        // When non-zero, unchanged capture frames are dropped, forwarding one at least every staticRefreshMs
+        uint16_t staticRefreshMs;
 
-        VideoDescription(const MediaSource mediaSource, const int16_t width, const int16_t height, const uint8_t fps, const std::string& input, const bool keepOpen):
-                BaseMediaDescription(input, mediaSource, keepOpen), width(width), height(height), fps(fps) {}
+        VideoDescription(const MediaSource mediaSource, const int16_t width, const int16_t height, const uint8_t fps, const std::string& input, const bool keepOpen, const PixelFormat pixelFormat = PixelFormat::I420, const uint16_t staticRefreshMs = 0):
+                BaseMediaDescription(input, mediaSource, keepOpen), width(width), height(height), fps(fps), pixelFormat(pixelFormat), staticRefreshMs(staticRefreshMs) {}
     };
 
     inline bool operator==(const VideoDescription& lhs, const VideoDescription& rhs) {
         return lhs.width == rhs.width &&
             lhs.height == rhs.height &&
                 lhs.fps == rhs.fps &&
-                    lhs.input == rhs.input &&
-                        lhs.mediaSource == rhs.mediaSource;
+                    lhs.pixelFormat == rhs.pixelFormat &&
+                        lhs.staticRefreshMs == rhs.staticRefreshMs &&
+                            lhs.input == rhs.input &&
+                                lhs.mediaSource == rhs.mediaSource;
     }
 
     class MediaDescription {
@@ -0,0 +1,17 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace ntgcalls {
+
+    struct PlayoutStats {
+        uint32_t threads;
+        uint64_t ticks;
+        uint64_t lateTicks;
+    };
+
+} // ntgcalls
@@ -0,0 +1,32 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ntgcalls {
+
+    // CPU times are in microseconds
+    struct ThreadResourceUsage {
+        int64_t threadId;
+        std::string name;
+        uint64_t cpuTime;
+    };
+
+    struct CallResourceUsage {
+        int64_t chatId;
+        uint64_t readerCpuTime, mixerCpuTime, encoderCpuTime, decoderCpuTime;
+        int64_t bufferedBytes;
+    };
+
+    struct ResourceUsage {
+        uint64_t residentBytes;
+        std::vector<ThreadResourceUsage> threads;
+        std::vector<CallResourceUsage> calls;
+    };
+
+} // ntgcalls
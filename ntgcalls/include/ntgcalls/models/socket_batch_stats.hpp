@@ -0,0 +1,25 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace ntgcalls {
+
+    struct SocketBatchStats {
+        uint64_t readWakeups;
+        uint64_t packetsReceived;
+        uint32_t maxReadBatch;
+        uint64_t sendFlushes;
+        uint64_t packetsSent;
+        uint32_t maxSendBatch;
+        uint64_t gsoSends;
+        uint32_t sharedSockets;
+        uint32_t sharedHandles;
+        uint32_t overflowSockets;
+        uint64_t unroutedPackets;
+    };
+
+} // ntgcalls
@@ -9,14 +9,24 @@
 #include <ntgcalls/instances/call_interface.hpp>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <ntgcalls/models/auth_params.hpp>
+#include <ntgcalls/models/call_latency.hpp>
 #include <ntgcalls/models/dh_config.hpp>
 #include <ntgcalls/models/protocol.hpp>
+#include <ntgcalls/models/playout_stats.hpp>
+#include <ntgcalls/models/resource_usage.hpp>
+#include <ntgcalls/models/socket_batch_stats.hpp>
 #include <ntgcalls/models/rtc_server.hpp>
 #include <ntgcalls/utils/binding_utils.hpp>
 #include <ntgcalls/utils/hardware_info.hpp>
+#include <ntgcalls/utils/connection_pool.hpp>
+#include <ntgcalls/utils/connection_table.hpp>
+#include <ntgcalls/utils/event_dispatcher.hpp>
+#include <ntgcalls/utils/event_ring.hpp>
+#include <ntgcalls/utils/snapshot_publisher.hpp>
 #include <ntgcalls/utils/log_sink_impl.hpp>
 #include <ntgcalls/devices/media_devices.hpp>
 #include <ntgcalls/models/remote_source_state.hpp>
+#include <wrtc/interfaces/local_sfu.hpp>
 #include <wrtc/models/media_content.hpp>
 #include <wrtc/models/segment_part_request.hpp>
 
@@ -31,7 +41,7 @@ throw ConnectionNotFound("Connection with chat id \"" + std::to_string(chatId) +
 namespace ntgcalls {
 
     class NTgCalls {
-        std::unordered_map<int64_t, std::shared_ptr<CallInterface>> connections;
+        ConnectionTable connections;
         wrtc::synchronized_callback<int64_t, StreamManager::Type, StreamManager::Device> onEof;
         wrtc::synchronized_callback<int64_t, MediaState> mediaStateCallback;
         wrtc::synchronized_callback<int64_t, NetworkInfo> connectionChangeCallback;
@@ -42,20 +52,42 @@ namespace ntgcalls {
         wrtc::synchronized_callback<int64_t, StreamManager::Mode, StreamManager::Device, std::vector<wrtc::Frame>> framesCallback;
         std::unique_ptr<webrtc::Thread> updateThread;
         std::unique_ptr<HardwareInfo> hardwareInfo;
+        std::unique_ptr<ConnectionPool> connectionPool;
+        std::unique_ptr<EventDispatcher> events;
+        // Set once, readers hold their own reference so a blocked waitEvents outlives the destructor's close
+        std::shared_ptr<EventRing> eventRing;
+        mutable std::mutex eventRingMutex;
+        std::unique_ptr<SnapshotPublisher> snapshots;
+        // Closes removed calls in the background, kept apart from the async workers that wait on it
+        std::unique_ptr<WorkerPool> closers;
+        // Created on the first join and released with this instance, a join still in flight keeps it alive
+        std::shared_ptr<wrtc::LocalSfu> sfu;
+        std::mutex sfuMutex;
+        std::atomic_bool fastExit = false;
         std::mutex mutex;
         ASYNC_ARGS
 
         bool exists(int64_t chatId) const;
 
-        CallInterface* safeConnection(int64_t chatId);
+        std::shared_ptr<EventRing> ring() const;
 
-        void setupListeners(int64_t chatId);
+        std::shared_ptr<CallInterface> safeConnection(int64_t chatId) const;
+
+        // Read from the published directory without locking, throws ConnectionNotFound once the call is gone
+        CallSnapshot safeSnapshot(int64_t chatId) const;
+
+        void setupListeners(int64_t chatId, const std::shared_ptr<CallInterface>& call);
+
+        void dispatchEvents(const std::vector<EventDispatcher::Event>& batch);
 
         template<typename DestCallType, typename BaseCallType>
-        static DestCallType* SafeCall(BaseCallType* call);
+        static DestCallType* SafeCall(const std::shared_ptr<BaseCallType>& call);
 
         void remove(int64_t chatId);
 
+        // Without a timeout every call is awaited, with one the stragglers keep closing on the closers
+        void stopConnections(std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> calls, std::optional<std::chrono::milliseconds> timeout) const;
+
     public:
         explicit NTgCalls();
 
@@ -73,6 +105,8 @@ namespace ntgcalls {
 
         ASYNC_RETURN(std::string) createCall(int64_t chatId);
 
+        ASYNC_RETURN(void) createNullCall(int64_t chatId, bool loopback);
+
         ASYNC_RETURN(std::string) initPresentation(int64_t chatId);
 
         ASYNC_RETURN(void) connect(int64_t chatId, const std::string& params, bool isPresentation);
@@ -95,20 +129,76 @@ namespace ntgcalls {
 
         ASYNC_RETURN(void) stopPresentation(int64_t chatId);
 
+        ASYNC_RETURN(void) stopAll(uint32_t timeout);
+
+        void enableFastExit(bool enable);
+
         ASYNC_RETURN(uint64_t) time(int64_t chatId, StreamManager::Mode mode);
 
         ASYNC_RETURN(MediaState) getState(int64_t chatId);
 
         ASYNC_RETURN(wrtc::ConnectionMode) getConnectionMode(int64_t chatId);
 
+        ASYNC_RETURN(wrtc::CallStats) getStats(int64_t chatId, bool cached);
+
+        ASYNC_RETURN(CallLatency) getLatency(int64_t chatId);
+
+        // Sampled at most once per second, so the value can be up to a second old
         ASYNC_RETURN(double) cpuUsage() const;
 
+        std::optional<CallSnapshot> getSnapshot(int64_t chatId) const;
+
+        std::map<int64_t, CallSnapshot> getSnapshots() const;
+
+        ResourceUsage getResourceUsage() const;
+
+        // JSON of getResourceUsage, meant for benchmark logs
+        std::string dumpResourceUsage() const;
+
+        void configureConnectionPool(uint32_t size, uint32_t idleTimeout);
+
+        ConnectionPool::Stats connectionPoolStats() const;
+
+        EventDispatcher::Stats eventQueueStats() const;
+
+        int enableEventPolling(uint32_t capacity);
+
+        // dropped is the number of state updates lost to a full ring since the previous read
+        size_t pollEvents(std::vector<EventDispatcher::Event>& out, size_t max, uint64_t& dropped) const;
+
+        // Returns early with nothing once the instance is being destroyed
+        size_t waitEvents(std::vector<EventDispatcher::Event>& out, size_t max, std::chrono::milliseconds timeout, uint64_t& dropped) const;
+
         static std::string ping();
 
         static MediaDevices getMediaDevices();
 
         static Protocol getProtocol();
 
+        static void setPlayoutThreads(uint32_t threads);
+
+        static PlayoutStats getPlayoutStats();
+
+        static SocketBatchStats getSocketBatchStats();
+
+        // Needs a build with NTG_TRACING, video codecs created before enabling it stay untraced
+        static void enableTracing(bool enable, uint32_t eventsPerThread);
+
+        // Writes the recorded trace points as a Chrome/Perfetto JSON trace
+        static void exportTrace(const std::string& path);
+
+        // Process-wide metrics in the Prometheus text exposition format
+        static std::string exportMetrics();
+
+        static void setSharedSockets(uint32_t socketsPerAddress);
+
+        static void configureCertificatePool(uint32_t size, uint32_t lifetime);
+
+        // Answers a join payload from a local stand-in for the group call servers, for offline tests
+        ASYNC_RETURN(std::string) joinLocalSfu(const std::string& joinPayload);
+
+        ASYNC_RETURN(bool) leaveLocalSfu(uint32_t ssrc);
+
 #ifndef IS_ANDROID
         static void enableGlibLoop(bool enable);
 #endif
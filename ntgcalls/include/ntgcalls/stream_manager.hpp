@@ -11,6 +11,7 @@
 #include <ntgcalls/media/base_sink.hpp>
 #include <ntgcalls/models/media_description.hpp>
 #include <ntgcalls/models/media_state.hpp>
+#include <ntgcalls/utils/atomic_snapshot.hpp>
 #include <wrtc/interfaces/network_interface.hpp>
 
 namespace ntgcalls {
@@ -29,6 +30,7 @@ namespace ntgcalls {
 
         struct CallInfo {
             Status playback, capture;
+            uint64_t suppressedFrames = 0;
         };
 
         enum Mode {
@@ -43,7 +45,19 @@ namespace ntgcalls {
             Screen,
         };
 
-        explicit StreamManager(webrtc::Thread* workerThread);
+        // Published under the lock on every change, the getters read it without taking the lock
+        struct Snapshot {
+            MediaState state{};
+            Status playback = Idling, capture = Idling;
+            // Positions and suppressed frames are atomic counters of the sinks, read live from here
+            std::vector<std::pair<Mode, std::shared_ptr<BaseSink>>> sinks;
+
+            uint64_t time(Mode mode) const;
+
+            uint64_t suppressedFrames() const;
+        };
+
+        StreamManager(webrtc::Thread* workerThread, std::shared_ptr<ResourceAccount> account);
 
         void close();
 
@@ -67,6 +81,13 @@ namespace ntgcalls {
 
         Status status(Mode mode);
 
+        uint64_t suppressedFrames();
+
+        std::shared_ptr<const Snapshot> snapshot() const;
+
+        // Called with every published snapshot, under the stream lock
+        void onPublish(const std::function<void(std::shared_ptr<const Snapshot>)> &callback);
+
         void onStreamEnd(const std::function<void(Type, Device)> &callback);
 
         void onUpgrade(const std::function<void(MediaState)> &callback);
@@ -87,8 +108,9 @@ namespace ntgcalls {
         using StreamId = std::pair<Mode, Device>;
 
         webrtc::Thread* workerThread;
+        std::shared_ptr<ResourceAccount> account;
         bool initialized = false, videoSimulcast = true;
-        std::map<StreamId, std::unique_ptr<BaseSink>> streams;
+        std::map<StreamId, std::shared_ptr<BaseSink>> streams;
         std::map<StreamId, std::unique_ptr<wrtc::MediaTrackInterface>> tracks;
         std::map<Device, std::unique_ptr<BaseReader>> readers;
         std::map<Device, std::unique_ptr<BaseWriter>> writers;
@@ -101,6 +123,8 @@ namespace ntgcalls {
         wrtc::synchronized_callback<Type, Device> onEOF;
         wrtc::synchronized_callback<MediaState> onChangeStatus;
         wrtc::synchronized_callback<Mode, Device, std::vector<wrtc::Frame>> framesCallback;
+        wrtc::synchronized_callback<std::shared_ptr<const Snapshot>> publishCallback;
+        AtomicSnapshot<Snapshot> published;
 
         enum class ReconfigureReason {
             None,
@@ -153,6 +177,11 @@ namespace ntgcalls {
 
         void checkUpgrade();
 
+        // Caller holds the lock
+        void publish();
+
+        MediaState currentState();
+
         bool updateMute(bool isMuted);
 
         bool updatePause(bool isPaused);
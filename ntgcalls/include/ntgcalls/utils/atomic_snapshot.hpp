@@ -0,0 +1,39 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace ntgcalls {
+
+    // Immutable value swapped as a whole, readers get a consistent copy without locking
+    template <typename T>
+    class AtomicSnapshot {
+#ifdef __cpp_lib_atomic_shared_ptr
+        std::atomic<std::shared_ptr<const T>> current;
+#else
+        std::shared_ptr<const T> current;
+#endif
+
+    public:
+        std::shared_ptr<const T> load() const {
+#ifdef __cpp_lib_atomic_shared_ptr
+            return current.load(std::memory_order_acquire);
+#else
+            return std::atomic_load(&current);
+#endif
+        }
+
+        void store(std::shared_ptr<const T> value) {
+#ifdef __cpp_lib_atomic_shared_ptr
+            current.store(std::move(value), std::memory_order_release);
+#else
+            std::atomic_store(&current, std::move(value));
+#endif
+        }
+    };
+
+} // ntgcalls
@@ -0,0 +1,309 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#if !defined(PYTHON_ENABLED) && !IS_ANDROID
+#include <chrono>
+#include <coroutine>
+#include <map>
+#include <optional>
+#include <variant>
+#include <rtc_base/logging.h>
+#include <ntgcalls/exceptions.hpp>
+#include <ntgcalls/utils/binding_utils.hpp>
+
+namespace ntgcalls {
+    using Executor = std::function<void(std::function<void()>)>;
+
+    Executor threadExecutor(webrtc::Thread* thread);
+
+    class CancellationToken {
+        struct State {
+            std::mutex mutex;
+            bool cancelled = false;
+            uint64_t nextId = 1;
+            std::map<uint64_t, std::function<void()>> callbacks;
+        };
+        std::shared_ptr<State> state = std::make_shared<State>();
+
+    public:
+        void cancel() const;
+
+        bool cancelled() const;
+
+        // Runs callback once the token is cancelled, right away if it already is
+        uint64_t subscribe(std::function<void()> callback) const;
+
+        void unsubscribe(uint64_t id) const;
+    };
+
+    struct AwaitOptions {
+        std::optional<std::chrono::milliseconds> timeout;
+        std::optional<CancellationToken> token;
+    };
+
+    namespace detail {
+        void scheduleTimeout(std::chrono::milliseconds delay, std::function<void()> callback);
+
+        template <typename T>
+        struct AwaitState {
+            std::atomic_bool done = false;
+            std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> value;
+            std::exception_ptr error;
+            std::coroutine_handle<> handle;
+            Executor executor;
+            std::mutex mutex;
+            std::function<void()> cleanup;
+
+            template <typename F>
+            void finish(F&& fill) {
+                // First of completion, cancellation and timeout wins
+                if (done.exchange(true)) {
+                    return;
+                }
+                fill();
+                std::function<void()> pendingCleanup;
+                {
+                    std::lock_guard lock(mutex);
+                    pendingCleanup = std::move(cleanup);
+                }
+                if (pendingCleanup) {
+                    pendingCleanup();
+                }
+                executor([h = handle] {
+                    h.resume();
+                });
+            }
+
+            void setCleanup(std::function<void()> callback) {
+                std::unique_lock lock(mutex);
+                if (done) {
+                    lock.unlock();
+                    callback();
+                    return;
+                }
+                cleanup = std::move(callback);
+            }
+
+            void fail(std::exception_ptr e) {
+                finish([&] {
+                    error = std::move(e);
+                });
+            }
+        };
+
+        struct TaskPromiseBase {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr error;
+            bool detached = false;
+
+            struct FinalAwaiter {
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                template <typename P>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept {
+                    auto& promise = handle.promise();
+                    if (promise.continuation) {
+                        return promise.continuation;
+                    }
+                    if (promise.detached) {
+                        if (promise.error) {
+                            try {
+                                std::rethrow_exception(promise.error);
+                            } catch (const std::exception& e) {
+                                RTC_LOG(LS_ERROR) << "Detached task failed: " << e.what();
+                            } catch (...) {
+                                RTC_LOG(LS_ERROR) << "Detached task failed";
+                            }
+                        }
+                        handle.destroy();
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept {
+                return {};
+            }
+
+            void unhandled_exception() {
+                error = std::current_exception();
+            }
+        };
+
+        template <typename T>
+        struct TaskPromise : TaskPromiseBase {
+            std::optional<T> value;
+
+            void return_value(T v) {
+                value = std::move(v);
+            }
+        };
+
+        template <>
+        struct TaskPromise<void> : TaskPromiseBase {
+            void return_void() const {}
+        };
+    } // detail
+
+    // Awaits an AsyncPromise and resumes the awaiting coroutine on executor
+    template <typename T>
+    class Awaitable {
+        AsyncPromise<T> promise;
+        Executor executor;
+        AwaitOptions options;
+        std::shared_ptr<detail::AwaitState<T>> state = std::make_shared<detail::AwaitState<T>>();
+
+    public:
+        Awaitable(AsyncPromise<T> promise, Executor executor, AwaitOptions options = {}):
+            promise(std::move(promise)), executor(std::move(executor)), options(std::move(options)) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            // The coroutine may resume on another thread before this returns, so members are moved out first
+            auto s = state;
+            auto p = std::move(promise);
+            const auto timeout = options.timeout;
+            const auto token = std::move(options.token);
+            s->handle = handle;
+            s->executor = std::move(executor);
+            if (token) {
+                if (token->cancelled()) {
+                    s->fail(std::make_exception_ptr(OperationCancelled("Operation cancelled")));
+                    return;
+                }
+                const auto id = token->subscribe([weak = std::weak_ptr(s)] {
+                    if (const auto strong = weak.lock()) {
+                        strong->fail(std::make_exception_ptr(OperationCancelled("Operation cancelled")));
+                    }
+                });
+                s->setCleanup([token = *token, id] {
+                    token.unsubscribe(id);
+                });
+            }
+            if (timeout) {
+                detail::scheduleTimeout(*timeout, [weak = std::weak_ptr(s)] {
+                    if (const auto strong = weak.lock()) {
+                        strong->fail(std::make_exception_ptr(OperationTimeout("Operation timed out")));
+                    }
+                });
+            }
+            const auto reject = [s](const std::exception_ptr& e) {
+                s->fail(e);
+            };
+            if constexpr (std::is_void_v<T>) {
+                p.then([s] {
+                    s->finish([] {});
+                }, reject);
+            } else {
+                p.then([s](T value) {
+                    s->finish([&] {
+                        s->value = std::move(value);
+                    });
+                }, reject);
+            }
+        }
+
+        T await_resume() {
+            if (state->error) {
+                std::rethrow_exception(state->error);
+            }
+            if constexpr (!std::is_void_v<T>) {
+                return std::move(*state->value);
+            }
+        }
+    };
+
+    template <typename T>
+    Awaitable<T> awaitable(AsyncPromise<T> promise, Executor executor, AwaitOptions options = {}) {
+        return {std::move(promise), std::move(executor), std::move(options)};
+    }
+
+    // Moves the awaiting coroutine onto executor
+    class ResumeOn {
+        Executor executor;
+
+    public:
+        explicit ResumeOn(Executor executor): executor(std::move(executor)) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const {
+            executor([handle] {
+                handle.resume();
+            });
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    // Lazy coroutine, starts when awaited or detached
+    template <typename T = void>
+    class Task {
+    public:
+        struct promise_type : detail::TaskPromise<T> {
+            Task get_return_object() {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+        };
+
+        Task(Task&& other) noexcept: handle(std::exchange(other.handle, {})) {}
+
+        Task(const Task&) = delete;
+
+        ~Task() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(const std::coroutine_handle<> caller) noexcept {
+            handle.promise().continuation = caller;
+            return handle;
+        }
+
+        T await_resume() {
+            auto& promise = handle.promise();
+            if (promise.error) {
+                std::rethrow_exception(promise.error);
+            }
+            if constexpr (!std::is_void_v<T>) {
+                return std::move(*promise.value);
+            }
+        }
+
+        // Starts the task on executor, the frame is freed once it completes
+        void detach(const Executor& executor) && {
+            auto h = std::exchange(handle, {});
+            h.promise().detached = true;
+            executor([h] {
+                h.resume();
+            });
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Task(std::coroutine_handle<promise_type> handle): handle(handle) {}
+    };
+} // ntgcalls
+#endif
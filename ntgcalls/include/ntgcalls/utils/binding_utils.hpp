@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <ntgcalls/utils/worker_pool.hpp>
+
 #define WORKER_NO_LOG(worker, ...) \
 worker->PostTask([__VA_ARGS__] {\
 
@@ -19,6 +21,8 @@ RTC_LOG(LS_VERBOSE) << "Worker finished";\
 END_WORKER_NO_LOG
 
 #ifdef PYTHON_ENABLED
+#include <optional>
+#include <rtc_base/logging.h>
 #include <wrtc/utils/binary.hpp>
 #include <pybind11/pybind11.h>
 // ReSharper disable once CppUnusedIncludeDirective
@@ -53,6 +57,72 @@ py::bytes toBytes(const T& p) {
 
 py::object translate_current_exception();
 
+// Runs callable on worker and returns an asyncio future resolved from the loop thread, no executor thread is parked
+template <typename F>
+py::object asyncFuture(const py::object& loop, webrtc::Thread* worker, F callable) {
+    using R = std::invoke_result_t<F>;
+    auto future = loop.attr("create_future")();
+    // Python references are only touched with the GIL held, so they are kept outside the task's captures
+    auto pending = new std::pair(loop, future);
+    worker->PostTask([pending, callable = std::move(callable)]() mutable {
+        std::conditional_t<std::is_void_v<R>, bool, std::optional<R>> result{};
+        std::exception_ptr error;
+        try {
+            if constexpr (std::is_void_v<R>) {
+                callable();
+            } else {
+                result = callable();
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        py::gil_scoped_acquire acquire;
+        static const auto* resolver = new py::object(py::cpp_function([](const py::object& f, const py::object& value, const bool failed) {
+            if (f.attr("done")().cast<bool>()) {
+                return;
+            }
+            f.attr(failed ? "set_exception" : "set_result")(value);
+        }));
+        py::object value;
+        if (error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (...) {
+                value = translate_current_exception();
+            }
+        } else if constexpr (std::is_void_v<R>) {
+            value = py::none();
+        } else {
+            value = py::cast(std::move(*result));
+            result.reset();
+        }
+        try {
+            pending->first.attr("call_soon_threadsafe")(*resolver, pending->second, value, static_cast<bool>(error));
+        } catch (py::error_already_set& e) {
+            RTC_LOG(LS_WARNING) << "Unable to resolve future: " << e.what();
+        }
+        delete pending;
+    });
+    return future;
+}
+
+// Runs callable on the calling thread and returns an already resolved asyncio future, for lock free getters
+template <typename F>
+py::object readyFuture(const py::object& loop, F callable) {
+    auto future = loop.attr("create_future")();
+    try {
+        if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
+            callable();
+            future.attr("set_result")(py::none());
+        } else {
+            future.attr("set_result")(py::cast(callable()));
+        }
+    } catch (...) {
+        future.attr("set_exception")(translate_current_exception());
+    }
+    return future;
+}
+
 #define THREAD_SAFE { \
 py::gil_scoped_acquire acquire;
 
@@ -66,24 +136,33 @@ py::gil_scoped_acquire acquire;
 
 #define ASYNC_ARGS \
 py::object loop;\
-py::object executor;
+std::unique_ptr<ntgcalls::WorkerPool> asyncWorkers;
 
 #define INIT_ASYNC \
 loop = py::module::import("asyncio").attr("get_event_loop")();\
-executor = py::module::import("concurrent.futures").attr("ThreadPoolExecutor")(std::min(static_cast<uint32_t>(32), std::thread::hardware_concurrency()));
+asyncWorkers = std::make_unique<ntgcalls::WorkerPool>(ntgcalls::WorkerPool::DefaultSize());
 
-#define DESTROY_ASYNC
+#define DESTROY_ASYNC \
+asyncWorkers = nullptr;
 
 #define SMART_ASYNC(...) \
-return loop.attr("run_in_executor")(executor, py::cpp_function([__VA_ARGS__](){\
-py::gil_scoped_release release;
+return asyncFuture(loop, asyncWorkers->next(), [__VA_ARGS__] {
+
+#define STRAND_ASYNC(key, ...) \
+return asyncFuture(loop, asyncWorkers->strand(key), [__VA_ARGS__] {
+
+#define INLINE_ASYNC(...) \
+return readyFuture(loop, [__VA_ARGS__] {
 
-#define END_ASYNC }));
+#define END_ASYNC });
 
 #elif IS_ANDROID
-#define INIT_ASYNC
-#define DESTROY_ASYNC
-#define ASYNC_ARGS
+// Calls run synchronously, the workers only serialize removals and teardown per chat
+#define INIT_ASYNC \
+    asyncWorkers = std::make_unique<ntgcalls::WorkerPool>(ntgcalls::WorkerPool::DefaultSize());
+#define DESTROY_ASYNC \
+    asyncWorkers = nullptr;
+#define ASYNC_ARGS std::unique_ptr<ntgcalls::WorkerPool> asyncWorkers;
 #define THREAD_SAFE {
 #define BYTES(x) x
 #define CPP_BYTES(x, type) x
@@ -91,11 +170,14 @@ py::gil_scoped_release release;
 #define ASYNC_FUNC_ARGS(...)
 #define ASYNC_RETURN(...) __VA_ARGS__
 #define SMART_ASYNC(...)
+#define STRAND_ASYNC(...)
+#define INLINE_ASYNC(...)
 #define END_ASYNC
 #else
 #include <functional>
 #include <rtc_base/thread.h>
 
+// Without a worker the callable runs on the thread calling then
 template <typename T>
 class AsyncPromise {
     webrtc::Thread* worker;
@@ -105,13 +187,18 @@ public:
     AsyncPromise(webrtc::Thread* worker, std::function<T()> callable): worker(worker), callable(std::move(callable)) {}
 
     void then(const std::function<void(T)>& resolve, const std::function<void(const std::exception_ptr&)>& reject) {
-        worker->PostTask([this, resolve, reject, callable = callable]{
+        auto task = [resolve, reject, callable = callable]{
             try {
                 resolve(callable());
             } catch (const std::exception&) {
                 reject(std::current_exception());
             }
-        });
+        };
+        if (!worker) {
+            task();
+            return;
+        }
+        worker->PostTask(std::move(task));
     }
 };
 
@@ -123,26 +210,29 @@ public:
     AsyncPromise(webrtc::Thread* worker, std::function<void()> callable): worker(worker), callable(std::move(callable)) {};
 
     void then(const std::function<void()>& resolve, const std::function<void(const std::exception_ptr&)>& reject) const{
-        worker->PostTask([this, resolve, reject, callable = callable]{
+        auto task = [resolve, reject, callable = callable]{
             try {
                 callable();
                 resolve();
             } catch (const std::exception&) {
                 reject(std::current_exception());
             }
-        });
+        };
+        if (!worker) {
+            task();
+            return;
+        }
+        worker->PostTask(std::move(task));
     }
 };
 
 #define INIT_ASYNC \
-    asyncWorker = webrtc::Thread::Create();\
-    asyncWorker->Start();
+    asyncWorkers = std::make_unique<ntgcalls::WorkerPool>(ntgcalls::WorkerPool::DefaultSize());
 
 #define DESTROY_ASYNC \
-    asyncWorker->Stop();\
-    asyncWorker = nullptr;
+    asyncWorkers = nullptr;
 
-#define ASYNC_ARGS std::unique_ptr<webrtc::Thread> asyncWorker;
+#define ASYNC_ARGS std::unique_ptr<ntgcalls::WorkerPool> asyncWorkers;
 
 #define THREAD_SAFE {
 
@@ -157,7 +247,13 @@ public:
 #define ASYNC_RETURN(...) AsyncPromise<__VA_ARGS__>
 
 #define SMART_ASYNC(...) \
-return { asyncWorker.get(), [__VA_ARGS__]{
+return { asyncWorkers->next(), [__VA_ARGS__]{
+
+#define STRAND_ASYNC(key, ...) \
+return { asyncWorkers->strand(key), [__VA_ARGS__]{
+
+#define INLINE_ASYNC(...) \
+return { nullptr, [__VA_ARGS__]{
 
 #define END_ASYNC }};
 
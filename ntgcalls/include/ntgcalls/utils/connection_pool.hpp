@@ -0,0 +1,61 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <rtc_base/thread.h>
+#include <wrtc/interfaces/group_connection.hpp>
+
+namespace ntgcalls {
+
+    // Opt-in stock of opened group connections (transport, certificate and port allocator ready) claimed by createCall
+    class ConnectionPool {
+    public:
+        struct Stats {
+            uint32_t ready;
+            uint64_t hits;
+            uint64_t misses;
+        };
+
+        ConnectionPool();
+
+        ~ConnectionPool();
+
+        // A zero idle timeout keeps connections until they are claimed
+        void configure(uint32_t size, std::chrono::seconds idleTimeout);
+
+        std::shared_ptr<wrtc::GroupConnection> claim();
+
+        Stats stats();
+
+    private:
+        struct Entry {
+            std::shared_ptr<wrtc::GroupConnection> connection;
+            std::chrono::steady_clock::time_point createdAt;
+        };
+
+        std::mutex mutex;
+        std::deque<Entry> ready;
+        uint32_t targetSize = 0;
+        std::chrono::seconds idleTimeout = std::chrono::minutes(5);
+        bool refilling = false, expiryScheduled = false;
+        std::unique_ptr<webrtc::Thread> thread;
+        std::atomic_uint64_t hits = 0, misses = 0;
+
+        std::vector<std::shared_ptr<wrtc::GroupConnection>> takeExpired();
+
+        void scheduleRefill();
+
+        void scheduleExpiry();
+
+        void refill();
+
+        static void closeAll(const std::vector<std::shared_ptr<wrtc::GroupConnection>>& connections);
+    };
+
+} // ntgcalls
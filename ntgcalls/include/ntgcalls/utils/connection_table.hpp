@@ -0,0 +1,45 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <array>
+#include <shared_mutex>
+#include <unordered_map>
+#include <ntgcalls/instances/call_interface.hpp>
+
+namespace ntgcalls {
+
+    // Calls by chat id, split in shards so lookups for unrelated chats never contend on the same lock
+    class ConnectionTable {
+        static constexpr size_t kShards = 16;
+
+        struct Shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<int64_t, std::shared_ptr<CallInterface>> calls;
+        };
+
+        std::array<Shard, kShards> shards;
+
+        static size_t indexOf(int64_t chatId);
+
+        Shard& shardOf(int64_t chatId);
+
+        const Shard& shardOf(int64_t chatId) const;
+
+    public:
+        bool contains(int64_t chatId) const;
+
+        std::shared_ptr<CallInterface> find(int64_t chatId) const;
+
+        bool insert(int64_t chatId, std::shared_ptr<CallInterface> call);
+
+        std::shared_ptr<CallInterface> extract(int64_t chatId);
+
+        std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> clear();
+
+        std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> snapshot() const;
+    };
+
+} // ntgcalls
@@ -0,0 +1,117 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <variant>
+#include <rtc_base/thread.h>
+#include <ntgcalls/stream_manager.hpp>
+#include <ntgcalls/models/call_network_state.hpp>
+#include <ntgcalls/models/media_state.hpp>
+#include <ntgcalls/models/remote_source_state.hpp>
+#include <wrtc/models/segment_part_request.hpp>
+#include <wrtc/utils/binary.hpp>
+
+namespace ntgcalls {
+
+    // Queues call events in a ring and hands them over in batches, one task per wakeup of the update thread.
+    // Latest-state events replace their queued predecessor at the tail and are the only ones ever dropped,
+    // the ring grows instead of losing any other event
+    class EventDispatcher {
+    public:
+        struct StreamEnd {
+            StreamManager::Type type;
+            StreamManager::Device device;
+        };
+
+        struct Upgrade {
+            MediaState state;
+        };
+
+        struct ConnectionChange {
+            NetworkInfo info;
+        };
+
+        struct SignalingData {
+            bytes::binary data;
+        };
+
+        struct RemoteSourceChange {
+            RemoteSource source;
+        };
+
+        struct BroadcastPart {
+            wrtc::SegmentPartRequest request;
+        };
+
+        struct BroadcastTimestamp {};
+
+        using Payload = std::variant<StreamEnd, Upgrade, ConnectionChange, SignalingData, RemoteSourceChange, BroadcastPart, BroadcastTimestamp>;
+
+        struct Event {
+            int64_t chatId;
+            Payload payload;
+        };
+
+        struct Stats {
+            uint32_t depth;
+            uint32_t maxDepth;
+            uint64_t batches;
+            uint64_t delivered;
+            uint64_t coalesced;
+            uint64_t dropped;
+        };
+
+        EventDispatcher(webrtc::Thread* thread, std::function<void(const std::vector<Event>&)> deliver);
+
+        ~EventDispatcher();
+
+        void push(int64_t chatId, Payload payload);
+
+        // maxDepth is the peak since the previous call
+        Stats stats();
+
+        // Events only carrying the latest state of something, the only ones that may be coalesced or dropped
+        static bool IsLatestState(const Payload& payload);
+
+    private:
+        using Key = std::tuple<size_t, int64_t, int64_t>;
+
+        struct IndexSlot {
+            Key key;
+            size_t position = 0;
+            uint64_t generation = 0;
+        };
+
+        // A power of two, the ring only ever doubles
+        static constexpr size_t kCapacity = 4096;
+
+        webrtc::Thread* thread;
+        std::function<void(const std::vector<Event>&)> deliver;
+        std::mutex mutex;
+        // Replaced events are left empty in place until the next flush or rebuild
+        std::vector<std::optional<Event>> ring;
+        std::vector<Event> batch;
+        size_t head = 0, count = 0, stale = 0;
+        // Twice the ring size so open addressing stays at most half full.
+        // Slots of an older generation are empty, so a flush clears the index in O(1)
+        std::vector<IndexSlot> index;
+        uint64_t generation = 1;
+        bool flushScheduled = false, overflowLogged = false;
+        uint32_t maxDepth = 0;
+        uint64_t batches = 0, delivered = 0, coalesced = 0, dropped = 0;
+
+        static std::optional<Key> coalescingKey(int64_t chatId, const Payload& payload);
+
+        IndexSlot& findSlot(const Key& key);
+
+        // Moves the live events to the front of a ring of the given capacity and indexes them again
+        void rebuild(size_t capacity);
+
+        void flush();
+    };
+
+} // ntgcalls
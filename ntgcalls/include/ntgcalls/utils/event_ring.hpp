@@ -0,0 +1,45 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <ntgcalls/utils/event_dispatcher.hpp>
+
+namespace ntgcalls {
+
+    // Queue of events drained by the host on its own threads, with an eventfd to plug into epoll.
+    // Past its capacity latest-state events are dropped and counted for the next read, every other event grows it
+    class EventRing {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<EventDispatcher::Event> slots;
+        size_t capacity, head = 0, count = 0;
+        uint64_t dropped = 0;
+        bool closed = false;
+        int eventFd = -1;
+
+        size_t drain(std::vector<EventDispatcher::Event>& out, size_t max, uint64_t& lost);
+
+        void wakeup();
+
+    public:
+        explicit EventRing(size_t capacity);
+
+        ~EventRing();
+
+        void push(const std::vector<EventDispatcher::Event>& batch);
+
+        // lost is set to the state updates dropped since the previous read, get the snapshot again when it is not zero
+        size_t poll(std::vector<EventDispatcher::Event>& out, size_t max, uint64_t& lost);
+
+        size_t wait(std::vector<EventDispatcher::Event>& out, size_t max, std::chrono::milliseconds timeout, uint64_t& lost);
+
+        // Wakes every waiter and the eventfd, later pushes are ignored and reads return nothing
+        void close();
+
+        int fd() const;
+    };
+
+} // ntgcalls
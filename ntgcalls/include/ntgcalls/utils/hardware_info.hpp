@@ -2,7 +2,9 @@
 // Created by Laky64 on 02/03/2024.
 //
 # pragma once
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 
 #ifdef IS_WINDOWS
 #include <windows.h>
@@ -22,11 +24,17 @@ namespace ntgcalls {
 #else
         clock_t lastCPU, lastSysCPU, lastUserCPU;
 #endif
+        std::mutex sampleMutex;
+        std::atomic<double> sampledUsage = 0;
+        std::atomic_int64_t sampledAt = 0;
     public:
         HardwareInfo();
 
         double getCpuUsage();
 
+        // Samples again only when the last sample is a second old, concurrent callers get the previous value
+        double getSampledCpuUsage();
+
         [[nodiscard]] uint16_t getCoreCount() const;
     };
 
@@ -0,0 +1,38 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <ntgcalls/models/call_latency.hpp>
+
+namespace ntgcalls {
+
+    // Lock-free HDR-style histogram, buckets are linear within each power of two
+    class LatencyHistogram {
+    public:
+        // Values past about 71 minutes are clamped
+        static constexpr int64_t kMaxValue = (int64_t{1} << 32) - 1;
+
+        void record(int64_t value);
+
+        // Concurrent records may land between buckets being read, the result stays consistent with itself
+        LatencySummary summary() const;
+
+    private:
+        static constexpr int kSubBucketBits = 5;
+        static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+        static constexpr size_t kBuckets = kSubBuckets * (33 - kSubBucketBits);
+
+        std::array<std::atomic_uint64_t, kBuckets> counts{};
+        std::atomic_uint64_t sum = 0;
+        std::atomic_int64_t minValue = kMaxValue, maxValue = 0;
+
+        static size_t index(uint64_t value);
+
+        static int64_t highestEquivalent(size_t index);
+    };
+
+} // ntgcalls
@@ -0,0 +1,79 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <ntgcalls/models/resource_usage.hpp>
+#include <ntgcalls/utils/latency_histogram.hpp>
+#include <ntgcalls/utils/send_latency_matcher.hpp>
+
+namespace ntgcalls {
+
+    // CPU time, buffered bytes and frame latency of the library on behalf of a single call
+    class ResourceAccount {
+    public:
+        enum class Work {
+            Reader,
+            Mixer,
+            Encoder,
+            Decoder,
+        };
+
+        enum class Path {
+            AudioSend,
+            VideoSend,
+            AudioReceive,
+            VideoReceive,
+        };
+
+        // Charges the CPU time the current thread spends inside the scope, no-op without an account
+        class Scope {
+            ResourceAccount* account;
+            Work work;
+            int64_t start = 0;
+
+        public:
+            Scope(const std::shared_ptr<ResourceAccount>& account, Work work);
+
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        void addBuffered(int64_t bytes);
+
+        uint64_t cpuTime(Work work) const;
+
+        int64_t bufferedBytes() const;
+
+        void addLatency(Path path, int64_t micros);
+
+        // Start of a send path, the latency is recorded by sendFinished once the frame leaves the socket
+        void sendStarted(Path path, int64_t captureMs, int64_t producedAtUs);
+
+        void sendFinished(Path path, int64_t mediaTimeMs, int64_t sentAtUs);
+
+        CallLatency latency() const;
+
+        // Nanoseconds of CPU the calling thread used so far
+        static int64_t ThreadCpuTime();
+
+        // Every thread of the process, empty where the platform does not expose them
+        static std::vector<ThreadResourceUsage> Threads();
+
+        static uint64_t ResidentBytes();
+
+    private:
+        std::array<std::atomic_uint64_t, 4> cpu{};
+        std::atomic_int64_t buffered = 0;
+        std::array<LatencyHistogram, 4> latencies;
+        std::array<SendLatencyMatcher, 2> sendMatchers;
+    };
+
+} // ntgcalls
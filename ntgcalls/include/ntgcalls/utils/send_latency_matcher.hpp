@@ -0,0 +1,45 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace ntgcalls {
+
+    // Pairs frames handed to WebRTC with the first packet carrying them out of the socket.
+    // Frames lose their identity in the encoder, so sent frames are matched by media time:
+    // the RTP clock advances between two sent frames as much as their capture times did
+    class SendLatencyMatcher {
+    public:
+        // Hand-offs kept while nothing is sent, the oldest are dropped past this
+        static constexpr size_t kMaxPending = 128;
+        // Further than this from the expected capture time and the stream is anchored again
+        static constexpr int64_t kMaxDriftMs = 50;
+
+        void handOff(int64_t captureMs, int64_t producedAtUs);
+
+        // Microseconds from production to the socket, empty when no pending frame matches
+        std::optional<int64_t> sent(int64_t mediaTimeMs, int64_t sentAtUs);
+
+    private:
+        struct Pending {
+            int64_t captureMs;
+            int64_t producedAtUs;
+        };
+
+        struct Anchor {
+            int64_t captureMs;
+            int64_t mediaTimeMs;
+        };
+
+        std::mutex mutex;
+        std::deque<Pending> pending;
+        std::optional<Anchor> anchor;
+    };
+
+} // ntgcalls
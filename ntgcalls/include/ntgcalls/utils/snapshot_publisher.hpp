@@ -0,0 +1,39 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <ntgcalls/instances/call_interface.hpp>
+#include <ntgcalls/utils/atomic_snapshot.hpp>
+
+namespace ntgcalls {
+
+    // Calls by chat id for the getters, copied and swapped in on create and remove so readers never lock nor hop threads.
+    // The state of each call is published by the call itself whenever it changes, see CallInterface::snapshot
+    class SnapshotPublisher {
+    public:
+        using Table = std::unordered_map<int64_t, std::shared_ptr<CallInterface>>;
+
+        SnapshotPublisher();
+
+        std::shared_ptr<const Table> load() const;
+
+        std::shared_ptr<CallInterface> find(int64_t chatId) const;
+
+        void add(int64_t chatId, std::shared_ptr<CallInterface> call);
+
+        // Only drops entries still holding these calls, a call created again meanwhile stays
+        void remove(const std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>>& calls);
+
+    private:
+        // Serializes writers only, each one copies the current table
+        std::mutex mutex;
+        AtomicSnapshot<Table> current;
+    };
+
+} // ntgcalls
@@ -0,0 +1,37 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <rtc_base/thread.h>
+
+namespace ntgcalls {
+
+    // Fixed set of workers, tasks sharing a key always land on the same one so they keep their order
+    class WorkerPool {
+        std::vector<std::unique_ptr<webrtc::Thread>> workers;
+        std::atomic_size_t nextWorker = 0;
+
+    public:
+        explicit WorkerPool(size_t size, const std::string& name = "ntg-async");
+
+        ~WorkerPool();
+
+        webrtc::Thread* strand(int64_t key) const;
+
+        webrtc::Thread* next();
+
+        // Returns once every task posted before the call has run
+        void drain() const;
+
+        size_t size() const;
+
+        static size_t DefaultSize();
+
+        static size_t StrandIndex(int64_t key, size_t size);
+    };
+
+} // ntgcalls
@@ -127,6 +127,18 @@ ntgcalls::BaseMediaDescription::MediaSource parseMediaSource(const ntg_media_sou
     }
 }
 
+ntgcalls::VideoDescription::PixelFormat parsePixelFormat(const ntg_pixel_format_enum format) {
+    switch (format) {
+        case NTG_PIXEL_FORMAT_NV12:
+            return ntgcalls::VideoDescription::PixelFormat::NV12;
+        case NTG_PIXEL_FORMAT_RGBA:
+            return ntgcalls::VideoDescription::PixelFormat::RGBA;
+        case NTG_PIXEL_FORMAT_I420:
+        default:
+            return ntgcalls::VideoDescription::PixelFormat::I420;
+    }
+}
+
 ntg_media_state_struct parseCMediaState(const ntgcalls::MediaState state) {
     return ntg_media_state_struct{
         state.muted,
@@ -274,6 +286,8 @@ ntgcalls::VideoDescription parseVideoDescription(const ntg_video_description_str
             desc.fps,
             std::string(desc.input),
             desc.keepOpen,
+            parsePixelFormat(desc.pixelFormat),
+            desc.staticRefreshMs,
         };
     }
     throw ntgcalls::FFmpegError("Not supported");
@@ -552,6 +566,81 @@ int ntg_get_protocol(ntg_protocol_struct* buffer) {
     return 0;
 }
 
+int ntg_set_playout_threads(const uint32_t threads) {
+    ntgcalls::NTgCalls::setPlayoutThreads(threads);
+    return 0;
+}
+
+int ntg_get_playout_stats(ntg_playout_stats_struct* buffer) {
+    const auto [threads, ticks, lateTicks] = ntgcalls::NTgCalls::getPlayoutStats();
+    buffer->threads = threads;
+    buffer->ticks = ticks;
+    buffer->lateTicks = lateTicks;
+    return 0;
+}
+
+int ntg_get_socket_batch_stats(ntg_socket_batch_stats_struct* buffer) {
+    const auto stats = ntgcalls::NTgCalls::getSocketBatchStats();
+    buffer->readWakeups = stats.readWakeups;
+    buffer->packetsReceived = stats.packetsReceived;
+    buffer->maxReadBatch = stats.maxReadBatch;
+    buffer->sendFlushes = stats.sendFlushes;
+    buffer->packetsSent = stats.packetsSent;
+    buffer->maxSendBatch = stats.maxSendBatch;
+    buffer->gsoSends = stats.gsoSends;
+    buffer->sharedSockets = stats.sharedSockets;
+    buffer->sharedHandles = stats.sharedHandles;
+    buffer->overflowSockets = stats.overflowSockets;
+    buffer->unroutedPackets = stats.unroutedPackets;
+    return 0;
+}
+
+int ntg_set_shared_sockets(const uint32_t socketsPerAddress) {
+    ntgcalls::NTgCalls::setSharedSockets(socketsPerAddress);
+    return 0;
+}
+
+int ntg_enable_tracing(const bool enable, const uint32_t eventsPerThread) {
+    ntgcalls::NTgCalls::enableTracing(enable, eventsPerThread);
+    return 0;
+}
+
+int ntg_export_trace(char* path) {
+    try {
+        ntgcalls::NTgCalls::exportTrace(std::string(path));
+    } catch (ntgcalls::FileError&) {
+        return NTG_ERROR_FILE;
+    }
+    return 0;
+}
+
+int ntg_export_metrics(char** buffer) {
+    return copyAndReturn(ntgcalls::NTgCalls::exportMetrics(), buffer);
+}
+
+int ntg_configure_certificate_pool(const uint32_t size, const uint32_t lifetime) {
+    ntgcalls::NTgCalls::configureCertificatePool(size, lifetime);
+    return 0;
+}
+
+int ntg_join_local_sfu(const uintptr_t ptr, char* joinPayload, char** buffer, ntg_async_struct future) {
+    PREPARE_ASYNC(joinLocalSfu, std::string(joinPayload))
+    [future, buffer](const std::string& s) {
+        *future.errorCode = copyAndReturn(s, buffer);
+        future.promise(future.userData);
+    }
+    PREPARE_ASYNC_END
+}
+
+int ntg_leave_local_sfu(const uintptr_t ptr, const uint32_t ssrc, ntg_async_struct future) {
+    PREPARE_ASYNC(leaveLocalSfu, ssrc)
+    [future](const bool success) {
+        *future.errorCode = !success;
+        future.promise(future.userData);
+    }
+    PREPARE_ASYNC_END
+}
+
 int ntg_create(const uintptr_t ptr, const int64_t chatID, char** buffer, ntg_async_struct future) {
     PREPARE_ASYNC(createCall, chatID)
     [future, buffer](const std::string& s) {
@@ -561,6 +650,15 @@ int ntg_create(const uintptr_t ptr, const int64_t chatID, char** buffer, ntg_asy
     PREPARE_ASYNC_END
 }
 
+int ntg_create_null(const uintptr_t ptr, const int64_t chatID, const bool loopback, ntg_async_struct future) {
+    PREPARE_ASYNC(createNullCall, chatID, loopback)
+    [future] {
+        *future.errorCode = 0;
+        future.promise(future.userData);
+    }
+    PREPARE_ASYNC_END
+}
+
 int ntg_connect(const uintptr_t ptr, const int64_t chatID, char* params, const bool isPresentation, ntg_async_struct future) {
     PREPARE_ASYNC(connect, chatID, std::string(params), isPresentation)
     [future] {
@@ -655,6 +753,67 @@ int ntg_get_connection_mode(const uintptr_t ptr, const int64_t chatID, ntg_conne
     PREPARE_ASYNC_END
 }
 
+int ntg_get_stats(const uintptr_t ptr, const int64_t chatID, const bool cached, ntg_call_stats_struct* buffer, ntg_async_struct future) {
+    PREPARE_ASYNC(getStats, chatID, cached)
+    [future, buffer](const wrtc::CallStats& stats) {
+        std::vector<ntg_rtp_stream_stats_struct> cStreams;
+        cStreams.reserve(stats.streams.size());
+        for (const auto& stream : stats.streams) {
+            cStreams.push_back(ntg_rtp_stream_stats_struct{
+                stream.ssrc,
+                stream.outgoing,
+                stream.video,
+                stream.bytes,
+                stream.packets,
+                stream.packetsLost,
+                stream.fractionLost,
+                stream.jitterMs,
+                stream.nacks,
+                stream.plis,
+                stream.bitrate,
+                stream.frameTimeMs,
+                stream.jitterBufferDelayMs
+            });
+        }
+        buffer->timestamp = stats.timestamp;
+        buffer->rttMs = stats.rttMs;
+        buffer->sendBandwidth = stats.sendBandwidth;
+        buffer->receiveBandwidth = stats.receiveBandwidth;
+        buffer->pacerDelayMs = stats.pacerDelayMs;
+        buffer->transportBytesSent = stats.transportBytesSent;
+        buffer->transportBytesReceived = stats.transportBytesReceived;
+        copyAndReturn(cStreams, &buffer->streams, &buffer->sizeStreams);
+        *future.errorCode = 0;
+        future.promise(future.userData);
+    }
+    PREPARE_ASYNC_END
+}
+
+int ntg_get_latency(const uintptr_t ptr, const int64_t chatID, ntg_call_latency_struct* buffer, ntg_async_struct future) {
+    PREPARE_ASYNC(getLatency, chatID)
+    [future, buffer](const ntgcalls::CallLatency& latency) {
+        const auto parse = [](const ntgcalls::LatencySummary& summary) {
+            return ntg_latency_summary_struct{
+                summary.count,
+                summary.min,
+                summary.mean,
+                summary.max,
+                summary.p50,
+                summary.p90,
+                summary.p99,
+                summary.p999
+            };
+        };
+        buffer->audioSend = parse(latency.audioSend);
+        buffer->videoSend = parse(latency.videoSend);
+        buffer->audioReceive = parse(latency.audioReceive);
+        buffer->videoReceive = parse(latency.videoReceive);
+        *future.errorCode = 0;
+        future.promise(future.userData);
+    }
+    PREPARE_ASYNC_END
+}
+
 int ntg_send_external_frame(const uintptr_t ptr, const int64_t chatID, const ntg_stream_device_enum device, uint8_t* frame, const int frameSize, const ntg_frame_data_struct frameData, ntg_async_struct future) {
     PREPARE_ASYNC(sendExternalFrame, chatID, parseStreamDevice(device), bytes::binary(frame, frame + frameSize), parseFrameData(frameData))
     [future] {
@@ -708,7 +867,8 @@ int ntg_calls(const uintptr_t ptr, ntg_call_info_struct** buffer, int* size, ntg
             groupCalls.push_back(ntg_call_info_struct{
                 chatId,
                 parseCStatus(status.capture),
-                parseCStatus(status.playback)
+                parseCStatus(status.playback),
+                status.suppressedFrames
             });
         }
         copyAndReturn(groupCalls, buffer, size);
@@ -746,6 +906,236 @@ int ntg_enable_g_lib_loop(const bool enable) {
     return 0;
 }
 
+int ntg_stop_all(const uintptr_t ptr, const uint32_t timeout, ntg_async_struct future) {
+    PREPARE_ASYNC(stopAll, timeout)
+    [future] {
+        *future.errorCode = 0;
+        future.promise(future.userData);
+    }
+    PREPARE_ASYNC_END
+}
+
+int ntg_enable_fast_exit(const uintptr_t ptr, const bool enable) {
+    try {
+        getInstance(ptr)->enableFastExit(enable);
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    return 0;
+}
+
+int ntg_configure_connection_pool(const uintptr_t ptr, const uint32_t size, const uint32_t idleTimeout) {
+    try {
+        getInstance(ptr)->configureConnectionPool(size, idleTimeout);
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    return 0;
+}
+
+int ntg_get_connection_pool_stats(const uintptr_t ptr, ntg_connection_pool_stats_struct* buffer) {
+    try {
+        const auto [ready, hits, misses] = getInstance(ptr)->connectionPoolStats();
+        buffer->ready = ready;
+        buffer->hits = hits;
+        buffer->misses = misses;
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    return 0;
+}
+
+int ntg_get_event_queue_stats(const uintptr_t ptr, ntg_event_queue_stats_struct* buffer) {
+    try {
+        const auto [depth, maxDepth, batches, delivered, coalesced, dropped] = getInstance(ptr)->eventQueueStats();
+        buffer->depth = depth;
+        buffer->maxDepth = maxDepth;
+        buffer->batches = batches;
+        buffer->delivered = delivered;
+        buffer->coalesced = coalesced;
+        buffer->dropped = dropped;
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    return 0;
+}
+
+ntg_call_snapshot_struct parseCSnapshot(const int64_t chatId, const ntgcalls::CallSnapshot& snapshot) {
+    return ntg_call_snapshot_struct{
+        chatId,
+        parseCMediaState(snapshot.state),
+        parseCStatus(snapshot.playback),
+        parseCStatus(snapshot.capture),
+        snapshot.playbackTime,
+        snapshot.captureTime,
+        snapshot.suppressedFrames,
+        parseCConnectionMode(snapshot.connectionMode)
+    };
+}
+
+int ntg_get_snapshot(const uintptr_t ptr, const int64_t chatID, ntg_call_snapshot_struct* buffer) {
+    try {
+        const auto snapshot = getInstance(ptr)->getSnapshot(chatID);
+        if (!snapshot) {
+            return NTG_ERROR_CONNECTION_NOT_FOUND;
+        }
+        *buffer = parseCSnapshot(chatID, *snapshot);
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    return 0;
+}
+
+int ntg_get_snapshots(const uintptr_t ptr, ntg_call_snapshot_struct** buffer, int* size) {
+    try {
+        const auto snapshots = getInstance(ptr)->getSnapshots();
+        std::vector<ntg_call_snapshot_struct> cSnapshots;
+        cSnapshots.reserve(snapshots.size());
+        for (const auto& [chatId, snapshot] : snapshots) {
+            cSnapshots.push_back(parseCSnapshot(chatId, snapshot));
+        }
+        copyAndReturn(cSnapshots, buffer, size);
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    return 0;
+}
+
+int ntg_get_resource_usage(const uintptr_t ptr, ntg_resource_usage_struct* buffer) {
+    try {
+        const auto [residentBytes, threads, calls] = getInstance(ptr)->getResourceUsage();
+        std::vector<ntg_thread_resource_usage_struct> cThreads;
+        cThreads.reserve(threads.size());
+        for (const auto& [threadId, name, cpuTime] : threads) {
+            ntg_thread_resource_usage_struct cThread{};
+            cThread.threadId = threadId;
+            // Linux thread names are at most 15 characters, longer ones elsewhere get truncated
+            name.copy(cThread.name, sizeof(cThread.name) - 1);
+            cThread.cpuTime = cpuTime;
+            cThreads.push_back(cThread);
+        }
+        std::vector<ntg_call_resource_usage_struct> cCalls;
+        cCalls.reserve(calls.size());
+        for (const auto& call : calls) {
+            cCalls.push_back(ntg_call_resource_usage_struct{
+                call.chatId,
+                call.readerCpuTime,
+                call.mixerCpuTime,
+                call.encoderCpuTime,
+                call.decoderCpuTime,
+                call.bufferedBytes
+            });
+        }
+        buffer->residentBytes = residentBytes;
+        copyAndReturn(cThreads, &buffer->threads, &buffer->sizeThreads);
+        copyAndReturn(cCalls, &buffer->calls, &buffer->sizeCalls);
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    return 0;
+}
+
+int ntg_dump_resource_usage(const uintptr_t ptr, char** buffer) {
+    try {
+        return copyAndReturn(getInstance(ptr)->dumpResourceUsage(), buffer);
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+}
+
+ntg_event_struct parseCEvent(const ntgcalls::EventDispatcher::Event& event) {
+    ntg_event_struct cEvent{};
+    cEvent.chatId = event.chatId;
+    std::visit([&]<typename T>(const T& payload) {
+        if constexpr (std::is_same_v<T, ntgcalls::EventDispatcher::StreamEnd>) {
+            cEvent.kind = NTG_EVENT_STREAM_END;
+            cEvent.streamType = parseCStreamType(payload.type);
+            cEvent.device = parseCStreamDevice(payload.device);
+        } else if constexpr (std::is_same_v<T, ntgcalls::EventDispatcher::Upgrade>) {
+            cEvent.kind = NTG_EVENT_UPGRADE;
+            cEvent.mediaState = parseCMediaState(payload.state);
+        } else if constexpr (std::is_same_v<T, ntgcalls::EventDispatcher::ConnectionChange>) {
+            cEvent.kind = NTG_EVENT_CONNECTION_CHANGE;
+            cEvent.networkInfo = parseCNetworkInfo(payload.info);
+        } else if constexpr (std::is_same_v<T, ntgcalls::EventDispatcher::SignalingData>) {
+            cEvent.kind = NTG_EVENT_SIGNALING_DATA;
+            copyAndReturn(payload.data, &cEvent.data, &cEvent.sizeData);
+        } else if constexpr (std::is_same_v<T, ntgcalls::EventDispatcher::RemoteSourceChange>) {
+            cEvent.kind = NTG_EVENT_REMOTE_SOURCE_CHANGE;
+            cEvent.remoteSource = {
+                payload.source.ssrc,
+                parseCStatus(payload.source.state),
+                parseCStreamDevice(payload.source.device),
+            };
+        } else if constexpr (std::is_same_v<T, ntgcalls::EventDispatcher::BroadcastPart>) {
+            cEvent.kind = NTG_EVENT_REQUEST_BROADCAST_PART;
+            cEvent.partRequest = {
+                payload.request.segmentId,
+                payload.request.partId,
+                payload.request.limit,
+                payload.request.timestamp,
+                payload.request.qualityUpdate,
+                payload.request.channelId,
+                parseCSegmentQuality(payload.request.quality)
+            };
+        } else {
+            cEvent.kind = NTG_EVENT_REQUEST_BROADCAST_TIMESTAMP;
+        }
+    }, event.payload);
+    return cEvent;
+}
+
+int ntg_enable_event_polling(const uintptr_t ptr, const uint32_t capacity, int* fd) {
+    try {
+        const auto eventFd = getInstance(ptr)->enableEventPolling(capacity);
+        if (fd) {
+            *fd = eventFd;
+        }
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    } catch (ntgcalls::InvalidParams&) {
+        return NTG_ERROR_INVALID_PARAMS;
+    }
+    return 0;
+}
+
+int ntg_poll_events(const uintptr_t ptr, ntg_event_struct* buffer, const int size, int* count, uint64_t* dropped) {
+    return ntg_wait_events(ptr, buffer, size, count, dropped, 0);
+}
+
+int ntg_wait_events(const uintptr_t ptr, ntg_event_struct* buffer, const int size, int* count, uint64_t* dropped, const uint32_t timeout) {
+    if (!buffer || !count) {
+        return NTG_ERROR_NULL_POINTER;
+    }
+    if (size <= 0) {
+        return NTG_ERROR_INVALID_PARAMS;
+    }
+    thread_local std::vector<ntgcalls::EventDispatcher::Event> events;
+    uint64_t lost = 0;
+    try {
+        const auto instance = getInstance(ptr);
+        events.clear();
+        if (timeout == 0) {
+            instance->pollEvents(events, size, lost);
+        } else {
+            instance->waitEvents(events, size, std::chrono::milliseconds(timeout), lost);
+        }
+    } catch (ntgcalls::NullPointer&) {
+        return NTG_ERROR_NULL_POINTER;
+    } catch (ntgcalls::InvalidParams&) {
+        return NTG_ERROR_INVALID_PARAMS;
+    }
+    for (size_t i = 0; i < events.size(); i++) {
+        buffer[i] = parseCEvent(events[i]);
+    }
+    *count = static_cast<int>(events.size());
+    if (dropped) {
+        *dropped = lost;
+    }
+    events.clear();
+    return 0;
+}
+
 int ntg_on_stream_end(const uintptr_t ptr, ntg_stream_callback callback, void* userData) {
     try {
         getInstance(ptr)->onStreamEnd([ptr, callback, userData](const int64_t chatId, const ntgcalls::StreamManager::Type type, const ntgcalls::StreamManager::Device device) {
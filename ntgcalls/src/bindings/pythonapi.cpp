@@ -7,9 +7,22 @@
 
 #include <ntgcalls/ntgcalls.hpp>
 #include <ntgcalls/exceptions.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace py = pybind11;
 
+py::object translate_current_exception() {
+    // Let the registered translators build the Python exception, as if it was raised by a bound method
+    try {
+        py::cpp_function([error = std::current_exception()] {
+            std::rethrow_exception(error);
+        })();
+    } catch (py::error_already_set& e) {
+        return e.value();
+    }
+    return py::none();
+}
+
 PYBIND11_MODULE(ntgcalls, m) {
     py::class_<ntgcalls::NTgCalls> wrapper(m, "NTgCalls");
     wrapper.def(py::init<>());
@@ -20,6 +33,7 @@ PYBIND11_MODULE(ntgcalls, m) {
     wrapper.def("connect_p2p", &ntgcalls::NTgCalls::connectP2P, py::arg("user_id"), py::arg("servers"), py::arg("versions"), py::arg("p2p_allowed"));
     wrapper.def("send_signaling", &ntgcalls::NTgCalls::sendSignalingData, py::arg("chat_id"), py::arg("msg_key"));
     wrapper.def("create_call", &ntgcalls::NTgCalls::createCall, py::arg("chat_id"));
+    wrapper.def("create_null_call", &ntgcalls::NTgCalls::createNullCall, py::arg("chat_id"), py::arg("loopback"));
     wrapper.def("init_presentation", &ntgcalls::NTgCalls::initPresentation, py::arg("chat_id"));
     wrapper.def("connect", &ntgcalls::NTgCalls::connect, py::arg("chat_id"), py::arg("params"), py::arg("is_presentation"));
     wrapper.def("set_stream_sources", &ntgcalls::NTgCalls::setStreamSources, py::arg("chat_id"), py::arg("direction"), py::arg("media"));
@@ -43,13 +57,34 @@ PYBIND11_MODULE(ntgcalls, m) {
     wrapper.def("on_request_broadcast_timestamp", &ntgcalls::NTgCalls::onRequestBroadcastTimestamp, py::arg("callback"));
     wrapper.def("calls", &ntgcalls::NTgCalls::calls);
     wrapper.def("cpu_usage", &ntgcalls::NTgCalls::cpuUsage);
+    wrapper.def("stop_all", &ntgcalls::NTgCalls::stopAll, py::arg("timeout") = 5000);
+    wrapper.def("join_local_sfu", &ntgcalls::NTgCalls::joinLocalSfu, py::arg("join_payload"));
+    wrapper.def("leave_local_sfu", &ntgcalls::NTgCalls::leaveLocalSfu, py::arg("ssrc"));
+    wrapper.def("enable_fast_exit", &ntgcalls::NTgCalls::enableFastExit, py::arg("enable"));
+    wrapper.def("configure_connection_pool", &ntgcalls::NTgCalls::configureConnectionPool, py::arg("size"), py::arg("idle_timeout"));
+    wrapper.def("connection_pool_stats", &ntgcalls::NTgCalls::connectionPoolStats);
+    wrapper.def("event_queue_stats", &ntgcalls::NTgCalls::eventQueueStats);
+    wrapper.def("get_snapshot", &ntgcalls::NTgCalls::getSnapshot, py::arg("chat_id"));
+    wrapper.def("get_snapshots", &ntgcalls::NTgCalls::getSnapshots);
+    wrapper.def("get_resource_usage", &ntgcalls::NTgCalls::getResourceUsage);
+    wrapper.def("dump_resource_usage", &ntgcalls::NTgCalls::dumpResourceUsage);
     wrapper.def("send_external_frame", &ntgcalls::NTgCalls::sendExternalFrame, py::arg("chat_id"), py::arg("device"), py::arg("frame"), py::arg("frame_data"));
     wrapper.def("send_broadcast_part", &ntgcalls::NTgCalls::sendBroadcastPart, py::arg("chat_id"), py::arg("segment_id"), py::arg("part_id"), py::arg("status"), py::arg("quality_update"), py::arg("data"));
     wrapper.def("send_broadcast_timestamp", &ntgcalls::NTgCalls::sendBroadcastTimestamp, py::arg("chat_id"), py::arg("timestamp"));
     wrapper.def("get_connection_mode", &ntgcalls::NTgCalls::getConnectionMode, py::arg("chat_id"));
+    wrapper.def("get_stats", &ntgcalls::NTgCalls::getStats, py::arg("chat_id"), py::arg("cached") = true);
+    wrapper.def("get_latency", &ntgcalls::NTgCalls::getLatency, py::arg("chat_id"));
     wrapper.def_static("ping", &ntgcalls::NTgCalls::ping);
     wrapper.def_static("get_protocol", &ntgcalls::NTgCalls::getProtocol);
     wrapper.def_static("get_media_devices", &ntgcalls::NTgCalls::getMediaDevices);
+    wrapper.def_static("set_playout_threads", &ntgcalls::NTgCalls::setPlayoutThreads, py::arg("threads"));
+    wrapper.def_static("get_playout_stats", &ntgcalls::NTgCalls::getPlayoutStats);
+    wrapper.def_static("get_socket_batch_stats", &ntgcalls::NTgCalls::getSocketBatchStats);
+    wrapper.def_static("enable_tracing", &ntgcalls::NTgCalls::enableTracing, py::arg("enable"), py::arg("events_per_thread") = wrtc::Tracer::kDefaultCapacity);
+    wrapper.def_static("export_trace", &ntgcalls::NTgCalls::exportTrace, py::arg("path"));
+    wrapper.def_static("export_metrics", &ntgcalls::NTgCalls::exportMetrics);
+    wrapper.def_static("set_shared_sockets", &ntgcalls::NTgCalls::setSharedSockets, py::arg("sockets_per_address"));
+    wrapper.def_static("configure_certificate_pool", &ntgcalls::NTgCalls::configureCertificatePool, py::arg("size"), py::arg("lifetime"));
     wrapper.def_static("enable_glib_loop", &ntgcalls::NTgCalls::enableGlibLoop, py::arg("enable"));
 
     py::enum_<ntgcalls::StreamManager::Type>(m, "StreamType")
@@ -101,6 +136,12 @@ PYBIND11_MODULE(ntgcalls, m) {
         .value("EXTERNAL", ntgcalls::BaseMediaDescription::MediaSource::External)
         .export_values();
 
+    py::enum_<ntgcalls::VideoDescription::PixelFormat>(m, "PixelFormat")
+        .value("I420", ntgcalls::VideoDescription::PixelFormat::I420)
+        .value("NV12", ntgcalls::VideoDescription::PixelFormat::NV12)
+        .value("RGBA", ntgcalls::VideoDescription::PixelFormat::RGBA)
+        .export_values();
+
     py::class_<ntgcalls::MediaState>(m, "MediaState")
         .def_readonly("muted", &ntgcalls::MediaState::muted)
         .def_readonly("video_stopped", &ntgcalls::MediaState::videoStopped)
@@ -109,7 +150,8 @@ PYBIND11_MODULE(ntgcalls, m) {
 
     py::class_<ntgcalls::StreamManager::CallInfo>(m, "CallInfo")
         .def_readonly("playback", &ntgcalls::StreamManager::CallInfo::playback)
-        .def_readonly("capture", &ntgcalls::StreamManager::CallInfo::capture);
+        .def_readonly("capture", &ntgcalls::StreamManager::CallInfo::capture)
+        .def_readonly("suppressed_frames", &ntgcalls::StreamManager::CallInfo::suppressedFrames);
 
     py::class_<ntgcalls::DeviceInfo>(m, "DeviceInfo")
         .def_readonly("name", &ntgcalls::DeviceInfo::name)
@@ -138,17 +180,21 @@ PYBIND11_MODULE(ntgcalls, m) {
 
     py::class_<ntgcalls::VideoDescription> videoWrapper(m, "VideoDescription", mediaWrapper);
     videoWrapper.def(
-        py::init<ntgcalls::BaseMediaDescription::MediaSource, int16_t, int16_t, uint8_t, std::string, bool>(),
+        py::init<ntgcalls::BaseMediaDescription::MediaSource, int16_t, int16_t, uint8_t, std::string, bool, ntgcalls::VideoDescription::PixelFormat, uint16_t>(),
         py::arg("media_source"),
         py::arg("width"),
         py::arg("height"),
         py::arg("fps"),
         py::arg("input"),
-        py::arg("keep_open") = false
+        py::arg("keep_open") = false,
+        py::arg("pixel_format") = ntgcalls::VideoDescription::PixelFormat::I420,
+        py::arg("static_refresh_ms") = 0
     );
     videoWrapper.def_readwrite("width", &ntgcalls::VideoDescription::width);
     videoWrapper.def_readwrite("height", &ntgcalls::VideoDescription::height);
     videoWrapper.def_readwrite("fps", &ntgcalls::VideoDescription::fps);
+    videoWrapper.def_readwrite("pixel_format", &ntgcalls::VideoDescription::pixelFormat);
+    videoWrapper.def_readwrite("static_refresh_ms", &ntgcalls::VideoDescription::staticRefreshMs);
 
     py::class_<ntgcalls::MediaDescription> mediaDescWrapper(m, "MediaDescription");
     mediaDescWrapper.def(
@@ -171,6 +217,105 @@ PYBIND11_MODULE(ntgcalls, m) {
     protocolWrapper.def_readwrite("udp_reflector", &ntgcalls::Protocol::udp_reflector);
     protocolWrapper.def_readwrite("library_versions", &ntgcalls::Protocol::library_versions);
 
+    py::class_<ntgcalls::ConnectionPool::Stats>(m, "ConnectionPoolStats")
+        .def_readonly("ready", &ntgcalls::ConnectionPool::Stats::ready)
+        .def_readonly("hits", &ntgcalls::ConnectionPool::Stats::hits)
+        .def_readonly("misses", &ntgcalls::ConnectionPool::Stats::misses);
+
+    py::class_<ntgcalls::EventDispatcher::Stats>(m, "EventQueueStats")
+        .def_readonly("depth", &ntgcalls::EventDispatcher::Stats::depth)
+        .def_readonly("max_depth", &ntgcalls::EventDispatcher::Stats::maxDepth)
+        .def_readonly("batches", &ntgcalls::EventDispatcher::Stats::batches)
+        .def_readonly("delivered", &ntgcalls::EventDispatcher::Stats::delivered)
+        .def_readonly("coalesced", &ntgcalls::EventDispatcher::Stats::coalesced)
+        .def_readonly("dropped", &ntgcalls::EventDispatcher::Stats::dropped);
+
+    py::class_<ntgcalls::CallSnapshot>(m, "CallSnapshot")
+        .def_readonly("state", &ntgcalls::CallSnapshot::state)
+        .def_readonly("playback", &ntgcalls::CallSnapshot::playback)
+        .def_readonly("capture", &ntgcalls::CallSnapshot::capture)
+        .def_readonly("playback_time", &ntgcalls::CallSnapshot::playbackTime)
+        .def_readonly("capture_time", &ntgcalls::CallSnapshot::captureTime)
+        .def_readonly("suppressed_frames", &ntgcalls::CallSnapshot::suppressedFrames)
+        .def_readonly("connection_mode", &ntgcalls::CallSnapshot::connectionMode);
+
+    py::class_<ntgcalls::SocketBatchStats>(m, "SocketBatchStats")
+        .def_readonly("read_wakeups", &ntgcalls::SocketBatchStats::readWakeups)
+        .def_readonly("packets_received", &ntgcalls::SocketBatchStats::packetsReceived)
+        .def_readonly("max_read_batch", &ntgcalls::SocketBatchStats::maxReadBatch)
+        .def_readonly("send_flushes", &ntgcalls::SocketBatchStats::sendFlushes)
+        .def_readonly("packets_sent", &ntgcalls::SocketBatchStats::packetsSent)
+        .def_readonly("max_send_batch", &ntgcalls::SocketBatchStats::maxSendBatch)
+        .def_readonly("gso_sends", &ntgcalls::SocketBatchStats::gsoSends)
+        .def_readonly("shared_sockets", &ntgcalls::SocketBatchStats::sharedSockets)
+        .def_readonly("shared_handles", &ntgcalls::SocketBatchStats::sharedHandles)
+        .def_readonly("overflow_sockets", &ntgcalls::SocketBatchStats::overflowSockets)
+        .def_readonly("unrouted_packets", &ntgcalls::SocketBatchStats::unroutedPackets);
+
+    py::class_<ntgcalls::ThreadResourceUsage>(m, "ThreadResourceUsage")
+        .def_readonly("thread_id", &ntgcalls::ThreadResourceUsage::threadId)
+        .def_readonly("name", &ntgcalls::ThreadResourceUsage::name)
+        .def_readonly("cpu_time", &ntgcalls::ThreadResourceUsage::cpuTime);
+
+    py::class_<ntgcalls::CallResourceUsage>(m, "CallResourceUsage")
+        .def_readonly("chat_id", &ntgcalls::CallResourceUsage::chatId)
+        .def_readonly("reader_cpu_time", &ntgcalls::CallResourceUsage::readerCpuTime)
+        .def_readonly("mixer_cpu_time", &ntgcalls::CallResourceUsage::mixerCpuTime)
+        .def_readonly("encoder_cpu_time", &ntgcalls::CallResourceUsage::encoderCpuTime)
+        .def_readonly("decoder_cpu_time", &ntgcalls::CallResourceUsage::decoderCpuTime)
+        .def_readonly("buffered_bytes", &ntgcalls::CallResourceUsage::bufferedBytes);
+
+    py::class_<ntgcalls::ResourceUsage>(m, "ResourceUsage")
+        .def_readonly("resident_bytes", &ntgcalls::ResourceUsage::residentBytes)
+        .def_readonly("threads", &ntgcalls::ResourceUsage::threads)
+        .def_readonly("calls", &ntgcalls::ResourceUsage::calls);
+
+    py::class_<wrtc::RtpStreamStats>(m, "RtpStreamStats")
+        .def_readonly("ssrc", &wrtc::RtpStreamStats::ssrc)
+        .def_readonly("outgoing", &wrtc::RtpStreamStats::outgoing)
+        .def_readonly("video", &wrtc::RtpStreamStats::video)
+        .def_readonly("bytes", &wrtc::RtpStreamStats::bytes)
+        .def_readonly("packets", &wrtc::RtpStreamStats::packets)
+        .def_readonly("packets_lost", &wrtc::RtpStreamStats::packetsLost)
+        .def_readonly("fraction_lost", &wrtc::RtpStreamStats::fractionLost)
+        .def_readonly("jitter_ms", &wrtc::RtpStreamStats::jitterMs)
+        .def_readonly("nacks", &wrtc::RtpStreamStats::nacks)
+        .def_readonly("plis", &wrtc::RtpStreamStats::plis)
+        .def_readonly("bitrate", &wrtc::RtpStreamStats::bitrate)
+        .def_readonly("frame_time_ms", &wrtc::RtpStreamStats::frameTimeMs)
+        .def_readonly("jitter_buffer_delay_ms", &wrtc::RtpStreamStats::jitterBufferDelayMs);
+
+    py::class_<wrtc::CallStats>(m, "CallStats")
+        .def_readonly("timestamp", &wrtc::CallStats::timestamp)
+        .def_readonly("rtt_ms", &wrtc::CallStats::rttMs)
+        .def_readonly("send_bandwidth", &wrtc::CallStats::sendBandwidth)
+        .def_readonly("receive_bandwidth", &wrtc::CallStats::receiveBandwidth)
+        .def_readonly("pacer_delay_ms", &wrtc::CallStats::pacerDelayMs)
+        .def_readonly("transport_bytes_sent", &wrtc::CallStats::transportBytesSent)
+        .def_readonly("transport_bytes_received", &wrtc::CallStats::transportBytesReceived)
+        .def_readonly("streams", &wrtc::CallStats::streams);
+
+    py::class_<ntgcalls::LatencySummary>(m, "LatencySummary")
+        .def_readonly("count", &ntgcalls::LatencySummary::count)
+        .def_readonly("min", &ntgcalls::LatencySummary::min)
+        .def_readonly("mean", &ntgcalls::LatencySummary::mean)
+        .def_readonly("max", &ntgcalls::LatencySummary::max)
+        .def_readonly("p50", &ntgcalls::LatencySummary::p50)
+        .def_readonly("p90", &ntgcalls::LatencySummary::p90)
+        .def_readonly("p99", &ntgcalls::LatencySummary::p99)
+        .def_readonly("p999", &ntgcalls::LatencySummary::p999);
+
+    py::class_<ntgcalls::CallLatency>(m, "CallLatency")
+        .def_readonly("audio_send", &ntgcalls::CallLatency::audioSend)
+        .def_readonly("video_send", &ntgcalls::CallLatency::videoSend)
+        .def_readonly("audio_receive", &ntgcalls::CallLatency::audioReceive)
+        .def_readonly("video_receive", &ntgcalls::CallLatency::videoReceive);
+
+    py::class_<ntgcalls::PlayoutStats>(m, "PlayoutStats")
+        .def_readonly("threads", &ntgcalls::PlayoutStats::threads)
+        .def_readonly("ticks", &ntgcalls::PlayoutStats::ticks)
+        .def_readonly("late_ticks", &ntgcalls::PlayoutStats::lateTicks);
+
     py::class_<ntgcalls::RTCServer> rtcServerWrapper(m, "RTCServer");
     rtcServerWrapper.def(
         py::init<uint64_t, std::string, std::string, uint16_t, std::optional<std::string>,std::optional<std::string>, bool, bool, bool, std::optional<py::bytes>>(),
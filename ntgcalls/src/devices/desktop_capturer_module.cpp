@@ -3,6 +3,8 @@
 //
 
 #if !defined(IS_ANDROID) && !defined(IS_MACOS)
+#include <algorithm>
+#include <rtc_base/logging.h>
 #include <ntgcalls/exceptions.hpp>
 #include <third_party/libyuv/include/libyuv.h>
 #include <ntgcalls/utils/g_lib_loop_manager.hpp>
@@ -10,15 +12,16 @@
 #include <modules/desktop_capture/desktop_capturer_differ_wrapper.h>
 
 namespace ntgcalls {
-    DesktopCapturerModule::DesktopCapturerModule(const VideoDescription& desc, BaseSink* sink): BaseIO(sink), BaseReader(sink), SyncHelper(sink->frameTime()), desc(desc) {
-        capturer = CreateCapturer();
+    DesktopCapturerModule::DesktopCapturerModule(const VideoDescription& desc, BaseSink* sink): DesktopCapturerModule(desc, sink, CreateCapturer()) {}
+
+    DesktopCapturerModule::DesktopCapturerModule(const VideoDescription& desc, BaseSink* sink, std::unique_ptr<webrtc::DesktopCapturer> capturer): BaseIO(sink), BaseReader(sink), SyncHelper(sink->frameTime()), capturer(std::move(capturer)), desc(desc) {
         try {
             auto sourceMetadata = json::parse(desc.input);
-            capturer->SelectSource(sourceMetadata["id"].get<webrtc::DesktopCapturer::SourceId>());
+            this->capturer->SelectSource(sourceMetadata["id"].get<webrtc::DesktopCapturer::SourceId>());
         } catch (...) {
             throw MediaDeviceError("Invalid device metadata");
         }
-        capturer->SetMaxFrameRate(desc.fps);
+        this->capturer->SetMaxFrameRate(desc.fps);
     }
 
     DesktopCapturerModule::~DesktopCapturerModule() {
@@ -40,61 +43,121 @@ namespace ntgcalls {
         return webrtc::DesktopCapturer::CreateGenericCapturer(options);
     }
 
+    void DesktopCapturerModule::resizeCanvas(const webrtc::DesktopSize& size) {
+        const auto ySize = size.width() * size.height();
+        const auto uvSize = ((size.width() + 1) / 2) * ((size.height() + 1) / 2);
+        canvas = bytes::make_unique_binary(ySize + uvSize * 2);
+        canvasSize = size;
+    }
+
+    void DesktopCapturerModule::convertRegion(const webrtc::DesktopFrame& frame, const webrtc::DesktopRect& rect) const {
+        const int width = canvasSize.width();
+        const int uvWidth = (width + 1) / 2;
+        const auto ySize = width * canvasSize.height();
+        const auto uvSize = uvWidth * ((canvasSize.height() + 1) / 2);
+
+        // Chroma is subsampled 2x2, so the rectangle is aligned to even coordinates
+        const int left = rect.left() & ~1;
+        const int top = rect.top() & ~1;
+        const int right = std::min(rect.right() + (rect.right() & 1), width);
+        const int bottom = std::min(rect.bottom() + (rect.bottom() & 1), canvasSize.height());
+        if (right <= left || bottom <= top) {
+            return;
+        }
+
+        uint8_t* yPlane = canvas.get();
+        uint8_t* uPlane = yPlane + ySize;
+        uint8_t* vPlane = uPlane + uvSize;
+        libyuv::ARGBToI420(
+            frame.GetFrameDataAtPos(webrtc::DesktopVector(left, top)), frame.stride(),
+            yPlane + top * width + left, width,
+            uPlane + top / 2 * uvWidth + left / 2, uvWidth,
+            vPlane + top / 2 * uvWidth + left / 2, uvWidth,
+            right - left, bottom - top
+        );
+    }
+
+    void DesktopCapturerModule::updateOutput() {
+        // The previous output may still be queued in the encoder, so the new image goes to a free pooled buffer
+        auto buffer = outputPool.CreateI420Buffer(desc.width, desc.height);
+        if (!buffer) {
+            RTC_LOG(LS_WARNING) << "Every output buffer is still in use, repeating the previous frame";
+            return;
+        }
+        const int width = canvasSize.width();
+        const int uvWidth = (width + 1) / 2;
+        const auto ySize = width * canvasSize.height();
+        const auto uvSize = uvWidth * ((canvasSize.height() + 1) / 2);
+        if (desc.width != width || desc.height != canvasSize.height()) {
+            libyuv::I420Scale(
+                canvas.get(), width,
+                canvas.get() + ySize, uvWidth,
+                canvas.get() + ySize + uvSize, uvWidth,
+                width, canvasSize.height(),
+                buffer->MutableDataY(), buffer->StrideY(),
+                buffer->MutableDataU(), buffer->StrideU(),
+                buffer->MutableDataV(), buffer->StrideV(),
+                desc.width, desc.height,
+                libyuv::kFilterBox
+            );
+        } else {
+            libyuv::I420Copy(
+                canvas.get(), width,
+                canvas.get() + ySize, uvWidth,
+                canvas.get() + ySize + uvSize, uvWidth,
+                buffer->MutableDataY(), buffer->StrideY(),
+                buffer->MutableDataU(), buffer->StrideU(),
+                buffer->MutableDataV(), buffer->StrideV(),
+                width, canvasSize.height()
+            );
+        }
+        output = std::move(buffer);
+    }
+
+    void DesktopCapturerModule::emitFrame() {
+        if (!output) {
+            return;
+        }
+        wrtc::FrameData frameData(
+            0,
+            webrtc::kVideoRotation_0,
+            static_cast<uint16_t>(desc.width),
+            static_cast<uint16_t>(desc.height)
+        );
+        frameData.buffer = output;
+        (void) dataCallback(nullptr, frameData);
+    }
+
     void DesktopCapturerModule::OnCaptureResult(const webrtc::DesktopCapturer::Result result, const std::unique_ptr<webrtc::DesktopFrame> frame) {
         if (!status) return;
         if (result == webrtc::DesktopCapturer::Result::SUCCESS) {
-            const int width = frame->size().width();
-            const int height = frame->size().height();
-
-            const auto ySize = width * height;
-            const auto uvSize = ySize / 4;
-            const auto yPlane = std::make_unique<uint8_t[]>(ySize);
-            const auto uPlane = std::make_unique<uint8_t[]>(uvSize);
-            const auto vPlane = std::make_unique<uint8_t[]>(uvSize);
-            libyuv::ARGBToI420(
-                frame->data(), frame->stride(),
-                yPlane.get(), width,
-                uPlane.get(), width / 2,
-                vPlane.get(), width / 2,
-                width, height
-            );
-
-            const auto yScaledSize = desc.width * desc.height;
-            const auto uvScaledSize = yScaledSize / 4;
-            auto yuv = bytes::make_unique_binary(yScaledSize + uvScaledSize * 2);
+            const bool resized = !hasFrame || !canvasSize.equals(frame->size());
+            if (resized) {
+                resizeCanvas(frame->size());
+            }
 
-            if (desc.width == width && desc.height == height) {
-                memcpy(yuv.get(), yPlane.get(), ySize);
-                memcpy(yuv.get() + ySize, uPlane.get(), uvSize);
-                memcpy(yuv.get() + ySize + uvSize, vPlane.get(), uvSize);
+            const webrtc::DesktopRect bounds = webrtc::DesktopRect::MakeSize(frame->size());
+            bool updated = false;
+            if (resized) {
+                convertRegion(*frame, bounds);
+                updated = true;
             } else {
-                const auto yScaledPlane = std::make_unique<uint8_t[]>(yScaledSize);
-                const auto uScaledPlane = std::make_unique<uint8_t[]>(uvScaledSize);
-                const auto vScaledPlane = std::make_unique<uint8_t[]>(uvScaledSize);
-
-                I420Scale(
-                    yPlane.get(), width,
-                    uPlane.get(), width / 2,
-                    vPlane.get(), width / 2,
-                    width, height,
-                    yScaledPlane.get(), desc.width,
-                    uScaledPlane.get(), desc.width / 2,
-                    vScaledPlane.get(), desc.width / 2,
-                    desc.width, desc.height,
-                    libyuv::kFilterBox
-                );
-
-                memcpy(yuv.get(), yScaledPlane.get(), yScaledSize);
-                memcpy(yuv.get() + yScaledSize, uScaledPlane.get(), uvScaledSize);
-                memcpy(yuv.get() + yScaledSize + uvScaledSize, vScaledPlane.get(), uvScaledSize);
+                for (webrtc::DesktopRegion::Iterator it(frame->updated_region()); !it.IsAtEnd(); it.Advance()) {
+                    webrtc::DesktopRect rect = it.rect();
+                    rect.IntersectWith(bounds);
+                    if (!rect.is_empty()) {
+                        convertRegion(*frame, rect);
+                        updated = true;
+                    }
+                }
             }
+            hasFrame = true;
 
-            (void) dataCallback(std::move(yuv), {
-                0,
-                webrtc::kVideoRotation_0,
-                static_cast<uint16_t>(desc.width),
-                static_cast<uint16_t>(desc.height),
-            });
+            if (updated) {
+                updateOutput();
+            }
+            // Unchanged frames hand out the same buffer again without converting nor copying anything
+            emitFrame();
         } else if (result == webrtc::DesktopCapturer::Result::ERROR_PERMANENT) {
             (void) eofCallback();
         }
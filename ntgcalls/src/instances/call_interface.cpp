@@ -2,53 +2,149 @@
 // Created by Laky64 on 15/03/2024.
 //
 
+#include <mutex>
+#include <rtc_base/time_utils.h>
+#include <ntgcalls/exceptions.hpp>
 #include <ntgcalls/instances/call_interface.hpp>
+#include <wrtc/utils/metrics.hpp>
 
 namespace ntgcalls {
-    CallInterface::CallInterface(webrtc::Thread* updateThread): updateThread(updateThread) {
-        streamManager = std::make_shared<StreamManager>(updateThread);
+    CallInterface::CallInterface(webrtc::Thread* updateThread): updateThread(updateThread), account(std::make_shared<ResourceAccount>()) {
+        streamManager = std::make_shared<StreamManager>(updateThread, account);
+        streamState = std::make_shared<AtomicSnapshot<StreamManager::Snapshot>>();
+        streamState->store(streamManager->snapshot());
+        streamManager->onPublish([state = streamState](std::shared_ptr<const StreamManager::Snapshot> snapshot) {
+            state->store(std::move(snapshot));
+        });
+        wrtc::metrics::activeCalls.add(1);
+    }
+
+    CallInterface::~CallInterface() {
+        wrtc::metrics::activeCalls.add(-1);
     }
 
     void CallInterface::stop() {
         connectionChangeCallback = nullptr;
-        streamManager->close();
-        streamManager = nullptr;
-        if (connection) {
-            connection->close();
-            connection = nullptr;
+        std::shared_ptr<StreamManager> manager;
+        std::shared_ptr<wrtc::NetworkInterface> conn;
+        {
+            std::lock_guard lock(snapshotMutex);
+            manager = std::move(streamManager);
+            conn = std::move(connection);
+        }
+        if (manager) {
+            manager->close();
+        }
+        streamState->store(nullptr);
+        if (conn) {
+            conn->close();
+        }
+        updateThread = nullptr;
+    }
+
+    void CallInterface::abandon() {
+        connectionChangeCallback = nullptr;
+        std::shared_ptr<StreamManager> manager;
+        std::shared_ptr<wrtc::NetworkInterface> conn;
+        {
+            std::lock_guard lock(snapshotMutex);
+            manager = std::move(streamManager);
+            conn = std::move(connection);
+        }
+        if (manager) {
+            manager->close();
+        }
+        streamState->store(nullptr);
+        if (conn) {
+            abandonConnection(std::move(conn));
         }
         updateThread = nullptr;
     }
 
+    void CallInterface::setConnection(std::shared_ptr<wrtc::NetworkInterface> conn) {
+        if (conn) {
+            conn->onFrameSent([weak = std::weak_ptr(account)](const bool video, const int64_t mediaTimeMs, const int64_t sentAtUs) {
+                if (const auto strong = weak.lock()) {
+                    strong->sendFinished(video ? ResourceAccount::Path::VideoSend : ResourceAccount::Path::AudioSend, mediaTimeMs, sentAtUs);
+                }
+            });
+        }
+        connectionMode = conn ? conn->getConnectionMode() : wrtc::ConnectionMode::None;
+        std::lock_guard lock(snapshotMutex);
+        connection = std::move(conn);
+    }
+
+    void CallInterface::abandonConnection(std::shared_ptr<wrtc::NetworkInterface> conn) {
+        // Fast exit only, the process is going away: destroying the connection would hop onto the RTC threads for every channel
+        static std::mutex abandonedMutex;
+        static auto* abandoned = new std::vector<std::shared_ptr<wrtc::NetworkInterface>>();
+        std::lock_guard lock(abandonedMutex);
+        abandoned->push_back(std::move(conn));
+    }
+
+    std::shared_ptr<StreamManager> CallInterface::lockedStreamManager() const {
+        std::lock_guard lock(snapshotMutex);
+        if (!streamManager) {
+            throw ConnectionNotFound("Call already stopped");
+        }
+        return streamManager;
+    }
+
+    std::shared_ptr<wrtc::NetworkInterface> CallInterface::lockedConnection() const {
+        std::lock_guard lock(snapshotMutex);
+        if (!connection) {
+            throw ConnectionNotFound("Call not connected or already stopped");
+        }
+        return connection;
+    }
+
+    std::shared_ptr<const StreamManager::Snapshot> CallInterface::publishedStreams() const {
+        auto state = streamState->load();
+        if (!state) {
+            throw ConnectionNotFound("Call already stopped");
+        }
+        return state;
+    }
+
     wrtc::ConnectionMode CallInterface::getConnectionMode() const {
-        return connection->getConnectionMode();
+        return lockedConnection()->getConnectionMode();
+    }
+
+    wrtc::CallStats CallInterface::getStats(const bool cached) const {
+        return lockedConnection()->getStats(cached);
     }
 
     bool CallInterface::pause() const {
-        return streamManager->pause();
+        return lockedStreamManager()->pause();
     }
 
     bool CallInterface::resume() const {
-        return streamManager->resume();
+        return lockedStreamManager()->resume();
     }
 
     bool CallInterface::mute() const {
-        return streamManager->mute();
+        return lockedStreamManager()->mute();
     }
 
     bool CallInterface::unmute() const {
-        return streamManager->unmute();
+        return lockedStreamManager()->unmute();
     }
 
     void CallInterface::setStreamSources(const StreamManager::Mode mode, const MediaDescription& config) const {
-        streamManager->setStreamSources(mode, config);
-        if (mode == StreamManager::Mode::Playback && connection) {
-            streamManager->optimizeSources(connection.get());
+        const auto manager = lockedStreamManager();
+        std::shared_ptr<wrtc::NetworkInterface> conn;
+        {
+            std::lock_guard lock(snapshotMutex);
+            conn = connection;
+        }
+        manager->setStreamSources(mode, config);
+        if (mode == StreamManager::Mode::Playback && conn) {
+            manager->optimizeSources(conn.get());
         }
     }
 
     void CallInterface::onStreamEnd(const std::function<void(StreamManager::Type, StreamManager::Device)>& callback) const {
-        streamManager->onStreamEnd(callback);
+        lockedStreamManager()->onStreamEnd(callback);
     }
 
     void CallInterface::onConnectionChange(const std::function<void(NetworkInfo)>& callback) {
@@ -56,7 +152,7 @@ namespace ntgcalls {
     }
 
     void CallInterface::onFrames(const std::function<void(StreamManager::Mode, StreamManager::Device, const std::vector<wrtc::Frame>&)>& callback) const {
-        streamManager->onFrames(callback);
+        lockedStreamManager()->onFrames(callback);
     }
 
     void CallInterface::onRemoteSourceChange(const std::function<void(RemoteSource)>& callback) {
@@ -64,31 +160,59 @@ namespace ntgcalls {
     }
 
     uint64_t CallInterface::time(const StreamManager::Mode mode) const {
-        return streamManager->time(mode);
+        return publishedStreams()->time(mode);
     }
 
     MediaState CallInterface::getState() const {
-        return streamManager->getState();
+        return publishedStreams()->state;
     }
 
     StreamManager::Status CallInterface::status(const StreamManager::Mode mode) const {
-        return streamManager->status(mode);
+        const auto state = publishedStreams();
+        return mode == StreamManager::Mode::Capture ? state->capture : state->playback;
+    }
+
+    uint64_t CallInterface::suppressedFrames() const {
+        return publishedStreams()->suppressedFrames();
+    }
+
+    const std::shared_ptr<ResourceAccount>& CallInterface::resourceAccount() const {
+        return account;
+    }
+
+    std::optional<CallSnapshot> CallInterface::snapshot() const {
+        const auto state = streamState->load();
+        if (!state) {
+            return std::nullopt;
+        }
+        return CallSnapshot{
+            state->state,
+            state->playback,
+            state->capture,
+            state->time(StreamManager::Mode::Playback),
+            state->time(StreamManager::Mode::Capture),
+            state->suppressedFrames(),
+            connectionMode.load(),
+        };
     }
 
     void CallInterface::sendExternalFrame(const StreamManager::Device device, const bytes::binary& data, const wrtc::FrameData frameData) const {
-        streamManager->sendExternalFrame(device, data, frameData);
+        lockedStreamManager()->sendExternalFrame(device, data, frameData);
     }
 
     void CallInterface::setConnectionObserver(const std::shared_ptr<wrtc::NetworkInterface>& conn, NetworkInfo::Kind kind) {
         RTC_LOG(LS_VERBOSE) << "Connecting...";
+        if (kind == NetworkInfo::Kind::Normal) {
+            connectionMode = conn->getConnectionMode();
+        }
         (void) connectionChangeCallback({NetworkInfo::ConnectionState::Connecting, kind});
         std::weak_ptr weak(shared_from_this());
-        conn->onConnectionChange([weak, kind, conn](const wrtc::ConnectionState state, bool wasConnected) {
+        conn->onConnectionChange([weak, kind, conn, startedAt = webrtc::TimeMillis()](const wrtc::ConnectionState state, bool wasConnected) {
             const auto strong = weak.lock();
             if (!strong) {
                 return;
             }
-            strong->updateThread->PostTask([weak, kind, conn, state, wasConnected] {
+            strong->updateThread->PostTask([weak, kind, conn, state, wasConnected, startedAt] {
                 const auto strongUpdate = weak.lock();
                 if (!strongUpdate) {
                     return;
@@ -101,7 +225,11 @@ namespace ntgcalls {
                     return;
                 case wrtc::ConnectionState::Connected:
                     RTC_LOG(LS_VERBOSE) << "Connection established";
+                    if (kind == NetworkInfo::Kind::Normal) {
+                        strongUpdate->connectionMode = conn->getConnectionMode();
+                    }
                     if (!wasConnected && strongUpdate->streamManager) {
+                        wrtc::metrics::joinLatency.observe(static_cast<double>(webrtc::TimeMillis() - startedAt) / 1000);
                         strongUpdate->streamManager->start();
                         RTC_LOG(LS_VERBOSE) << "Stream started";
                         (void) strongUpdate->connectionChangeCallback({NetworkInfo::ConnectionState::Connected, kind});
@@ -4,6 +4,7 @@
 
 #include <ntgcalls/instances/group_call.hpp>
 
+#include <algorithm>
 #include <future>
 #include <ntgcalls/exceptions.hpp>
 #include <wrtc/interfaces/group_connection.hpp>
@@ -13,20 +14,30 @@
     throw RTMPStreamingUnsupported("Streaming is not supported when using RTMP");
 
 namespace ntgcalls {
-
     void GroupCall::stop() {
         stopPresentation();
         CallInterface::stop();
     }
 
-    std::string GroupCall::init() {
+    void GroupCall::abandon() {
+        if (presentationConnection) {
+            abandonConnection(std::move(presentationConnection));
+        }
+        CallInterface::abandon();
+    }
+
+    std::string GroupCall::init(std::shared_ptr<wrtc::GroupConnection> warmConnection) {
         RTC_LOG(LS_INFO) << "Initializing group call";
         if (connection) {
             RTC_LOG(LS_ERROR) << "Connection already made";
             throw ConnectionError("Connection already made");
         }
-        connection = std::make_shared<wrtc::GroupConnection>(false);
-        connection->open();
+        if (warmConnection) {
+            setConnection(std::move(warmConnection));
+        } else {
+            setConnection(std::make_shared<wrtc::GroupConnection>(false));
+            connection->open();
+        }
         RTC_LOG(LS_INFO) << "Group call initialized";
         streamManager->setStreamSources(StreamManager::Mode::Capture);
         streamManager->setStreamSources(StreamManager::Mode::Playback);
@@ -50,6 +61,26 @@ namespace ntgcalls {
         return Safe<wrtc::GroupConnection>(connection)->getJoinPayload();
     }
 
+    void GroupCall::initNull(const wrtc::NullTransport::Mode mode) {
+        RTC_LOG(LS_INFO) << "Initializing group call on the null network";
+        if (connection) {
+            RTC_LOG(LS_ERROR) << "Connection already made";
+            throw ConnectionError("Connection already made");
+        }
+        const auto nullConnection = std::make_shared<wrtc::GroupConnection>(false);
+        nullConnection->setNullNetwork(mode);
+        nullConnection->open();
+        (void) init(nullConnection);
+        auto payload = wrtc::ResponsePayload::defaultMedia();
+        payload["transport"] = json{
+            {"ufrag", "null"},
+            {"pwd", "null"},
+            {"fingerprints", json::array()},
+            {"candidates", json::array()}
+        };
+        connect(payload.dump(), false);
+    }
+
     std::string GroupCall::initPresentation() {
         if (getConnectionMode() != wrtc::ConnectionMode::Rtc) {
             RTC_LOG(LS_ERROR) << "Presentation connection requires RTC connection";
@@ -111,6 +142,9 @@ namespace ntgcalls {
             RTMP_UNSUPPORTED_THROW
         }
 
+        if (std::ranges::any_of(payload.candidates, [](const webrtc::Candidate& candidate) { return candidate.address().IsLoopbackIP(); })) {
+            Safe<wrtc::GroupConnection>(conn)->enableLoopbackNetworks();
+        }
         Safe<wrtc::GroupConnection>(conn)->setConnectionMode(connectionMode);
         if (connectionMode == wrtc::ConnectionMode::Rtc) {
             Safe<wrtc::GroupConnection>(conn)->setRemoteParams(payload.remoteIceParameters, std::move(payload.fingerprint));
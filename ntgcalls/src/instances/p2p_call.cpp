@@ -24,6 +24,14 @@ namespace ntgcalls {
         }
     }
 
+    void P2PCall::abandon() {
+        CallInterface::abandon();
+        if (signaling) {
+            signaling->close();
+            signaling = nullptr;
+        }
+    }
+
     void P2PCall::init() const {
         RTC_LOG(LS_INFO) << "Initializing P2P call";
         streamManager->enableVideoSimulcast(false);
@@ -132,11 +140,11 @@ namespace ntgcalls {
         protocolVersion = signaling::Signaling::matchVersion(versions);
         std::weak_ptr weak(shared_from_this());
         if (protocolVersion == signaling::Signaling::Version::V2) {
-            connection = std::make_shared<wrtc::NativeConnection>(
+            setConnection(std::make_shared<wrtc::NativeConnection>(
                 RTCServer::toRtcServers(servers),
                 p2pAllowed,
                 type() == Type::Outgoing
-            );
+            ));
         } else {
             throw InvalidParams("Unsupported protocol version");
         }
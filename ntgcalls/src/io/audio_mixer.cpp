@@ -11,11 +11,16 @@ namespace ntgcalls {
 
     void AudioMixer::sendFrames(const std::map<uint32_t, std::pair<bytes::unique_binary, size_t>>& frames) {
         if (!sink) return;
+        ResourceAccount::Scope scope(sink->account(), ResourceAccount::Work::Mixer);
         const auto frameSize = sink->frameSize();
         bytes::unique_binary mixedOutput = bytes::make_unique_binary(frameSize);
         std::fill_n(reinterpret_cast<int16_t*>(mixedOutput.get()), frameSize / sizeof(int16_t), 0);
 
         const auto numSources = frames.size();
+        if (numSources == 0) {
+            onData(std::move(mixedOutput));
+            return;
+        }
         for (size_t i = 0; i < frameSize / sizeof(int16_t); i++) {
             int32_t mixedSample = 0;
             for (const auto& [fst, snd] : frames | std::views::values) {
@@ -4,9 +4,16 @@
 
 #include <utility>
 #include <ntgcalls/io/base_reader.hpp>
+#include <wrtc/utils/metrics.hpp>
 
 namespace ntgcalls {
-    BaseReader::BaseReader(BaseSink *sink): BaseIO(sink) {}
+    BaseReader::BaseReader(BaseSink *sink): BaseIO(sink) {
+        wrtc::metrics::activeReaders.add(1);
+    }
+
+    BaseReader::~BaseReader() {
+        wrtc::metrics::activeReaders.add(-1);
+    }
 
     void BaseReader::onData(const std::function<void(bytes::unique_binary, wrtc::FrameData)>& callback) {
         dataCallback = callback;
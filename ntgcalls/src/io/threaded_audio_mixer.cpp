@@ -3,6 +3,7 @@
 //
 
 #include <ntgcalls/io/threaded_audio_mixer.hpp>
+#include <wrtc/utils/metrics.hpp>
 
 namespace ntgcalls {
     ThreadedAudioMixer::ThreadedAudioMixer(BaseSink* sink): AudioMixer(sink) {}
@@ -15,6 +16,10 @@ namespace ntgcalls {
             cv.notify_all();
         }
         if (wasRunning) thread.Finalize();
+        wrtc::metrics::mixerQueueDepth.add(-static_cast<int64_t>(queue.size()));
+        if (sink && sink->account()) {
+            sink->account()->addBuffered(-static_cast<int64_t>(queue.size()) * sink->frameSize());
+        }
     }
 
     void ThreadedAudioMixer::open() {
@@ -23,7 +28,7 @@ namespace ntgcalls {
         auto frameSize = sink->frameSize();
         auto frameTime = sink->frameTime();
         thread = webrtc::PlatformThread::SpawnJoinable(
-        [this, frameSize, frameTime] {
+        [this, frameSize, frameTime, account = sink->account()] {
                 while (running) {
                     std::unique_lock lock(mtx);
                     const auto ok = cv.wait_for(lock, frameTime + std::chrono::milliseconds(20), [this] {
@@ -34,10 +39,15 @@ namespace ntgcalls {
                         break;
                     }
                     try {
+                        ResourceAccount::Scope scope(account, ResourceAccount::Work::Mixer);
                         if (ok) {
                             std::lock_guard queueLock(queueMutex);
                             write(queue.front());
                             queue.pop();
+                            wrtc::metrics::mixerQueueDepth.add(-1);
+                            if (account) {
+                                account->addBuffered(-frameSize);
+                            }
                         } else {
                             write(bytes::make_unique_binary(frameSize));
                         }
@@ -56,6 +66,10 @@ namespace ntgcalls {
     void ThreadedAudioMixer::onData(bytes::unique_binary data) {
         std::lock_guard queueLock(queueMutex);
         queue.push(std::move(data));
+        wrtc::metrics::mixerQueueDepth.add(1);
+        if (const auto& account = sink->account()) {
+            account->addBuffered(sink->frameSize());
+        }
         cv.notify_one();
     }
 } // ntgcalls
\ No newline at end of file
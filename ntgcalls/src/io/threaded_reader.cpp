@@ -3,7 +3,9 @@
 //
 
 #include <thread>
+#include <rtc_base/time_utils.h>
 #include <ntgcalls/io/threaded_reader.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace ntgcalls {
     ThreadedReader::ThreadedReader(BaseSink *sink, const size_t threadCount): BaseReader(sink), SyncHelper(sink->frameTime()) {
@@ -32,15 +34,20 @@ namespace ntgcalls {
         for (size_t i = 0; i < bufferCount; ++i) {
             bufferThreads.push_back(
                 webrtc::PlatformThread::SpawnJoinable(
-                    [this, i, bufferCount, frameSize = sink->frameSize(), maxBufferSize = std::chrono::seconds(1) / frameTime / 10, readCallback] {
+                    [this, i, bufferCount, frameSize = sink->frameSize(), maxBufferSize = std::chrono::seconds(1) / frameTime / 10, readCallback, account = sink->account()] {
                         activeBufferCount++;
                         std::vector<bytes::unique_binary> frames;
                         frames.reserve(maxBufferSize);
+                        int64_t bufferedBytes = 0;
+                        int64_t producedAtUs = 0;
                         while (running) {
                             try {
+                                ResourceAccount::Scope scope(account, ResourceAccount::Work::Reader);
+                                WRTC_TRACE_SCOPE("source.read");
                                 std::unique_lock lock(mtx);
                                 auto data = readCallback(frameSize * maxBufferSize);
                                 lock.unlock();
+                                producedAtUs = webrtc::TimeMicros();
                                 frames.clear();
                                 for (size_t j = 0; j < maxBufferSize; j++) {
                                     const size_t offset = j * frameSize;
@@ -48,6 +55,11 @@ namespace ntgcalls {
                                     std::memcpy(chunk.get(), data.get() + offset, frameSize);
                                     frames.push_back(std::move(chunk));
                                 }
+                                if (account) {
+                                    const auto filled = static_cast<int64_t>(frameSize * maxBufferSize);
+                                    account->addBuffered(filled - bufferedBytes);
+                                    bufferedBytes = filled;
+                                }
                             } catch (...) {
                                 std::lock_guard lock(mtx);
                                 running = false;
@@ -63,12 +75,22 @@ namespace ntgcalls {
                             if (!running) break;
                             for (auto& chunk : frames) {
                                 if (!running) break;
-                                dataCallback(std::move(chunk), {});
+                                // Every frame gets its own capture time, the read time keeps the wait in this buffer in the latency
+                                wrtc::FrameData frameData(webrtc::TimeMillis(), webrtc::kVideoRotation_0, 0, 0);
+                                frameData.producedAtUs = producedAtUs;
+                                dataCallback(std::move(chunk), frameData);
+                                if (account) {
+                                    account->addBuffered(-frameSize);
+                                    bufferedBytes -= frameSize;
+                                }
                                 waitNextFrame();
                             }
                             activeBuffer = (activeBuffer + 1) % bufferCount;
                             cv.notify_all();
                         }
+                        if (account) {
+                            account->addBuffered(-bufferedBytes);
+                        }
                         std::lock_guard lock(mtx);
                         activeBufferCount--;
                         if (activeBufferCount == 0) {
@@ -5,6 +5,7 @@
 #include <ntgcalls/media/audio_receiver.hpp>
 #include <ntgcalls/exceptions.hpp>
 #include <rtc_base/logging.h>
+#include <rtc_base/time_utils.h>
 
 namespace ntgcalls {
     AudioReceiver::AudioReceiver() {
@@ -87,7 +88,7 @@ namespace ntgcalls {
     }
 
     void AudioReceiver::open() {
-        sink = std::make_shared<wrtc::RemoteAudioSink>([this](const std::vector<std::unique_ptr<wrtc::AudioFrame>>& samples) {
+        sink = std::make_shared<wrtc::RemoteAudioSink>([this](const std::vector<wrtc::AudioFrame>& samples) {
             if (!description) {
                 return;
             }
@@ -96,27 +97,39 @@ namespace ntgcalls {
             }
             std::lock_guard lock(mutex);
             std::map<uint32_t, std::pair<bytes::unique_binary, size_t>> processedFrames;
-            for (const auto& frame: samples) {
-                try {
-                    bytes::unique_binary data = bytes::make_unique_binary(frame->size);
-                    memcpy(data.get(), frame->data, frame->size);
-                    processedFrames.emplace(
-                        frame->ssrc,
-                        std::pair{
-                            resampleFrame(
-                                std::move(data),
-                                frame->size,
-                                frame->channels,
-                                frame->sampleRate
-                            ),
-                            frameSize()
-                        }
-                    );
-                } catch (const InvalidParams& e) {
-                    RTC_LOG(LS_ERROR) << "Failed to adapt audio frame: " << e.what();
+            {
+                ResourceAccount::Scope scope(resourceAccount, ResourceAccount::Work::Decoder);
+                for (const auto& frame: samples) {
+                    try {
+                        bytes::unique_binary data = bytes::make_unique_binary(frame.size);
+                        memcpy(data.get(), frame.data, frame.size);
+                        processedFrames.emplace(
+                            frame.ssrc,
+                            std::pair{
+                                resampleFrame(
+                                    std::move(data),
+                                    frame.size,
+                                    frame.channels,
+                                    frame.sampleRate
+                                ),
+                                frameSize()
+                            }
+                        );
+                    } catch (const InvalidParams& e) {
+                        RTC_LOG(LS_ERROR) << "Failed to adapt audio frame: " << e.what();
+                    }
                 }
             }
             frames++;
+            if (resourceAccount) {
+                // WebRTC does not expose packet arrival for audio, the latency starts at decoded playout
+                const auto now = webrtc::TimeMicros();
+                for (const auto& frame : samples) {
+                    if (frame.decodedAtUs > 0) {
+                        resourceAccount->addLatency(ResourceAccount::Path::AudioReceive, now - frame.decodedAtUs);
+                    }
+                }
+            }
             (void) framesCallback(processedFrames);
         });
         weakSink = sink;
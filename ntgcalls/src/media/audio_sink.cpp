@@ -26,6 +26,7 @@ namespace ntgcalls {
         if (changed || forceChange) {
             description = desc;
             clear();
+            cacheFrameTime();
             RTC_LOG(LS_INFO) << "AudioSink configured with " << desc->sampleRate << "Hz, " << 16 << "bps, " << desc->channelCount << " channels";
         }
         return changed || forceChange;
@@ -3,6 +3,7 @@
 //
 
 #include <ntgcalls/media/audio_streamer.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace ntgcalls {
     AudioStreamer::AudioStreamer() {
@@ -18,6 +19,7 @@ namespace ntgcalls {
     }
 
     void AudioStreamer::sendData(uint8_t* sample, size_t size, const wrtc::FrameData additionalData) {
+        WRTC_TRACE_SCOPE("audio_streamer");
         frames++;
         auto event = wrtc::RTCOnDataEvent(sample, frameSize() / (2 * description->channelCount));
         event.channelCount = description->channelCount;
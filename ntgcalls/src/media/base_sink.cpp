@@ -14,10 +14,22 @@ namespace ntgcalls {
     }
 
     std::chrono::nanoseconds BaseSink::nanoTime() {
-        return frames * frameTime();
+        return std::chrono::nanoseconds(cachedFrameTime.load(std::memory_order_relaxed)) * frames.load(std::memory_order_relaxed);
+    }
+
+    void BaseSink::cacheFrameTime() {
+        cachedFrameTime = frameTime().count();
     }
 
     void BaseSink::clear() {
         frames = 0;
     }
+
+    void BaseSink::setAccount(std::shared_ptr<ResourceAccount> account) {
+        resourceAccount = std::move(account);
+    }
+
+    const std::shared_ptr<ResourceAccount>& BaseSink::account() const {
+        return resourceAccount;
+    }
 }
@@ -0,0 +1,42 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <algorithm>
+#include <libyuv.h>
+#include <ntgcalls/media/static_frame_detector.hpp>
+
+namespace ntgcalls {
+    bool StaticFrameDetector::isStatic(const uint8_t* yPlane, const uint16_t width, const uint16_t height, const std::chrono::milliseconds refreshInterval) {
+        const auto now = std::chrono::steady_clock::now();
+        const size_t tiles = (height + kTileRows - 1) / kTileRows;
+        bool unchanged = width == lastWidth && height == lastHeight;
+        if (!unchanged) {
+            reset();
+            tileHashes.assign(tiles, 0);
+            lastWidth = width;
+            lastHeight = height;
+        }
+        for (size_t i = 0; i < tiles; i++) {
+            const size_t rows = std::min<size_t>(kTileRows, height - i * kTileRows);
+            // HashDjb2 uses the SSE4.1/AVX2/NEON paths of libyuv when available
+            const auto hash = libyuv::HashDjb2(yPlane + i * kTileRows * width, rows * width, 5381);
+            if (tileHashes[i] != hash) {
+                tileHashes[i] = hash;
+                unchanged = false;
+            }
+        }
+        if (unchanged && now - lastForwarded < refreshInterval) {
+            return true;
+        }
+        lastForwarded = now;
+        return false;
+    }
+
+    void StaticFrameDetector::reset() {
+        tileHashes.clear();
+        lastWidth = 0;
+        lastHeight = 0;
+        lastForwarded = {};
+    }
+} // ntgcalls
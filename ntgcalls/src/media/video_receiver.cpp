@@ -2,24 +2,132 @@
 // Created by Laky64 on 26/10/24.
 //
 
+#include <algorithm>
 #include <libyuv.h>
+#include <rtc_base/time_utils.h>
 #include <ntgcalls/media/video_receiver.hpp>
 
 namespace ntgcalls {
+    uint8_t* VideoReceiver::FramePool::acquire(const size_t size) {
+        if (size > capacity) {
+            buffer = bytes::make_unique_binary(size);
+            capacity = size;
+        }
+        return buffer.get();
+    }
+
+    const bytes::unique_binary& VideoReceiver::FramePool::get() const {
+        return buffer;
+    }
+
+    size_t VideoReceiver::FramePool::size() const {
+        return capacity;
+    }
+
     VideoReceiver::~VideoReceiver() {
         std::lock_guard lock(mutex);
         sink = nullptr;
         frameCallback = nullptr;
+        if (resourceAccount) {
+            resourceAccount->addBuffered(-static_cast<int64_t>(outputPool.size() + scalePool.size()));
+        }
     }
 
     std::weak_ptr<wrtc::RemoteVideoSink> VideoReceiver::remoteSink() {
         return sink;
     }
 
-    void VideoReceiver::onFrame(const std::function<void(uint32_t, bytes::unique_binary, size_t, wrtc::FrameData)>& callback) {
+    void VideoReceiver::onFrame(const std::function<void(uint32_t, const bytes::unique_binary&, size_t, wrtc::FrameData)>& callback) {
         frameCallback = callback;
     }
 
+    size_t VideoReceiver::outputSize(const VideoDescription::PixelFormat format, const uint16_t width, const uint16_t height) {
+        const size_t ySize = width * height;
+        const size_t uvSize = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+        switch (format) {
+        case VideoDescription::PixelFormat::RGBA:
+            return ySize * 4;
+        case VideoDescription::PixelFormat::NV12:
+        case VideoDescription::PixelFormat::I420:
+        default:
+            return ySize + uvSize * 2;
+        }
+    }
+
+    void VideoReceiver::convertFrame(const webrtc::I420BufferInterface* buffer, const uint16_t width, const uint16_t height) {
+        const auto format = description->pixelFormat;
+        const int uvWidth = (width + 1) / 2;
+        const int uvHeight = (height + 1) / 2;
+        const size_t ySize = width * height;
+        const size_t uvSize = static_cast<size_t>(uvWidth) * uvHeight;
+        const bool needsScale = buffer->width() != width || buffer->height() != height;
+
+        const uint8_t *srcY = buffer->DataY(), *srcU = buffer->DataU(), *srcV = buffer->DataV();
+        int srcStrideY = buffer->StrideY(), srcStrideU = buffer->StrideU(), srcStrideV = buffer->StrideV();
+
+        auto* output = outputPool.acquire(outputSize(format, width, height));
+
+        if (needsScale) {
+            // I420 is scaled straight into the output, other formats go
+            // through a single scratch I420 frame before the final conversion
+            uint8_t* scaled = format == VideoDescription::PixelFormat::I420 ? output : scalePool.acquire(ySize + uvSize * 2);
+            libyuv::I420Scale(
+                srcY, srcStrideY,
+                srcU, srcStrideU,
+                srcV, srcStrideV,
+                buffer->width(), buffer->height(),
+                scaled, width,
+                scaled + ySize, uvWidth,
+                scaled + ySize + uvSize, uvWidth,
+                width, height,
+                libyuv::kFilterBox
+            );
+            if (format == VideoDescription::PixelFormat::I420) {
+                return;
+            }
+            srcY = scaled;
+            srcU = scaled + ySize;
+            srcV = scaled + ySize + uvSize;
+            srcStrideY = width;
+            srcStrideU = uvWidth;
+            srcStrideV = uvWidth;
+        }
+
+        switch (format) {
+        case VideoDescription::PixelFormat::I420:
+            libyuv::I420Copy(
+                srcY, srcStrideY,
+                srcU, srcStrideU,
+                srcV, srcStrideV,
+                output, width,
+                output + ySize, uvWidth,
+                output + ySize + uvSize, uvWidth,
+                width, height
+            );
+            break;
+        case VideoDescription::PixelFormat::NV12:
+            libyuv::I420ToNV12(
+                srcY, srcStrideY,
+                srcU, srcStrideU,
+                srcV, srcStrideV,
+                output, width,
+                output + ySize, uvWidth * 2,
+                width, height
+            );
+            break;
+        case VideoDescription::PixelFormat::RGBA:
+            // libyuv names formats by little-endian word order, ABGR is R, G, B, A in memory
+            libyuv::I420ToABGR(
+                srcY, srcStrideY,
+                srcU, srcStrideU,
+                srcV, srcStrideV,
+                output, width * 4,
+                width, height
+            );
+            break;
+        }
+    }
+
     void VideoReceiver::open() {
         sink = std::make_shared<wrtc::RemoteVideoSink>([this](const uint32_t ssrc, const std::unique_ptr<webrtc::VideoFrame>& frame) {
             if (!description) {
@@ -40,34 +148,24 @@ namespace ntgcalls {
             } else {
                 newHeight = description->height;
             }
-            const auto yScaledSize = newWidth * newHeight;
-            const auto uvScaledSize = yScaledSize / 4;
-            const auto totalSize = yScaledSize + uvScaledSize * 2;
-            auto yuv = bytes::make_unique_binary(totalSize);
-            const auto buffer = frame->video_frame_buffer()->ToI420();
-            const auto width = buffer->width();
-            const auto height = buffer->height();
-            const auto yScaledPlane = std::make_unique<uint8_t[]>(yScaledSize);
-            const auto uScaledPlane = std::make_unique<uint8_t[]>(uvScaledSize);
-            const auto vScaledPlane = std::make_unique<uint8_t[]>(uvScaledSize);
-
-            I420Scale(
-                buffer->DataY(), buffer->StrideY(),
-                buffer->DataU(), buffer->StrideU(),
-                buffer->DataV(), buffer->StrideV(),
-                width, height,
-                yScaledPlane.get(), newWidth,
-                uScaledPlane.get(), newWidth / 2,
-                vScaledPlane.get(), newWidth / 2,
-                newWidth, newHeight,
-                libyuv::kFilterBox
-            );
-
-            memcpy(yuv.get(), yScaledPlane.get(), yScaledSize);
-            memcpy(yuv.get() + yScaledSize, uScaledPlane.get(), uvScaledSize);
-            memcpy(yuv.get() + yScaledSize + uvScaledSize, vScaledPlane.get(), uvScaledSize);
+            {
+                ResourceAccount::Scope scope(resourceAccount, ResourceAccount::Work::Decoder);
+                const auto pooledBytes = outputPool.size() + scalePool.size();
+                const auto buffer = frame->video_frame_buffer()->ToI420();
+                convertFrame(buffer.get(), newWidth, newHeight);
+                if (resourceAccount) {
+                    resourceAccount->addBuffered(static_cast<int64_t>(outputPool.size() + scalePool.size() - pooledBytes));
+                }
+            }
 
-            (void) frameCallback(ssrc, std::move(yuv), totalSize, {
+            if (resourceAccount && !frame->packet_infos().empty()) {
+                // Measured from the first packet of the frame, so jitter buffering and decoding are included
+                const auto arrival = std::ranges::min(frame->packet_infos(), {}, [](const webrtc::RtpPacketInfo& info) {
+                    return info.receive_time();
+                }).receive_time();
+                resourceAccount->addLatency(ResourceAccount::Path::VideoReceive, webrtc::TimeMicros() - arrival.us());
+            }
+            (void) frameCallback(ssrc, outputPool.get(), outputSize(description->pixelFormat, newWidth, newHeight), {
                 frame->timestamp_us(),
                 frame->rotation(),
                 newWidth,
@@ -76,4 +174,4 @@ namespace ntgcalls {
         });
         weakSink = sink;
     }
-} // ntgcalls
\ No newline at end of file
+} // ntgcalls
@@ -28,6 +28,7 @@ namespace ntgcalls {
         if (changed || forceChange) {
             description = desc;
             clear();
+            cacheFrameTime();
             if (desc -> width <= 0 && desc -> height <= 0 && desc -> fps == 0) {
                 RTC_LOG(LS_INFO) << "VideoSink configured with auto resolution";
             } else {
@@ -3,6 +3,8 @@
 //
 
 #include <ntgcalls/media/video_streamer.hpp>
+#include <wrtc/utils/metrics.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace ntgcalls {
     VideoStreamer::VideoStreamer() {
@@ -17,8 +19,21 @@ namespace ntgcalls {
         return video->createTrack();
     }
 
+    bool VideoStreamer::setConfig(const std::optional<VideoDescription>& desc) {
+        const auto changed = VideoSink::setConfig(desc);
+        if (changed) {
+            // A new source must not be suppressed against the hashes of the previous one
+            resetDetector = true;
+        }
+        return changed;
+    }
+
     void VideoStreamer::sendData(uint8_t* sample, const size_t size, wrtc::FrameData additionalData) {
+        WRTC_TRACE_SCOPE("video_streamer");
         frames++;
+        if (resetDetector.exchange(false)) {
+            staticDetector.reset();
+        }
         if (additionalData.width == 0) {
             additionalData.width = description->width;
         }
@@ -28,6 +43,20 @@ namespace ntgcalls {
         if (additionalData.width == 0 || additionalData.height == 0 || size == 0) {
             return;
         }
+        if (description->staticRefreshMs > 0 && staticDetector.isStatic(
+            additionalData.buffer ? additionalData.buffer->DataY() : sample,
+            additionalData.width,
+            additionalData.height,
+            std::chrono::milliseconds(description->staticRefreshMs)
+        )) {
+            suppressed++;
+            wrtc::metrics::droppedVideoFrames.add();
+            return;
+        }
+        if (additionalData.buffer) {
+            video->OnFrame(additionalData.buffer, additionalData);
+            return;
+        }
         video->OnFrame(
             wrtc::i420ImageData(
                 additionalData.width,
@@ -38,5 +67,9 @@ namespace ntgcalls {
             additionalData
         );
     }
+
+    uint64_t VideoStreamer::suppressedFrames() const {
+        return suppressed;
+    }
 }
 
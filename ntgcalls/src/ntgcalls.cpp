@@ -2,6 +2,9 @@
 // Created by Laky64 on 22/08/2023.
 //
 
+#include <fstream>
+#include <condition_variable>
+#include <ranges>
 #include <ntgcalls/ntgcalls.hpp>
 #include <ntgcalls/exceptions.hpp>
 #include <ntgcalls/devices/media_device.hpp>
@@ -10,12 +13,26 @@
 #include <ntgcalls/models/dh_config.hpp>
 #include <ntgcalls/utils/g_lib_loop_manager.hpp>
 #include <wrtc/video_factory/video_factory_config.hpp>
+#include <wrtc/interfaces/peer_connection/peer_connection_factory.hpp>
+#include <wrtc/utils/certificate_pool.hpp>
+#include <wrtc/interfaces/batched_udp_socket.hpp>
+#include <wrtc/interfaces/shared_udp_socket.hpp>
+#include <wrtc/utils/metrics.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace ntgcalls {
     NTgCalls::NTgCalls() {
         updateThread = webrtc::Thread::Create();
         updateThread->Start();
         hardwareInfo = std::make_unique<HardwareInfo>();
+        events = std::make_unique<EventDispatcher>(updateThread.get(), [this](const std::vector<EventDispatcher::Event>& batch) {
+            dispatchEvents(batch);
+        });
+        connectionPool = std::make_unique<ConnectionPool>();
+        closers = std::make_unique<WorkerPool>(WorkerPool::DefaultSize(), "ntg-close");
+        snapshots = std::make_unique<SnapshotPublisher>();
+        // Start filling the certificate pool before the first call is created
+        wrtc::CertificatePool::GetOrCreateDefault();
         INIT_ASYNC
 #ifndef IS_ANDROID
         LogSink::GetOrCreate();
@@ -28,13 +45,24 @@ namespace ntgcalls {
 #endif
         std::unique_lock lock(mutex);
         RTC_LOG(LS_VERBOSE) << "Destroying NTgCalls";
-        for (const auto& connection : connections | std::views::values) {
-            connection->stop();
-        }
-        connections.clear();
+        snapshots = nullptr;
+        stopConnections(connections.clear(), std::nullopt);
+        closers = nullptr;
+        std::unique_lock sfuLock(sfuMutex);
+        sfu = nullptr;
+        sfuLock.unlock();
+        connectionPool = nullptr;
         hardwareInfo = nullptr;
         lock.unlock();
         updateThread->Stop();
+        events = nullptr;
+        std::unique_lock ringLock(eventRingMutex);
+        if (eventRing) {
+            // Waiters keep their own reference, they wake up here and free the ring on their way out
+            eventRing->close();
+            eventRing = nullptr;
+        }
+        ringLock.unlock();
         updateThread = nullptr;
         DESTROY_ASYNC
         RTC_LOG(LS_VERBOSE) << "NTgCalls destroyed";
@@ -43,92 +71,107 @@ namespace ntgcalls {
 #endif
     }
 
-    void NTgCalls::setupListeners(const int64_t chatId) {
-        connections[chatId]->onStreamEnd([this, chatId](const StreamManager::Type &type, const StreamManager::Device &device) {
-            WORKER("onStreamEnd", updateThread, this, chatId, type, device)
-            THREAD_SAFE
-            (void) onEof(chatId, type, device);
-            END_THREAD_SAFE
-            END_WORKER
+    void NTgCalls::setupListeners(const int64_t chatId, const std::shared_ptr<CallInterface>& call) {
+        call->onStreamEnd([this, chatId](const StreamManager::Type &type, const StreamManager::Device &device) {
+            events->push(chatId, EventDispatcher::StreamEnd{type, device});
         });
-        if (connections[chatId]->type() & CallInterface::Type::Group) {
-            SafeCall<GroupCall>(connections[chatId].get())->onUpgrade([this, chatId](const MediaState &state) {
-                WORKER("onUpgrade", updateThread, this, chatId, state)
-                THREAD_SAFE
-                (void) mediaStateCallback(chatId, state);
-                END_THREAD_SAFE
-                END_WORKER
+        if (call->type() & CallInterface::Type::Group) {
+            SafeCall<GroupCall>(call)->onUpgrade([this, chatId](const MediaState &state) {
+                events->push(chatId, EventDispatcher::Upgrade{state});
             });
 
-            SafeCall<GroupCall>(connections[chatId].get())->onRequestedBroadcastPart([this, chatId](const wrtc::SegmentPartRequest &request) {
-                WORKER_NO_LOG(updateThread, this, chatId, request)
-                THREAD_SAFE
-                (void) segmentPartRequestCallback(chatId, request);
-                END_THREAD_SAFE
-                END_WORKER_NO_LOG
+            SafeCall<GroupCall>(call)->onRequestedBroadcastPart([this, chatId](const wrtc::SegmentPartRequest &request) {
+                events->push(chatId, EventDispatcher::BroadcastPart{request});
             });
 
-            SafeCall<GroupCall>(connections[chatId].get())->onRequestedBroadcastTimestamp([this, chatId] {
-                WORKER_NO_LOG(updateThread, this, chatId)
-                THREAD_SAFE
-                (void) broadcastTimestampCallback(chatId);
-                END_THREAD_SAFE
-                END_WORKER_NO_LOG
+            SafeCall<GroupCall>(call)->onRequestedBroadcastTimestamp([this, chatId] {
+                events->push(chatId, EventDispatcher::BroadcastTimestamp{});
             });
         }
-        connections[chatId]->onConnectionChange([this, chatId](const NetworkInfo &state) {
-            WORKER("onConnectionChange", updateThread, this, chatId, state)
-            if (state.kind == NetworkInfo::Kind::Normal) {
-                switch (state.state) {
-                    case NetworkInfo::ConnectionState::Closed:
-                    case NetworkInfo::ConnectionState::Failed:
-                    case NetworkInfo::ConnectionState::Timeout:
-                        remove(chatId);
-                        break;
-                    default:
-                        break;
-                }
-            }
-            THREAD_SAFE
-            (void) connectionChangeCallback(chatId, state);
-            END_THREAD_SAFE
-            END_WORKER
+        call->onConnectionChange([this, chatId](const NetworkInfo &state) {
+            events->push(chatId, EventDispatcher::ConnectionChange{state});
         });
-        connections[chatId]->onFrames([this, chatId] (const StreamManager::Mode mode, const StreamManager::Device device, const std::vector<wrtc::Frame>& frames) {
+        call->onFrames([this, chatId] (const StreamManager::Mode mode, const StreamManager::Device device, const std::vector<wrtc::Frame>& frames) {
             THREAD_SAFE
             (void) framesCallback(chatId, mode, device, frames);
             END_THREAD_SAFE
         });
-        connections[chatId]->onRemoteSourceChange([this, chatId](const RemoteSource &state) {
-            WORKER("onRemoteSourceChange", updateThread, this, chatId, state)
-            THREAD_SAFE
-            (void) remoteSourceCallback(chatId, state);
-            END_THREAD_SAFE
-            END_WORKER
+        call->onRemoteSourceChange([this, chatId](const RemoteSource &state) {
+            events->push(chatId, EventDispatcher::RemoteSourceChange{state});
         });
-        if (connections[chatId]->type() & CallInterface::Type::P2P) {
-            SafeCall<P2PCall>(connections[chatId].get())->onSignalingData([this, chatId](const bytes::binary& data) {
-                WORKER("onSignalingData", updateThread, this, chatId, data)
-                THREAD_SAFE
-                (void) emitCallback(chatId, CAST_BYTES(data));
-                END_THREAD_SAFE
-                END_WORKER
+        if (call->type() & CallInterface::Type::P2P) {
+            SafeCall<P2PCall>(call)->onSignalingData([this, chatId](const bytes::binary& data) {
+                events->push(chatId, EventDispatcher::SignalingData{data});
             });
         }
     }
 
+    void NTgCalls::dispatchEvents(const std::vector<EventDispatcher::Event>& batch) {
+        RTC_LOG(LS_VERBOSE) << "Dispatching " << batch.size() << " events";
+        for (const auto& [chatId, payload] : batch) {
+            const auto* change = std::get_if<EventDispatcher::ConnectionChange>(&payload);
+            if (!change || change->info.kind != NetworkInfo::Kind::Normal) {
+                continue;
+            }
+            switch (change->info.state) {
+                case NetworkInfo::ConnectionState::Closed:
+                case NetworkInfo::ConnectionState::Failed:
+                case NetworkInfo::ConnectionState::Timeout:
+                    // Queued behind the other operations of the chat, so none of them races the teardown
+                    asyncWorkers->strand(chatId)->PostTask([this, chatId = chatId] {
+                        try {
+                            remove(chatId);
+                        } catch (ConnectionNotFound&) {}
+                    });
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (const auto polled = ring()) {
+            polled->push(batch);
+            return;
+        }
+        // The whole batch is delivered under a single GIL acquisition
+        THREAD_SAFE
+        for (const auto& [chatId, payload] : batch) {
+            std::visit([&]<typename T>(const T& event) {
+                if constexpr (std::is_same_v<T, EventDispatcher::StreamEnd>) {
+                    (void) onEof(chatId, event.type, event.device);
+                } else if constexpr (std::is_same_v<T, EventDispatcher::Upgrade>) {
+                    (void) mediaStateCallback(chatId, event.state);
+                } else if constexpr (std::is_same_v<T, EventDispatcher::ConnectionChange>) {
+                    (void) connectionChangeCallback(chatId, event.info);
+                } else if constexpr (std::is_same_v<T, EventDispatcher::SignalingData>) {
+                    (void) emitCallback(chatId, CAST_BYTES(event.data));
+                } else if constexpr (std::is_same_v<T, EventDispatcher::RemoteSourceChange>) {
+                    (void) remoteSourceCallback(chatId, event.source);
+                } else if constexpr (std::is_same_v<T, EventDispatcher::BroadcastPart>) {
+                    (void) segmentPartRequestCallback(chatId, event.request);
+                } else {
+                    (void) broadcastTimestampCallback(chatId);
+                }
+            }, payload);
+        }
+        END_THREAD_SAFE
+    }
+
     ASYNC_RETURN(void) NTgCalls::createP2PCall(const int64_t userId) {
-        SMART_ASYNC(this, userId)
+        STRAND_ASYNC(userId, this, userId)
         CHECK_AND_THROW_IF_EXISTS(userId)
-        std::lock_guard lock(mutex);
-        connections[userId] = std::make_shared<P2PCall>(updateThread.get());
-        setupListeners(userId);
-        SafeCall<P2PCall>(connections[userId].get())->init();
+        const auto call = std::make_shared<P2PCall>(updateThread.get());
+        if (!connections.insert(userId, call)) {
+            RTC_LOG(LS_ERROR) << "Call " << userId << " was created concurrently";
+            throw ConnectionError("Connection cannot be initialized more than once.");
+        }
+        snapshots->add(userId, call);
+        setupListeners(userId, call);
+        call->init();
         END_ASYNC
     }
 
     ASYNC_RETURN(bytes::vector) NTgCalls::initExchange(const int64_t userId, const DhConfig& dhConfig, const std::optional<BYTES(bytes::vector)> &g_a_hash) {
-        SMART_ASYNC(this, userId, dhConfig, g_a_hash = CPP_BYTES(g_a_hash, bytes::vector))
+        STRAND_ASYNC(userId, this, userId, dhConfig, g_a_hash = CPP_BYTES(g_a_hash, bytes::vector))
         const auto result = SafeCall<P2PCall>(safeConnection(userId))->initExchange(dhConfig, g_a_hash);
         THREAD_SAFE
         return CAST_BYTES(result);
@@ -137,99 +180,129 @@ namespace ntgcalls {
     }
 
     ASYNC_RETURN(AuthParams) NTgCalls::exchangeKeys(const int64_t userId, const BYTES(bytes::vector) &g_a_or_b, const int64_t fingerprint) {
-        SMART_ASYNC(this, userId, g_a_or_b = CPP_BYTES(g_a_or_b, bytes::vector), fingerprint)
+        STRAND_ASYNC(userId, this, userId, g_a_or_b = CPP_BYTES(g_a_or_b, bytes::vector), fingerprint)
         return SafeCall<P2PCall>(safeConnection(userId))->exchangeKeys(g_a_or_b, fingerprint);
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::skipExchange(const int64_t userId, const BYTES(bytes::vector) &encryptionKey, const bool isOutgoing) {
-        SMART_ASYNC(this, userId, encryptionKey = CPP_BYTES(encryptionKey, bytes::vector), isOutgoing)
+        STRAND_ASYNC(userId, this, userId, encryptionKey = CPP_BYTES(encryptionKey, bytes::vector), isOutgoing)
         SafeCall<P2PCall>(safeConnection(userId))->skipExchange(encryptionKey, isOutgoing);
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::connectP2P(const int64_t userId, const std::vector<RTCServer>& servers, const std::vector<std::string>& versions, const bool p2pAllowed) {
-        SMART_ASYNC(this, userId, servers, versions, p2pAllowed)
+        STRAND_ASYNC(userId, this, userId, servers, versions, p2pAllowed)
         SafeCall<P2PCall>(safeConnection(userId))->connect(servers, versions, p2pAllowed);
         END_ASYNC
     }
 
     ASYNC_RETURN(std::string) NTgCalls::createCall(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         CHECK_AND_THROW_IF_EXISTS(chatId)
-        std::lock_guard lock(mutex);
-        connections[chatId] = std::make_shared<GroupCall>(updateThread.get());
-        setupListeners(chatId);
-        return SafeCall<GroupCall>(connections[chatId].get())->init();
+        const auto call = std::make_shared<GroupCall>(updateThread.get());
+        if (!connections.insert(chatId, call)) {
+            RTC_LOG(LS_ERROR) << "Call " << chatId << " was created concurrently";
+            throw ConnectionError("Connection cannot be initialized more than once.");
+        }
+        snapshots->add(chatId, call);
+        setupListeners(chatId, call);
+        return call->init(connectionPool->claim());
+        END_ASYNC
+    }
+
+    ASYNC_RETURN(void) NTgCalls::createNullCall(const int64_t chatId, const bool loopback) {
+        STRAND_ASYNC(chatId, this, chatId, loopback)
+        CHECK_AND_THROW_IF_EXISTS(chatId)
+        const auto call = std::make_shared<GroupCall>(updateThread.get());
+        if (!connections.insert(chatId, call)) {
+            RTC_LOG(LS_ERROR) << "Call " << chatId << " was created concurrently";
+            throw ConnectionError("Connection cannot be initialized more than once.");
+        }
+        snapshots->add(chatId, call);
+        setupListeners(chatId, call);
+        call->initNull(loopback ? wrtc::NullTransport::Mode::Loopback : wrtc::NullTransport::Mode::Discard);
         END_ASYNC
     }
 
     ASYNC_RETURN(std::string) NTgCalls::initPresentation(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         return SafeCall<GroupCall>(safeConnection(chatId))->initPresentation();
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::connect(const int64_t chatId, const std::string& params, const bool isPresentation) {
-        SMART_ASYNC(this, chatId, params, isPresentation)
+        STRAND_ASYNC(chatId, this, chatId, params, isPresentation)
         SafeCall<GroupCall>(safeConnection(chatId))->connect(params, isPresentation);
         END_ASYNC
     }
 
     ASYNC_RETURN(uint32_t) NTgCalls::addIncomingVideo(const int64_t chatId, const std::string& endpoint, const std::vector<wrtc::SsrcGroup>& ssrcGroups) {
-        SMART_ASYNC(this, chatId, endpoint, ssrcGroups)
+        STRAND_ASYNC(chatId, this, chatId, endpoint, ssrcGroups)
         return SafeCall<GroupCall>(safeConnection(chatId))->addIncomingVideo(endpoint, ssrcGroups);
         END_ASYNC
     }
 
     ASYNC_RETURN(bool) NTgCalls::removeIncomingVideo(const int64_t chatId, const std::string& endpoint) {
-        SMART_ASYNC(this, chatId, endpoint)
+        STRAND_ASYNC(chatId, this, chatId, endpoint)
         return SafeCall<GroupCall>(safeConnection(chatId))->removeIncomingVideo(endpoint);
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::setStreamSources(const int64_t chatId, const StreamManager::Mode mode, const MediaDescription& media) {
-        SMART_ASYNC(this, chatId, mode, media)
+        STRAND_ASYNC(chatId, this, chatId, mode, media)
         safeConnection(chatId)->setStreamSources(mode, media);
         END_ASYNC
     }
 
     ASYNC_RETURN(bool) NTgCalls::pause(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         return safeConnection(chatId)->pause();
         END_ASYNC
     }
 
     ASYNC_RETURN(bool) NTgCalls::resume(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         return safeConnection(chatId)->resume();
         END_ASYNC
     }
 
     ASYNC_RETURN(bool) NTgCalls::mute(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         return safeConnection(chatId)->mute();
         END_ASYNC
     }
 
     ASYNC_RETURN(bool) NTgCalls::unmute(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         return safeConnection(chatId)->unmute();
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::stop(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         remove(chatId);
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::stopPresentation(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
+        STRAND_ASYNC(chatId, this, chatId)
         SafeCall<GroupCall>(safeConnection(chatId))->stopPresentation(true);
         END_ASYNC
     }
 
+    ASYNC_RETURN(void) NTgCalls::stopAll(const uint32_t timeout) {
+        SMART_ASYNC(this, timeout)
+        auto calls = connections.clear();
+        snapshots->remove(calls);
+        stopConnections(std::move(calls), std::chrono::milliseconds(timeout));
+        END_ASYNC
+    }
+
+    void NTgCalls::enableFastExit(const bool enable) {
+        fastExit = enable;
+    }
+
     void NTgCalls::onStreamEnd(const std::function<void(int64_t, StreamManager::Type, StreamManager::Device)>& callback) {
         std::lock_guard lock(mutex);
         onEof = callback;
@@ -271,61 +344,135 @@ namespace ntgcalls {
     }
 
     ASYNC_RETURN(void) NTgCalls::sendBroadcastTimestamp(int64_t chatId, int64_t timestamp) {
-        SMART_ASYNC(this, chatId, timestamp)
+        STRAND_ASYNC(chatId, this, chatId, timestamp)
         SafeCall<GroupCall>(safeConnection(chatId))->sendBroadcastTimestamp(timestamp);
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::sendBroadcastPart(int64_t chatId, int64_t segmentId, int32_t partId, wrtc::MediaSegment::Part::Status status, const bool qualityUpdate, const std::optional<BYTES(bytes::binary)> &data) {
-        SMART_ASYNC(this, chatId, segmentId, partId, status, qualityUpdate, data = CPP_BYTES(data, bytes::binary))
+        STRAND_ASYNC(chatId, this, chatId, segmentId, partId, status, qualityUpdate, data = CPP_BYTES(data, bytes::binary))
         SafeCall<GroupCall>(safeConnection(chatId))->sendBroadcastPart(segmentId, partId, status, qualityUpdate, data);
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::sendSignalingData(const int64_t chatId, const BYTES(bytes::binary) &msgKey) {
-        SMART_ASYNC(this, chatId, msgKey = CPP_BYTES(msgKey, bytes::binary))
+        STRAND_ASYNC(chatId, this, chatId, msgKey = CPP_BYTES(msgKey, bytes::binary))
         SafeCall<P2PCall>(safeConnection(chatId))->sendSignalingData(msgKey);
         END_ASYNC
     }
 
     ASYNC_RETURN(void) NTgCalls::sendExternalFrame(const int64_t chatId, const StreamManager::Device device, const BYTES(bytes::binary) &data, const wrtc::FrameData frameData) {
-        SMART_ASYNC(this, chatId, device, data = CPP_BYTES(data, bytes::binary), frameData)
+        STRAND_ASYNC(chatId, this, chatId, device, data = CPP_BYTES(data, bytes::binary), frameData)
         safeConnection(chatId)->sendExternalFrame(device, data, frameData);
         END_ASYNC
     }
 
     ASYNC_RETURN(uint64_t) NTgCalls::time(const int64_t chatId, const StreamManager::Mode mode) {
-        SMART_ASYNC(this, chatId, mode)
-        return safeConnection(chatId)->time(mode);
+        INLINE_ASYNC(this, chatId, mode)
+        const auto snapshot = safeSnapshot(chatId);
+        return mode == StreamManager::Mode::Playback ? snapshot.playbackTime : snapshot.captureTime;
         END_ASYNC
     }
 
     ASYNC_RETURN(MediaState) NTgCalls::getState(const int64_t chatId) {
-        SMART_ASYNC(this, chatId)
-        return safeConnection(chatId)->getState();
+        INLINE_ASYNC(this, chatId)
+        return safeSnapshot(chatId).state;
         END_ASYNC
     }
 
     ASYNC_RETURN(wrtc::ConnectionMode) NTgCalls::getConnectionMode(int64_t chatId) {
-        SMART_ASYNC(this, chatId)
-        return safeConnection(chatId)->getConnectionMode();
+        INLINE_ASYNC(this, chatId)
+        return safeSnapshot(chatId).connectionMode;
+        END_ASYNC
+    }
+
+    ASYNC_RETURN(wrtc::CallStats) NTgCalls::getStats(int64_t chatId, bool cached) {
+        STRAND_ASYNC(chatId, this, chatId, cached)
+        return safeConnection(chatId)->getStats(cached);
+        END_ASYNC
+    }
+
+    ASYNC_RETURN(CallLatency) NTgCalls::getLatency(int64_t chatId) {
+        STRAND_ASYNC(chatId, this, chatId)
+        return safeConnection(chatId)->resourceAccount()->latency();
         END_ASYNC
     }
 
     ASYNC_RETURN(double) NTgCalls::cpuUsage() const {
-        SMART_ASYNC(this)
-        return hardwareInfo->getCpuUsage();
+        INLINE_ASYNC(this)
+        return hardwareInfo->getSampledCpuUsage();
         END_ASYNC
     }
 
+    std::optional<CallSnapshot> NTgCalls::getSnapshot(const int64_t chatId) const {
+        if (const auto call = snapshots->find(chatId)) {
+            return call->snapshot();
+        }
+        return std::nullopt;
+    }
+
+    std::map<int64_t, CallSnapshot> NTgCalls::getSnapshots() const {
+        std::map<int64_t, CallSnapshot> result;
+        for (const auto& [chatId, call] : *snapshots->load()) {
+            if (auto snapshot = call->snapshot()) {
+                result.emplace(chatId, *snapshot);
+            }
+        }
+        return result;
+    }
+
+    ResourceUsage NTgCalls::getResourceUsage() const {
+        ResourceUsage usage{ResourceAccount::ResidentBytes(), ResourceAccount::Threads(), {}};
+        for (const auto& [chatId, call] : connections.snapshot()) {
+            const auto& account = call->resourceAccount();
+            usage.calls.push_back({
+                chatId,
+                account->cpuTime(ResourceAccount::Work::Reader),
+                account->cpuTime(ResourceAccount::Work::Mixer),
+                account->cpuTime(ResourceAccount::Work::Encoder),
+                account->cpuTime(ResourceAccount::Work::Decoder),
+                account->bufferedBytes(),
+            });
+        }
+        return usage;
+    }
+
+    std::string NTgCalls::dumpResourceUsage() const {
+        const auto [residentBytes, threads, calls] = getResourceUsage();
+        auto threadList = json::array();
+        for (const auto& [threadId, name, cpuTime] : threads) {
+            threadList.push_back({
+                {"id", threadId},
+                {"name", name},
+                {"cpuTime", cpuTime},
+            });
+        }
+        auto callList = json::array();
+        for (const auto& call : calls) {
+            callList.push_back({
+                {"chatId", call.chatId},
+                {"readerCpuTime", call.readerCpuTime},
+                {"mixerCpuTime", call.mixerCpuTime},
+                {"encoderCpuTime", call.encoderCpuTime},
+                {"decoderCpuTime", call.decoderCpuTime},
+                {"bufferedBytes", call.bufferedBytes},
+            });
+        }
+        return json{
+            {"residentBytes", residentBytes},
+            {"threads", threadList},
+            {"calls", callList},
+        }.dump();
+    }
+
     ASYNC_RETURN(std::map<int64_t, StreamManager::CallInfo>) NTgCalls::calls() {
-        SMART_ASYNC(this)
-        std::lock_guard lock(mutex);
+        INLINE_ASYNC(this)
         std::map<int64_t, StreamManager::CallInfo> statusList;
-        for (const auto& [fst, snd] : connections) {
-            statusList.emplace(fst, StreamManager::CallInfo{
-                snd->status(StreamManager::Mode::Playback),
-                snd->status(StreamManager::Mode::Capture)
+        for (const auto& [chatId, snapshot] : getSnapshots()) {
+            statusList.emplace(chatId, StreamManager::CallInfo{
+                snapshot.playback,
+                snapshot.capture,
+                snapshot.suppressedFrames
             });
         }
         return statusList;
@@ -333,29 +480,73 @@ namespace ntgcalls {
     }
 
     void NTgCalls::remove(const int64_t chatId) {
-        RTC_LOG(LS_VERBOSE) << "Removing call " << chatId << ", Acquiring lock";
-        std::lock_guard lock(mutex);
-        RTC_LOG(LS_VERBOSE) << "Lock acquired, removing call " << chatId;
-        if (!exists(chatId)) {
+        RTC_LOG(LS_VERBOSE) << "Removing call " << chatId;
+        const auto call = connections.extract(chatId);
+        if (!call) {
             RTC_LOG(LS_ERROR) << "Call " << chatId << " not found";
             THROW_CONNECTION_NOT_FOUND(chatId)
         }
-        const auto call = connections.find(chatId);
-        call->second->stop();
-        connections.erase(call);
+        snapshots->remove({{chatId, call}});
+        call->stop();
         RTC_LOG(LS_VERBOSE) << "Call " << chatId << " removed";
     }
 
+    void NTgCalls::stopConnections(std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> calls, const std::optional<std::chrono::milliseconds> timeout) const {
+        if (calls.empty()) {
+            return;
+        }
+        if (fastExit) {
+            RTC_LOG(LS_INFO) << "Abandoning " << calls.size() << " calls on fast exit";
+            for (const auto& call : calls | std::views::values) {
+                call->abandon();
+            }
+            return;
+        }
+        RTC_LOG(LS_INFO) << "Stopping " << calls.size() << " calls";
+        struct Pending {
+            std::mutex mutex;
+            std::condition_variable condition;
+            size_t remaining;
+        };
+        const auto pending = std::make_shared<Pending>();
+        pending->remaining = calls.size();
+        for (auto& [chatId, call] : calls) {
+            closers->strand(chatId)->PostTask([call = std::move(call), pending] {
+                call->stop();
+                std::lock_guard lock(pending->mutex);
+                if (--pending->remaining == 0) {
+                    pending->condition.notify_all();
+                }
+            });
+        }
+        if (!timeout) {
+            // Also waits for the calls a previous stopAll left closing
+            closers->drain();
+            return;
+        }
+        std::unique_lock lock(pending->mutex);
+        if (!pending->condition.wait_for(lock, *timeout, [&] { return pending->remaining == 0; })) {
+            RTC_LOG(LS_WARNING) << "Stop deadline exceeded, " << pending->remaining << " calls keep closing in the background";
+        }
+    }
+
     bool NTgCalls::exists(const int64_t chatId) const {
         return connections.contains(chatId);
     }
 
-    CallInterface* NTgCalls::safeConnection(const int64_t chatId) {
-        std::lock_guard lock(mutex);
-        if (!exists(chatId)) {
+    std::shared_ptr<CallInterface> NTgCalls::safeConnection(const int64_t chatId) const {
+        auto call = connections.find(chatId);
+        if (!call) {
             THROW_CONNECTION_NOT_FOUND(chatId)
         }
-        return connections[chatId].get();
+        return call;
+    }
+
+    CallSnapshot NTgCalls::safeSnapshot(const int64_t chatId) const {
+        if (auto snapshot = getSnapshot(chatId)) {
+            return *snapshot;
+        }
+        THROW_CONNECTION_NOT_FOUND(chatId)
     }
 
     Protocol NTgCalls::getProtocol() {
@@ -368,6 +559,126 @@ namespace ntgcalls {
         };
     }
 
+    void NTgCalls::configureConnectionPool(const uint32_t size, const uint32_t idleTimeout) {
+        connectionPool->configure(size, std::chrono::seconds(idleTimeout));
+    }
+
+    ConnectionPool::Stats NTgCalls::connectionPoolStats() const {
+        return connectionPool->stats();
+    }
+
+    EventDispatcher::Stats NTgCalls::eventQueueStats() const {
+        return events->stats();
+    }
+
+    int NTgCalls::enableEventPolling(const uint32_t capacity) {
+        std::lock_guard lock(eventRingMutex);
+        if (eventRing) {
+            throw InvalidParams("Event polling is already enabled");
+        }
+        eventRing = std::make_shared<EventRing>(capacity);
+        return eventRing->fd();
+    }
+
+    std::shared_ptr<EventRing> NTgCalls::ring() const {
+        std::lock_guard lock(eventRingMutex);
+        return eventRing;
+    }
+
+    size_t NTgCalls::pollEvents(std::vector<EventDispatcher::Event>& out, const size_t max, uint64_t& dropped) const {
+        const auto polled = ring();
+        if (!polled) {
+            throw InvalidParams("Event polling is not enabled");
+        }
+        return polled->poll(out, max, dropped);
+    }
+
+    size_t NTgCalls::waitEvents(std::vector<EventDispatcher::Event>& out, const size_t max, const std::chrono::milliseconds timeout, uint64_t& dropped) const {
+        const auto polled = ring();
+        if (!polled) {
+            throw InvalidParams("Event polling is not enabled");
+        }
+        return polled->wait(out, max, timeout, dropped);
+    }
+
+    void NTgCalls::setPlayoutThreads(const uint32_t threads) {
+        wrtc::PeerConnectionFactory::GetOrCreateDefault()->playoutMixer()->setThreads(threads);
+    }
+
+    PlayoutStats NTgCalls::getPlayoutStats() {
+        const auto mixer = wrtc::PeerConnectionFactory::GetOrCreateDefault()->playoutMixer();
+        return {
+            static_cast<uint32_t>(mixer->threads()),
+            mixer->ticks(),
+            mixer->lateTicks(),
+        };
+    }
+
+    SocketBatchStats NTgCalls::getSocketBatchStats() {
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+        const auto [readWakeups, packetsReceived, maxReadBatch, sendFlushes, packetsSent, maxSendBatch, gsoSends] = wrtc::BatchedUdpSocket::GetStats();
+        const auto [sharedSockets, sharedHandles, overflowSockets, unroutedPackets] = wrtc::SharedUdpSocketPool::GetStats();
+        return {
+            readWakeups, packetsReceived, maxReadBatch, sendFlushes, packetsSent, maxSendBatch, gsoSends,
+            sharedSockets, sharedHandles, overflowSockets, unroutedPackets,
+        };
+#else
+        return {};
+#endif
+    }
+
+    void NTgCalls::enableTracing(const bool enable, const uint32_t eventsPerThread) {
+        wrtc::Tracer::setEnabled(enable, eventsPerThread);
+    }
+
+    void NTgCalls::exportTrace(const std::string& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw FileError("Unable to open trace file " + path);
+        }
+        file << wrtc::Tracer::exportJson();
+        if (!file) {
+            throw FileError("Unable to write trace file " + path);
+        }
+    }
+
+    std::string NTgCalls::exportMetrics() {
+        return wrtc::Metric::exportText();
+    }
+
+    void NTgCalls::setSharedSockets(const uint32_t socketsPerAddress) {
+        wrtc::PeerConnectionFactory::GetOrCreateDefault()->setSharedSockets(socketsPerAddress);
+    }
+
+    void NTgCalls::configureCertificatePool(const uint32_t size, const uint32_t lifetime) {
+        wrtc::CertificatePool::GetOrCreateDefault()->configure(size, std::chrono::seconds(lifetime));
+    }
+
+    ASYNC_RETURN(std::string) NTgCalls::joinLocalSfu(const std::string& joinPayload) {
+        SMART_ASYNC(this, joinPayload)
+        std::shared_ptr<wrtc::LocalSfu> instance;
+        {
+            std::lock_guard lock(sfuMutex);
+            if (!sfu) {
+                sfu = std::make_shared<wrtc::LocalSfu>();
+            }
+            instance = sfu;
+        }
+        return instance->join(joinPayload);
+        END_ASYNC
+    }
+
+    ASYNC_RETURN(bool) NTgCalls::leaveLocalSfu(const uint32_t ssrc) {
+        SMART_ASYNC(this, ssrc)
+        std::shared_ptr<wrtc::LocalSfu> instance;
+        {
+            std::lock_guard lock(sfuMutex);
+            instance = sfu;
+        }
+        return instance && instance->leave(ssrc);
+        END_ASYNC
+    }
+
 #ifndef IS_ANDROID
     void NTgCalls::enableGlibLoop(const bool enable) {
         GLibLoopManager::EnableEventLoop(enable);
@@ -375,11 +686,11 @@ namespace ntgcalls {
 #endif
 
     template<typename DestCallType, typename BaseCallType>
-    DestCallType* NTgCalls::SafeCall(BaseCallType* call) {
+    DestCallType* NTgCalls::SafeCall(const std::shared_ptr<BaseCallType>& call) {
         if (!call) {
             return nullptr;
         }
-        if (auto* derivedCall = dynamic_cast<DestCallType*>(call)) {
+        if (auto* derivedCall = dynamic_cast<DestCallType*>(call.get())) {
             return derivedCall;
         }
         throw ConnectionError("Invalid call type");
@@ -15,9 +15,13 @@
 #include <ntgcalls/media/video_sink.hpp>
 #include <ntgcalls/media/video_streamer.hpp>
 #include <rtc_base/logging.h>
+#include <wrtc/utils/tracer.hpp>
 
 namespace ntgcalls {
-    StreamManager::StreamManager(webrtc::Thread* workerThread): workerThread(workerThread) {}
+    StreamManager::StreamManager(webrtc::Thread* workerThread, std::shared_ptr<ResourceAccount> account): workerThread(workerThread), account(std::move(account)) {
+        std::lock_guard lock(mutex);
+        publish();
+    }
 
     void StreamManager::close() {
         std::lock_guard lock(mutex);
@@ -26,6 +30,7 @@ namespace ntgcalls {
         onEOF = nullptr;
         framesCallback = nullptr;
         onChangeStatus = nullptr;
+        publishCallback = nullptr;
         for (const auto& reader : readers | std::views::values) {
             reader->onData(nullptr);
             reader->onEof(nullptr);
@@ -41,6 +46,7 @@ namespace ntgcalls {
         }
         streams.clear();
         tracks.clear();
+        publish();
         workerThread = nullptr;
     }
 
@@ -54,19 +60,25 @@ namespace ntgcalls {
         RTC_LOG(LS_VERBOSE) << "Setting Configuration, Lock acquired";
 
         const bool wasIdling = isPaused();
-
-        maybeReconfigureDevice<AudioSink, AudioDescription>(mode, Microphone, desc.microphone);
-        maybeReconfigureDevice<AudioSink, AudioDescription>(mode, Speaker, desc.speaker);
-
         const bool wasCamera = hasDeviceInternal(mode, Camera);
         const bool wasScreen = hasDeviceInternal(mode, Screen);
 
-        if (!videoSimulcast && desc.camera && desc.screen && mode == Capture) {
-            throw InvalidParams("Cannot mix camera and screen sources");
-        }
+        try {
+            maybeReconfigureDevice<AudioSink, AudioDescription>(mode, Microphone, desc.microphone);
+            maybeReconfigureDevice<AudioSink, AudioDescription>(mode, Speaker, desc.speaker);
 
-        maybeReconfigureDevice<VideoSink, VideoDescription>(mode, Camera, desc.camera);
-        maybeReconfigureDevice<VideoSink, VideoDescription>(mode, Screen, desc.screen);
+            if (!videoSimulcast && desc.camera && desc.screen && mode == Capture) {
+                throw InvalidParams("Cannot mix camera and screen sources");
+            }
+
+            maybeReconfigureDevice<VideoSink, VideoDescription>(mode, Camera, desc.camera);
+            maybeReconfigureDevice<VideoSink, VideoDescription>(mode, Screen, desc.screen);
+        } catch (...) {
+            // Whatever was reconfigured before the failure is still visible to the getters
+            publish();
+            throw;
+        }
+        publish();
 
         if (mode == Capture && (wasCamera != hasDeviceInternal(mode, Camera) || wasScreen != hasDeviceInternal(mode, Screen) || wasIdling) && initialized) {
             checkUpgrade();
@@ -81,7 +93,10 @@ namespace ntgcalls {
     }
 
     MediaState StreamManager::getState() {
-        std::lock_guard lock(mutex);
+        return published.load()->state;
+    }
+
+    MediaState StreamManager::currentState() {
         bool muted = false;
         for (const auto& [key, track] : tracks) {
             if (key.first != Capture) {
@@ -118,14 +133,35 @@ namespace ntgcalls {
     }
 
     uint64_t StreamManager::time(const Mode mode) {
-        std::lock_guard lock(mutex);
+        return published.load()->time(mode);
+    }
+
+    StreamManager::Status StreamManager::status(const Mode mode) {
+        const auto current = published.load();
+        return mode == Capture ? current->capture : current->playback;
+    }
+
+    uint64_t StreamManager::suppressedFrames() {
+        return published.load()->suppressedFrames();
+    }
+
+    std::shared_ptr<const StreamManager::Snapshot> StreamManager::snapshot() const {
+        return published.load();
+    }
+
+    void StreamManager::onPublish(const std::function<void(std::shared_ptr<const Snapshot>)>& callback) {
+        publishCallback = callback;
+    }
+
+    uint64_t StreamManager::Snapshot::time(const Mode mode) const {
         uint64_t averageTime = 0;
         int count = 0;
-        for (const auto& [key, stream] : streams) {
-            if (stream->time() == 0 || key.first != mode) {
+        for (const auto& [sinkMode, sink] : sinks) {
+            const auto sinkTime = sink->time();
+            if (sinkTime == 0 || sinkMode != mode) {
                 continue;
             }
-            averageTime += stream->time();
+            averageTime += sinkTime;
             count++;
         }
         if (count == 0) {
@@ -134,12 +170,30 @@ namespace ntgcalls {
         return averageTime / count;
     }
 
-    StreamManager::Status StreamManager::status(const Mode mode) {
-        std::lock_guard lock(mutex);
-        if (mode == Capture) {
-            return readers.empty() ? Idling : isPaused() ? Paused : Active;
+    uint64_t StreamManager::Snapshot::suppressedFrames() const {
+        uint64_t total = 0;
+        for (const auto& [sinkMode, sink] : sinks) {
+            if (sinkMode != Capture) {
+                continue;
+            }
+            if (const auto videoStreamer = dynamic_cast<VideoStreamer*>(sink.get())) {
+                total += videoStreamer->suppressedFrames();
+            }
         }
-        return writers.empty() ? Idling : Active;
+        return total;
+    }
+
+    void StreamManager::publish() {
+        auto current = std::make_shared<Snapshot>();
+        current->state = currentState();
+        current->capture = readers.empty() ? Idling : isPaused() ? Paused : Active;
+        current->playback = writers.empty() ? Idling : Active;
+        current->sinks.reserve(streams.size());
+        for (const auto& [key, stream] : streams) {
+            current->sinks.emplace_back(key.first, stream);
+        }
+        published.store(current);
+        (void) publishCallback(std::move(current));
     }
 
     void StreamManager::onStreamEnd(const std::function<void(Type, Device)>& callback) {
@@ -193,6 +247,7 @@ namespace ntgcalls {
             throw InvalidParams("External source not initialized");
         }
         if (const auto stream = dynamic_cast<BaseStreamer*>(streams[id].get())) {
+            ResourceAccount::Scope scope(account, ResourceAccount::Work::Encoder);
             const auto uniqueData = bytes::make_unique_binary(data.size());
             memcpy(uniqueData.get(), data.data(), data.size());
             stream->sendData(uniqueData.get(), data.size(), frameData);
@@ -209,6 +264,7 @@ namespace ntgcalls {
             changed |= track->set_enabled(!isMuted);
         }
         if (changed) {
+            publish();
             checkUpgrade();
         }
         return changed;
@@ -229,6 +285,7 @@ namespace ntgcalls {
                     }
                 }
             }
+            publish();
             checkUpgrade();
         }
         return changed;
@@ -310,12 +367,14 @@ namespace ntgcalls {
                 } else {
                     streams[id] = std::make_unique<VideoStreamer>();
                 }
+                streams[id]->setAccount(account);
             } else {
                 if (streamType == Audio) {
                     streams[id] = std::make_unique<AudioReceiver>();
                 } else {
                     streams[id] = std::make_unique<VideoReceiver>();
                 }
+                streams[id]->setAccount(account);
                 dynamic_cast<BaseReceiver*>(streams[id].get())->open();
             }
         }
@@ -434,20 +493,37 @@ namespace ntgcalls {
             if (strong->streams.contains(id)) {
                 const auto frameSize = strong->streams[id]->frameSize();
                 if (const auto stream = dynamic_cast<BaseStreamer*>(strong->streams[id].get())) {
-                    frameData.absoluteCaptureTimestampMs = webrtc::TimeMillis();
+                    ResourceAccount::Scope scope(strong->account, ResourceAccount::Work::Encoder);
+                    const uint8_t* sample = frameData.buffer ? frameData.buffer->DataY() : data.get();
+                    // Capture time of the source is kept, only sources without one are stamped here
+                    if (frameData.absoluteCaptureTimestampMs == 0) {
+                        frameData.absoluteCaptureTimestampMs = webrtc::TimeMillis();
+                    }
+                    if (frameData.producedAtUs == 0) {
+                        frameData.producedAtUs = webrtc::TimeMicros();
+                    }
                     if (streamType == Video && isShared) {
+                        WRTC_TRACE_SCOPE("frames_callback");
                         (void) strong->framesCallback(
                             id.first,
                             id.second,
                             {
                                 {
                                     0,
-                                    {data.get(), data.get() + frameSize},
+                                    {sample, sample + frameSize},
                                     frameData
                                 }
                             }
                         );
                     }
+                    // Only the main connection reports sent frames, the presentation one carries screen and speaker
+                    if (strong->account && (id.second == Microphone || id.second == Camera)) {
+                        strong->account->sendStarted(
+                            streamType == Audio ? ResourceAccount::Path::AudioSend : ResourceAccount::Path::VideoSend,
+                            frameData.absoluteCaptureTimestampMs,
+                            frameData.producedAtUs
+                        );
+                    }
                     stream->sendData(data.get(), frameSize, frameData);
                 }
             }
@@ -465,6 +541,7 @@ namespace ntgcalls {
                 }
                 std::lock_guard lock(strongThread->mutex);
                 strongThread->removeReader(device);
+                strongThread->publish();
                 (void) strongThread->onEOF(getStreamType(device), device);
             });
         });
@@ -523,6 +600,10 @@ namespace ntgcalls {
                         });
                     }
                 }
+                if (externalFrames.empty()) {
+                    return;
+                }
+                WRTC_TRACE_SCOPE("frames_callback");
                 (void) strong->framesCallback(
                     id.first,
                     id.second,
@@ -546,6 +627,7 @@ namespace ntgcalls {
                 return;
             }
             if (strong->externalWriters.contains(id.second)) {
+                WRTC_TRACE_SCOPE("frames_callback");
                 (void) strong->framesCallback(
                     id.first,
                     id.second,
@@ -0,0 +1,65 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/awaitable.hpp>
+
+#include <ranges>
+
+#if !defined(PYTHON_ENABLED) && !IS_ANDROID
+namespace ntgcalls {
+    Executor threadExecutor(webrtc::Thread* thread) {
+        return [thread](std::function<void()> task) {
+            thread->PostTask(std::move(task));
+        };
+    }
+
+    void CancellationToken::cancel() const {
+        std::map<uint64_t, std::function<void()>> callbacks;
+        {
+            std::lock_guard lock(state->mutex);
+            if (state->cancelled) {
+                return;
+            }
+            state->cancelled = true;
+            callbacks = std::move(state->callbacks);
+        }
+        for (const auto& callback : callbacks | std::views::values) {
+            callback();
+        }
+    }
+
+    bool CancellationToken::cancelled() const {
+        std::lock_guard lock(state->mutex);
+        return state->cancelled;
+    }
+
+    uint64_t CancellationToken::subscribe(std::function<void()> callback) const {
+        {
+            std::lock_guard lock(state->mutex);
+            if (!state->cancelled) {
+                const auto id = state->nextId++;
+                state->callbacks.emplace(id, std::move(callback));
+                return id;
+            }
+        }
+        callback();
+        return 0;
+    }
+
+    void CancellationToken::unsubscribe(const uint64_t id) const {
+        std::lock_guard lock(state->mutex);
+        state->callbacks.erase(id);
+    }
+
+    void detail::scheduleTimeout(const std::chrono::milliseconds delay, std::function<void()> callback) {
+        static auto* timers = [] {
+            auto thread = webrtc::Thread::Create();
+            thread->SetName("ntg-timeout", nullptr);
+            thread->Start();
+            return thread.release();
+        }();
+        timers->PostDelayedTask(std::move(callback), webrtc::TimeDelta::Millis(delay.count()));
+    }
+} // ntgcalls
+#endif
@@ -0,0 +1,148 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <rtc_base/logging.h>
+#include <ntgcalls/utils/connection_pool.hpp>
+
+namespace ntgcalls {
+    ConnectionPool::ConnectionPool() {
+        thread = webrtc::Thread::Create();
+        thread->SetName("ntg-pool", nullptr);
+        thread->Start();
+    }
+
+    ConnectionPool::~ConnectionPool() {
+        {
+            std::lock_guard lock(mutex);
+            targetSize = 0;
+        }
+        thread->Stop();
+        std::vector<std::shared_ptr<wrtc::GroupConnection>> connections;
+        for (auto& [connection, createdAt] : ready) {
+            connections.push_back(std::move(connection));
+        }
+        ready.clear();
+        closeAll(connections);
+    }
+
+    void ConnectionPool::configure(const uint32_t size, const std::chrono::seconds idleTimeout) {
+        std::vector<std::shared_ptr<wrtc::GroupConnection>> removed;
+        {
+            std::lock_guard lock(mutex);
+            targetSize = size;
+            this->idleTimeout = idleTimeout;
+            while (ready.size() > targetSize) {
+                removed.push_back(std::move(ready.back().connection));
+                ready.pop_back();
+            }
+            scheduleRefill();
+        }
+        closeAll(removed);
+    }
+
+    std::shared_ptr<wrtc::GroupConnection> ConnectionPool::claim() {
+        std::shared_ptr<wrtc::GroupConnection> connection;
+        std::vector<std::shared_ptr<wrtc::GroupConnection>> expired;
+        {
+            std::lock_guard lock(mutex);
+            if (targetSize == 0) {
+                return nullptr;
+            }
+            expired = takeExpired();
+            if (!ready.empty()) {
+                connection = std::move(ready.front().connection);
+                ready.pop_front();
+            }
+            scheduleRefill();
+        }
+        closeAll(expired);
+        if (connection) {
+            ++hits;
+        } else {
+            ++misses;
+            RTC_LOG(LS_WARNING) << "Connection pool empty, opening a new connection";
+        }
+        return connection;
+    }
+
+    ConnectionPool::Stats ConnectionPool::stats() {
+        std::lock_guard lock(mutex);
+        return {
+            static_cast<uint32_t>(ready.size()),
+            hits,
+            misses,
+        };
+    }
+
+    std::vector<std::shared_ptr<wrtc::GroupConnection>> ConnectionPool::takeExpired() {
+        std::vector<std::shared_ptr<wrtc::GroupConnection>> expired;
+        if (idleTimeout.count() == 0) {
+            return expired;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        while (!ready.empty() && now - ready.front().createdAt >= idleTimeout) {
+            expired.push_back(std::move(ready.front().connection));
+            ready.pop_front();
+        }
+        return expired;
+    }
+
+    void ConnectionPool::scheduleRefill() {
+        if (refilling || ready.size() >= targetSize) {
+            return;
+        }
+        refilling = true;
+        thread->PostTask([this] {
+            refill();
+        });
+    }
+
+    void ConnectionPool::scheduleExpiry() {
+        if (expiryScheduled || targetSize == 0 || idleTimeout.count() == 0) {
+            return;
+        }
+        expiryScheduled = true;
+        thread->PostDelayedTask([this] {
+            std::vector<std::shared_ptr<wrtc::GroupConnection>> expired;
+            {
+                std::lock_guard lock(mutex);
+                expiryScheduled = false;
+                expired = takeExpired();
+                scheduleRefill();
+                scheduleExpiry();
+            }
+            closeAll(expired);
+        }, webrtc::TimeDelta::Seconds(idleTimeout.count()));
+    }
+
+    void ConnectionPool::refill() {
+        while (true) {
+            {
+                std::lock_guard lock(mutex);
+                if (ready.size() >= targetSize) {
+                    refilling = false;
+                    scheduleExpiry();
+                    return;
+                }
+            }
+            auto connection = std::make_shared<wrtc::GroupConnection>(false);
+            try {
+                connection->open();
+            } catch (std::exception& e) {
+                RTC_LOG(LS_ERROR) << "Unable to pre-open connection: " << e.what();
+                std::lock_guard lock(mutex);
+                refilling = false;
+                return;
+            }
+            std::lock_guard lock(mutex);
+            ready.push_back({std::move(connection), std::chrono::steady_clock::now()});
+        }
+    }
+
+    void ConnectionPool::closeAll(const std::vector<std::shared_ptr<wrtc::GroupConnection>>& connections) {
+        for (const auto& connection : connections) {
+            connection->close();
+        }
+    }
+} // ntgcalls
@@ -0,0 +1,68 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/connection_table.hpp>
+
+#include <ranges>
+
+namespace ntgcalls {
+    size_t ConnectionTable::indexOf(const int64_t chatId) {
+        return (static_cast<uint64_t>(chatId) * 0x9E3779B97F4A7C15ULL >> 32) % kShards;
+    }
+
+    ConnectionTable::Shard& ConnectionTable::shardOf(const int64_t chatId) {
+        return shards[indexOf(chatId)];
+    }
+
+    const ConnectionTable::Shard& ConnectionTable::shardOf(const int64_t chatId) const {
+        return shards[indexOf(chatId)];
+    }
+
+    bool ConnectionTable::contains(const int64_t chatId) const {
+        const auto& shard = shardOf(chatId);
+        std::shared_lock lock(shard.mutex);
+        return shard.calls.contains(chatId);
+    }
+
+    std::shared_ptr<CallInterface> ConnectionTable::find(const int64_t chatId) const {
+        const auto& shard = shardOf(chatId);
+        std::shared_lock lock(shard.mutex);
+        const auto it = shard.calls.find(chatId);
+        return it != shard.calls.end() ? it->second : nullptr;
+    }
+
+    bool ConnectionTable::insert(const int64_t chatId, std::shared_ptr<CallInterface> call) {
+        auto& shard = shardOf(chatId);
+        std::unique_lock lock(shard.mutex);
+        return shard.calls.try_emplace(chatId, std::move(call)).second;
+    }
+
+    std::shared_ptr<CallInterface> ConnectionTable::extract(const int64_t chatId) {
+        auto& shard = shardOf(chatId);
+        std::unique_lock lock(shard.mutex);
+        auto node = shard.calls.extract(chatId);
+        return node ? std::move(node.mapped()) : nullptr;
+    }
+
+    std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> ConnectionTable::clear() {
+        std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> calls;
+        for (auto& shard : shards) {
+            std::unique_lock lock(shard.mutex);
+            for (auto& [chatId, call] : shard.calls) {
+                calls.emplace_back(chatId, std::move(call));
+            }
+            shard.calls.clear();
+        }
+        return calls;
+    }
+
+    std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> ConnectionTable::snapshot() const {
+        std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>> calls;
+        for (const auto& shard : shards) {
+            std::shared_lock lock(shard.mutex);
+            calls.insert(calls.end(), shard.calls.begin(), shard.calls.end());
+        }
+        return calls;
+    }
+} // ntgcalls
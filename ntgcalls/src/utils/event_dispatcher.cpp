@@ -0,0 +1,157 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/event_dispatcher.hpp>
+#include <rtc_base/logging.h>
+#include <wrtc/utils/metrics.hpp>
+
+namespace ntgcalls {
+    EventDispatcher::EventDispatcher(webrtc::Thread* thread, std::function<void(const std::vector<Event>&)> deliver):
+        thread(thread), deliver(std::move(deliver)), ring(kCapacity), index(2 * kCapacity) {
+        batch.reserve(kCapacity);
+    }
+
+    EventDispatcher::~EventDispatcher() {
+        std::lock_guard lock(mutex);
+        wrtc::metrics::eventQueueDepth.add(-static_cast<int64_t>(count - stale));
+    }
+
+    void EventDispatcher::push(const int64_t chatId, Payload payload) {
+        const auto key = coalescingKey(chatId, payload);
+        std::lock_guard lock(mutex);
+        bool replaced = false;
+        if (key) {
+            // Only the latest state matters, the queued one is discarded and the new one goes to the tail
+            // so it is never delivered ahead of the events pushed in between
+            if (const auto& slot = findSlot(*key); slot.generation == generation) {
+                ring[slot.position].reset();
+                stale++;
+                coalesced++;
+                replaced = true;
+            }
+        }
+        if (count == ring.size()) {
+            if (stale != 0) {
+                rebuild(ring.size());
+            } else if (key) {
+                dropped++;
+                if (!overflowLogged) {
+                    overflowLogged = true;
+                    RTC_LOG(LS_WARNING) << "Event queue full, dropping state updates until the update thread catches up";
+                }
+                return;
+            } else {
+                RTC_LOG(LS_WARNING) << "Event queue full, growing it to " << ring.size() * 2 << " events";
+                rebuild(ring.size() * 2);
+            }
+        }
+        const auto position = (head + count) % ring.size();
+        ring[position] = Event{chatId, std::move(payload)};
+        count++;
+        if (key) {
+            findSlot(*key) = {*key, position, generation};
+        }
+        if (!replaced) {
+            wrtc::metrics::eventQueueDepth.add(1);
+        }
+        maxDepth = std::max(maxDepth, static_cast<uint32_t>(count - stale));
+        if (!flushScheduled) {
+            flushScheduled = true;
+            thread->PostTask([this] {
+                flush();
+            });
+        }
+    }
+
+    EventDispatcher::Stats EventDispatcher::stats() {
+        std::lock_guard lock(mutex);
+        const Stats result{
+            static_cast<uint32_t>(count - stale),
+            maxDepth,
+            batches,
+            delivered,
+            coalesced,
+            dropped,
+        };
+        maxDepth = static_cast<uint32_t>(count - stale);
+        return result;
+    }
+
+    bool EventDispatcher::IsLatestState(const Payload& payload) {
+        return coalescingKey(0, payload).has_value();
+    }
+
+    std::optional<EventDispatcher::Key> EventDispatcher::coalescingKey(const int64_t chatId, const Payload& payload) {
+        if (const auto* change = std::get_if<ConnectionChange>(&payload)) {
+            return std::make_tuple(payload.index(), chatId, static_cast<int64_t>(change->info.kind));
+        }
+        if (const auto* change = std::get_if<RemoteSourceChange>(&payload)) {
+            return std::make_tuple(payload.index(), chatId, static_cast<int64_t>(change->source.ssrc) << 8 | static_cast<int64_t>(change->source.device));
+        }
+        if (std::holds_alternative<Upgrade>(payload) || std::holds_alternative<BroadcastTimestamp>(payload)) {
+            return std::make_tuple(payload.index(), chatId, 0);
+        }
+        return std::nullopt;
+    }
+
+    EventDispatcher::IndexSlot& EventDispatcher::findSlot(const Key& key) {
+        const auto& [type, chatId, detail] = key;
+        auto hash = static_cast<uint64_t>(chatId) * 0x9e3779b97f4a7c15ULL;
+        hash ^= (static_cast<uint64_t>(detail) + (type << 56)) * 0xc2b2ae3d27d4eb4fULL;
+        hash ^= hash >> 29;
+        // Never more live keys than ring slots, so an empty slot is always reached
+        const auto mask = index.size() - 1;
+        for (auto position = static_cast<size_t>(hash) & mask;; position = (position + 1) & mask) {
+            if (auto& slot = index[position]; slot.generation != generation || slot.key == key) {
+                return slot;
+            }
+        }
+    }
+
+    void EventDispatcher::rebuild(const size_t capacity) {
+        std::vector<std::optional<Event>> events(capacity);
+        size_t live = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (auto& event = ring[(head + i) % ring.size()]) {
+                events[live++] = std::move(event);
+            }
+        }
+        ring = std::move(events);
+        head = 0;
+        count = live;
+        stale = 0;
+        if (index.size() < 2 * capacity) {
+            index.assign(2 * capacity, {});
+        }
+        generation++;
+        for (size_t position = 0; position < count; position++) {
+            if (const auto key = coalescingKey(ring[position]->chatId, ring[position]->payload)) {
+                findSlot(*key) = {*key, position, generation};
+            }
+        }
+    }
+
+    void EventDispatcher::flush() {
+        {
+            std::lock_guard lock(mutex);
+            for (size_t i = 0; i < count; i++) {
+                if (auto& event = ring[(head + i) % ring.size()]) {
+                    batch.push_back(std::move(*event));
+                    event.reset();
+                }
+            }
+            head = (head + count) % ring.size();
+            count = 0;
+            stale = 0;
+            generation++;
+            flushScheduled = false;
+            overflowLogged = false;
+            batches++;
+            delivered += batch.size();
+            wrtc::metrics::eventQueueDepth.add(-static_cast<int64_t>(batch.size()));
+        }
+        deliver(batch);
+        batch.clear();
+    }
+} // ntgcalls
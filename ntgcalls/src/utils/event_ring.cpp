@@ -0,0 +1,133 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/event_ring.hpp>
+#include <rtc_base/logging.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace ntgcalls {
+    EventRing::EventRing(const size_t capacity): slots(std::max<size_t>(capacity, 1)), capacity(slots.size()) {
+#ifdef __linux__
+        eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (eventFd < 0) {
+            RTC_LOG(LS_WARNING) << "Unable to create eventfd, polling only";
+        }
+#endif
+    }
+
+    EventRing::~EventRing() {
+#ifdef __linux__
+        if (eventFd >= 0) {
+            ::close(eventFd);
+        }
+#endif
+    }
+
+    void EventRing::push(const std::vector<EventDispatcher::Event>& batch) {
+        bool wakeUp;
+        size_t lost = 0;
+        {
+            std::lock_guard lock(mutex);
+            if (closed) {
+                return;
+            }
+            const bool wasEmpty = count == 0 && dropped == 0;
+            for (const auto& event : batch) {
+                if (count >= capacity && EventDispatcher::IsLatestState(event.payload)) {
+                    lost++;
+                    continue;
+                }
+                if (count == slots.size()) {
+                    std::vector<EventDispatcher::Event> grown(slots.size() * 2);
+                    for (size_t i = 0; i < count; i++) {
+                        grown[i] = std::move(slots[(head + i) % slots.size()]);
+                    }
+                    slots = std::move(grown);
+                    head = 0;
+                }
+                slots[(head + count) % slots.size()] = event;
+                count++;
+            }
+            dropped += lost;
+            wakeUp = wasEmpty && !batch.empty();
+        }
+        if (lost) {
+            RTC_LOG(LS_WARNING) << "Event ring full, " << lost << " state updates dropped";
+        }
+        if (wakeUp) {
+            wakeup();
+        }
+    }
+
+    void EventRing::wakeup() {
+        cv.notify_all();
+#ifdef __linux__
+        if (eventFd >= 0) {
+            constexpr uint64_t one = 1;
+            (void) write(eventFd, &one, sizeof(one));
+        }
+#endif
+    }
+
+    size_t EventRing::drain(std::vector<EventDispatcher::Event>& out, const size_t max, uint64_t& lost) {
+        lost = 0;
+        if (closed) {
+            return 0;
+        }
+        lost = dropped;
+        dropped = 0;
+        const auto n = std::min(max, count);
+        for (size_t i = 0; i < n; i++) {
+            out.push_back(std::move(slots[head]));
+            head = (head + 1) % slots.size();
+        }
+        count -= n;
+#ifdef __linux__
+        if (count == 0 && slots.size() > capacity) {
+            // Give back what a burst of one-shot events grew
+            slots = std::vector<EventDispatcher::Event>(capacity);
+            head = 0;
+        }
+        if (count == 0 && eventFd >= 0) {
+            uint64_t value;
+            (void) read(eventFd, &value, sizeof(value));
+        }
+#endif
+        return n;
+    }
+
+    size_t EventRing::poll(std::vector<EventDispatcher::Event>& out, const size_t max, uint64_t& lost) {
+        std::lock_guard lock(mutex);
+        return drain(out, max, lost);
+    }
+
+    size_t EventRing::wait(std::vector<EventDispatcher::Event>& out, const size_t max, const std::chrono::milliseconds timeout, uint64_t& lost) {
+        std::unique_lock lock(mutex);
+        cv.wait_for(lock, timeout, [this] {
+            return count > 0 || dropped > 0 || closed;
+        });
+        return drain(out, max, lost);
+    }
+
+    void EventRing::close() {
+        {
+            std::lock_guard lock(mutex);
+            if (closed) {
+                return;
+            }
+            closed = true;
+            count = 0;
+            dropped = 0;
+        }
+        wakeup();
+    }
+
+    int EventRing::fd() const {
+        return eventFd;
+    }
+} // ntgcalls
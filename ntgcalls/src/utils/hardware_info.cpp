@@ -2,6 +2,7 @@
 // Created by Laky64 on 02/03/2024.
 //
 
+#include <chrono>
 #include <ntgcalls/utils/hardware_info.hpp>
 
 #if defined(IS_LINUX) || defined(IS_ANDROID)
@@ -92,6 +93,18 @@ namespace ntgcalls {
         return percent;
     }
 
+    double HardwareInfo::getSampledCpuUsage() {
+        using namespace std::chrono;
+        const auto now = duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+        if (now - sampledAt.load(std::memory_order_acquire) >= 1000) {
+            if (std::unique_lock lock(sampleMutex, std::try_to_lock); lock.owns_lock() && now - sampledAt.load(std::memory_order_relaxed) >= 1000) {
+                sampledUsage.store(getCpuUsage(), std::memory_order_relaxed);
+                sampledAt.store(now, std::memory_order_release);
+            }
+        }
+        return sampledUsage.load(std::memory_order_relaxed);
+    }
+
     uint16_t HardwareInfo::getCoreCount() const {
         return numProcessors;
     }
@@ -0,0 +1,73 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/latency_histogram.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace ntgcalls {
+    void LatencyHistogram::record(const int64_t value) {
+        const auto clamped = std::clamp<int64_t>(value, 0, kMaxValue);
+        counts[index(clamped)].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(clamped, std::memory_order_relaxed);
+        auto current = minValue.load(std::memory_order_relaxed);
+        while (clamped < current && !minValue.compare_exchange_weak(current, clamped, std::memory_order_relaxed)) {}
+        current = maxValue.load(std::memory_order_relaxed);
+        while (clamped > current && !maxValue.compare_exchange_weak(current, clamped, std::memory_order_relaxed)) {}
+    }
+
+    LatencySummary LatencyHistogram::summary() const {
+        std::array<uint64_t, kBuckets> snapshot{};
+        uint64_t total = 0;
+        for (size_t i = 0; i < kBuckets; i++) {
+            snapshot[i] = counts[i].load(std::memory_order_relaxed);
+            total += snapshot[i];
+        }
+        if (total == 0) {
+            return {};
+        }
+        const auto min = minValue.load(std::memory_order_relaxed);
+        const auto max = maxValue.load(std::memory_order_relaxed);
+        const auto percentile = [&](const double p) {
+            const auto target = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total))), 1);
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBuckets; i++) {
+                seen += snapshot[i];
+                if (seen >= target) {
+                    return std::clamp(highestEquivalent(i), min, max);
+                }
+            }
+            return max;
+        };
+        return {
+            total,
+            min,
+            static_cast<int64_t>(sum.load(std::memory_order_relaxed) / total),
+            max,
+            percentile(50),
+            percentile(90),
+            percentile(99),
+            percentile(99.9),
+        };
+    }
+
+    size_t LatencyHistogram::index(const uint64_t value) {
+        if (value < kSubBuckets) {
+            return value;
+        }
+        const auto shift = std::bit_width(value) - 1 - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+    }
+
+    int64_t LatencyHistogram::highestEquivalent(const size_t index) {
+        if (index < kSubBuckets) {
+            return static_cast<int64_t>(index);
+        }
+        const auto shift = index / kSubBuckets - 1;
+        const auto subBucket = index % kSubBuckets + kSubBuckets;
+        return static_cast<int64_t>(((subBucket + 1) << shift) - 1);
+    }
+} // ntgcalls
@@ -0,0 +1,136 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/resource_account.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef IS_WINDOWS
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ntgcalls {
+    ResourceAccount::Scope::Scope(const std::shared_ptr<ResourceAccount>& account, const Work work): account(account.get()), work(work) {
+        if (this->account) {
+            start = ThreadCpuTime();
+        }
+    }
+
+    ResourceAccount::Scope::~Scope() {
+        if (account) {
+            account->cpu[static_cast<size_t>(work)] += static_cast<uint64_t>(std::max<int64_t>(ThreadCpuTime() - start, 0));
+        }
+    }
+
+    void ResourceAccount::addBuffered(const int64_t bytes) {
+        buffered += bytes;
+    }
+
+    uint64_t ResourceAccount::cpuTime(const Work work) const {
+        return cpu[static_cast<size_t>(work)] / 1000;
+    }
+
+    int64_t ResourceAccount::bufferedBytes() const {
+        return buffered;
+    }
+
+    void ResourceAccount::addLatency(const Path path, const int64_t micros) {
+        latencies[static_cast<size_t>(path)].record(micros);
+    }
+
+    void ResourceAccount::sendStarted(const Path path, const int64_t captureMs, const int64_t producedAtUs) {
+        sendMatchers[path == Path::VideoSend].handOff(captureMs, producedAtUs);
+    }
+
+    void ResourceAccount::sendFinished(const Path path, const int64_t mediaTimeMs, const int64_t sentAtUs) {
+        if (const auto micros = sendMatchers[path == Path::VideoSend].sent(mediaTimeMs, sentAtUs)) {
+            addLatency(path, *micros);
+        }
+    }
+
+    CallLatency ResourceAccount::latency() const {
+        return {
+            latencies[static_cast<size_t>(Path::AudioSend)].summary(),
+            latencies[static_cast<size_t>(Path::VideoSend)].summary(),
+            latencies[static_cast<size_t>(Path::AudioReceive)].summary(),
+            latencies[static_cast<size_t>(Path::VideoReceive)].summary(),
+        };
+    }
+
+    int64_t ResourceAccount::ThreadCpuTime() {
+#ifdef IS_WINDOWS
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+            return 0;
+        }
+        ULARGE_INTEGER kernelTime, userTime;
+        kernelTime.LowPart = kernel.dwLowDateTime;
+        kernelTime.HighPart = kernel.dwHighDateTime;
+        userTime.LowPart = user.dwLowDateTime;
+        userTime.HighPart = user.dwHighDateTime;
+        return static_cast<int64_t>(kernelTime.QuadPart + userTime.QuadPart) * 100;
+#else
+        timespec ts{};
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+            return 0;
+        }
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#endif
+    }
+
+    std::vector<ThreadResourceUsage> ResourceAccount::Threads() {
+        std::vector<ThreadResourceUsage> threads;
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+        const auto ticksPerSecond = sysconf(_SC_CLK_TCK);
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+            std::ifstream statFile(entry.path() / "stat");
+            std::string stat;
+            if (!std::getline(statFile, stat)) {
+                continue;
+            }
+            // The name sits between the first '(' and the last ')' and may contain spaces
+            const auto nameStart = stat.find('(');
+            const auto nameEnd = stat.rfind(')');
+            if (nameStart == std::string::npos || nameEnd == std::string::npos || nameEnd < nameStart) {
+                continue;
+            }
+            std::istringstream fields(stat.substr(nameEnd + 2));
+            std::string field;
+            uint64_t userTicks = 0, systemTicks = 0;
+            // Fields from state (3rd) onward, utime and stime are the 14th and 15th
+            for (int i = 3; i <= 15 && fields >> field; i++) {
+                if (i == 14) {
+                    userTicks = std::stoull(field);
+                } else if (i == 15) {
+                    systemTicks = std::stoull(field);
+                }
+            }
+            threads.push_back({
+                std::stoll(entry.path().filename().string()),
+                stat.substr(nameStart + 1, nameEnd - nameStart - 1),
+                ticksPerSecond > 0 ? (userTicks + systemTicks) * 1000000 / ticksPerSecond : 0,
+            });
+        }
+#endif
+        return threads;
+    }
+
+    uint64_t ResourceAccount::ResidentBytes() {
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size = 0, resident = 0;
+        if (statm >> size >> resident) {
+            return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        }
+#endif
+        return 0;
+    }
+} // ntgcalls
@@ -0,0 +1,39 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/send_latency_matcher.hpp>
+
+#include <cstdlib>
+
+namespace ntgcalls {
+    void SendLatencyMatcher::handOff(const int64_t captureMs, const int64_t producedAtUs) {
+        std::lock_guard lock(mutex);
+        if (pending.size() == kMaxPending) {
+            pending.pop_front();
+        }
+        pending.push_back({captureMs, producedAtUs});
+    }
+
+    std::optional<int64_t> SendLatencyMatcher::sent(const int64_t mediaTimeMs, const int64_t sentAtUs) {
+        std::lock_guard lock(mutex);
+        if (pending.empty()) {
+            return std::nullopt;
+        }
+        // The first frame of a stream is never skipped by the encoder, so it anchors the media time
+        const auto expected = anchor ? anchor->captureMs + mediaTimeMs - anchor->mediaTimeMs : pending.front().captureMs;
+        // Frames the encoder dropped, or packed along with an earlier one, are older than the expected time
+        while (pending.size() > 1 && std::abs(pending[1].captureMs - expected) <= std::abs(pending.front().captureMs - expected)) {
+            pending.pop_front();
+        }
+        const auto frame = pending.front();
+        if (std::abs(frame.captureMs - expected) > kMaxDriftMs) {
+            // A pause or a restarted encoder broke the timeline
+            anchor.reset();
+            return std::nullopt;
+        }
+        pending.pop_front();
+        anchor = Anchor{frame.captureMs, mediaTimeMs};
+        return sentAtUs - frame.producedAtUs;
+    }
+} // ntgcalls
@@ -0,0 +1,42 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/snapshot_publisher.hpp>
+
+namespace ntgcalls {
+    SnapshotPublisher::SnapshotPublisher() {
+        current.store(std::make_shared<const Table>());
+    }
+
+    std::shared_ptr<const SnapshotPublisher::Table> SnapshotPublisher::load() const {
+        return current.load();
+    }
+
+    std::shared_ptr<CallInterface> SnapshotPublisher::find(const int64_t chatId) const {
+        const auto table = load();
+        const auto it = table->find(chatId);
+        return it != table->end() ? it->second : nullptr;
+    }
+
+    void SnapshotPublisher::add(const int64_t chatId, std::shared_ptr<CallInterface> call) {
+        std::lock_guard lock(mutex);
+        auto table = std::make_shared<Table>(*current.load());
+        table->insert_or_assign(chatId, std::move(call));
+        current.store(std::move(table));
+    }
+
+    void SnapshotPublisher::remove(const std::vector<std::pair<int64_t, std::shared_ptr<CallInterface>>>& calls) {
+        if (calls.empty()) {
+            return;
+        }
+        std::lock_guard lock(mutex);
+        auto table = std::make_shared<Table>(*current.load());
+        for (const auto& [chatId, call] : calls) {
+            if (const auto it = table->find(chatId); it != table->end() && it->second == call) {
+                table->erase(it);
+            }
+        }
+        current.store(std::move(table));
+    }
+} // ntgcalls
@@ -0,0 +1,54 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <ntgcalls/utils/worker_pool.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace ntgcalls {
+    WorkerPool::WorkerPool(const size_t size, const std::string& name) {
+        workers.reserve(std::max<size_t>(size, 1));
+        for (size_t i = 0; i < std::max<size_t>(size, 1); i++) {
+            auto worker = webrtc::Thread::Create();
+            worker->SetName(name + "-" + std::to_string(i), nullptr);
+            worker->Start();
+            workers.push_back(std::move(worker));
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        for (const auto& worker : workers) {
+            worker->Stop();
+        }
+        workers.clear();
+    }
+
+    webrtc::Thread* WorkerPool::strand(const int64_t key) const {
+        return workers[StrandIndex(key, workers.size())].get();
+    }
+
+    webrtc::Thread* WorkerPool::next() {
+        return workers[nextWorker++ % workers.size()].get();
+    }
+
+    void WorkerPool::drain() const {
+        for (const auto& worker : workers) {
+            worker->BlockingCall([] {});
+        }
+    }
+
+    size_t WorkerPool::size() const {
+        return workers.size();
+    }
+
+    size_t WorkerPool::DefaultSize() {
+        return std::clamp(std::thread::hardware_concurrency(), 2U, 8U);
+    }
+
+    size_t WorkerPool::StrandIndex(const int64_t key, const size_t size) {
+        // Chat ids share long common prefixes, mix them before picking a worker
+        return (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL >> 32) % size;
+    }
+} // ntgcalls
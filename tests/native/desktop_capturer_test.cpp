@@ -0,0 +1,163 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#if !defined(IS_ANDROID) && !defined(IS_MACOS)
+#include <modules/desktop_capture/desktop_frame.h>
+#include <ntgcalls/media/video_sink.hpp>
+#include <ntgcalls/devices/desktop_capturer_module.hpp>
+
+namespace {
+    constexpr int kWidth = 64;
+    constexpr int kHeight = 64;
+
+    // Hands out the queued frames, one per capture request, and nothing while the queue is empty
+    class SyntheticCapturer final : public webrtc::DesktopCapturer {
+        std::mutex mutex;
+        std::deque<std::unique_ptr<webrtc::DesktopFrame>> frames;
+        Callback* callback = nullptr;
+
+    public:
+        void push(std::unique_ptr<webrtc::DesktopFrame> frame) {
+            std::lock_guard lock(mutex);
+            frames.push_back(std::move(frame));
+        }
+
+        void Start(Callback* cb) override {
+            callback = cb;
+        }
+
+        void CaptureFrame() override {
+            std::unique_ptr<webrtc::DesktopFrame> frame;
+            {
+                std::lock_guard lock(mutex);
+                if (frames.empty()) return;
+                frame = std::move(frames.front());
+                frames.pop_front();
+            }
+            callback->OnCaptureResult(Result::SUCCESS, std::move(frame));
+        }
+
+        bool GetSourceList(SourceList* sources) override {
+            sources->push_back({0, "Synthetic"});
+            return true;
+        }
+
+        bool SelectSource(SourceId) override {
+            return true;
+        }
+    };
+
+    // BGRA frame filled with a single gray level, the damaged region is set by the caller
+    std::unique_ptr<webrtc::DesktopFrame> makeFrame(const uint8_t level, const webrtc::DesktopRect& damage) {
+        auto frame = std::make_unique<webrtc::BasicDesktopFrame>(webrtc::DesktopSize(kWidth, kHeight));
+        for (int y = 0; y < kHeight; y++) {
+            uint8_t* row = frame->GetFrameDataAtPos(webrtc::DesktopVector(0, y));
+            for (int x = 0; x < kWidth; x++) {
+                row[x * 4] = row[x * 4 + 1] = row[x * 4 + 2] = level;
+                row[x * 4 + 3] = 0xFF;
+            }
+        }
+        if (!damage.is_empty()) {
+            frame->mutable_updated_region()->SetRect(damage);
+        }
+        return frame;
+    }
+
+    class Collector {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<webrtc::scoped_refptr<webrtc::I420Buffer>> buffers;
+
+    public:
+        void add(const webrtc::scoped_refptr<webrtc::I420Buffer>& buffer) {
+            {
+                std::lock_guard lock(mutex);
+                buffers.push_back(buffer);
+            }
+            cv.notify_all();
+        }
+
+        webrtc::scoped_refptr<webrtc::I420Buffer> waitFor(const size_t count) {
+            std::unique_lock lock(mutex);
+            if (!cv.wait_for(lock, std::chrono::seconds(5), [&] { return buffers.size() >= count; })) {
+                return nullptr;
+            }
+            return buffers[count - 1];
+        }
+    };
+
+    uint8_t lumaAt(const webrtc::I420Buffer& buffer, const int x, const int y) {
+        return buffer.DataY()[y * buffer.StrideY() + x];
+    }
+
+    bool check(const bool condition, const char* what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+        }
+        return condition;
+    }
+}
+
+int main() {
+    const ntgcalls::VideoDescription desc(
+        ntgcalls::BaseMediaDescription::MediaSource::Desktop,
+        kWidth,
+        kHeight,
+        30,
+        R"({"id":0})",
+        false
+    );
+    ntgcalls::VideoSink sink;
+    sink.setConfig(desc);
+
+    auto capturer = std::make_unique<SyntheticCapturer>();
+    auto* synthetic = capturer.get();
+    Collector collector;
+    {
+        ntgcalls::DesktopCapturerModule module(desc, &sink, std::move(capturer));
+        module.onData([&](bytes::unique_binary, const wrtc::FrameData& frameData) {
+            collector.add(frameData.buffer);
+        });
+        module.open();
+
+        // First frame is converted whole, regardless of its damage
+        synthetic->push(makeFrame(0x20, {}));
+        const auto first = collector.waitFor(1);
+        if (!check(first != nullptr, "first frame emitted")) return EXIT_FAILURE;
+        const uint8_t dark = lumaAt(*first, 0, 0);
+
+        // Every pixel changes, but only the damaged rectangle may be converted
+        const auto damage = webrtc::DesktopRect::MakeLTRB(16, 16, 32, 32);
+        synthetic->push(makeFrame(0xE0, damage));
+        const auto second = collector.waitFor(2);
+        if (!check(second != nullptr, "damaged frame emitted")) return EXIT_FAILURE;
+        bool ok = check(lumaAt(*second, 20, 20) > dark, "damaged rectangle converted");
+        ok &= check(lumaAt(*second, 0, 0) == dark, "pixels outside the damage left untouched");
+        ok &= check(lumaAt(*second, 40, 40) == dark, "pixels past the damage left untouched");
+
+        // Nothing damaged, the pooled buffer of the previous frame is handed out again
+        synthetic->push(makeFrame(0x80, {}));
+        const auto third = collector.waitFor(3);
+        if (!check(third != nullptr, "unchanged frame emitted")) return EXIT_FAILURE;
+        ok &= check(third.get() == second.get(), "unchanged frame reuses the pooled buffer");
+        ok &= check(lumaAt(*third, 20, 20) == lumaAt(*second, 20, 20), "unchanged frame not converted");
+        if (!ok) return EXIT_FAILURE;
+    }
+    std::printf("desktop capturer: OK\n");
+    return EXIT_SUCCESS;
+}
+#else
+int main() {
+    std::printf("desktop capturer: skipped, not available on this platform\n");
+    return EXIT_SUCCESS;
+}
+#endif
@@ -1,5 +1,7 @@
+import asyncio
+import json
 import unittest
-from ntgcalls import NTgCalls
+from ntgcalls import NTgCalls, ConnectionNotFound, MediaDescription, AudioDescription, MediaSource, StreamMode, StreamDevice, FrameData
 
 
 class TestNTgCalls(unittest.IsolatedAsyncioTestCase):
@@ -8,6 +10,47 @@ class TestNTgCalls(unittest.IsolatedAsyncioTestCase):
         self.assertEqual(result, "pong")
         self.assertIsNotNone(result)
 
+    async def test_async_future(self):
+        wrtc = NTgCalls()
+        future = wrtc.cpu_usage()
+        self.assertIsInstance(future, asyncio.Future)
+        self.assertIsInstance(await future, float)
+        with self.assertRaises(ConnectionNotFound):
+            await wrtc.get_state(-1001)
+
+    async def test_local_sfu_forwarding(self):
+        wrtc = NTgCalls()
+        loop = asyncio.get_running_loop()
+        received = asyncio.Event()
+
+        def on_frames(chat_id, mode, device, frames):
+            if chat_id == 2 and mode == StreamMode.PLAYBACK and frames:
+                loop.call_soon_threadsafe(received.set)
+
+        wrtc.on_frames(on_frames)
+        ssrcs = []
+        for chat_id in (1, 2):
+            payload = await wrtc.create_call(chat_id)
+            ssrcs.append(json.loads(payload)["ssrc"])
+            await wrtc.connect(chat_id, await wrtc.join_local_sfu(payload), False)
+            external = AudioDescription(MediaSource.EXTERNAL, 48000, 2, "")
+            await wrtc.set_stream_sources(chat_id, StreamMode.PLAYBACK, MediaDescription(microphone=external))
+            await wrtc.set_stream_sources(chat_id, StreamMode.CAPTURE, MediaDescription(microphone=external))
+
+        # 10ms of a stereo 16-bit tone, silence could be dropped by the encoder
+        tone = bytes((i * 7) % 256 for i in range(1920))
+        for _ in range(200):
+            await wrtc.send_external_frame(1, StreamDevice.MICROPHONE, tone, FrameData(0, 0, 0, 0))
+            if received.is_set():
+                break
+            await asyncio.sleep(0.01)
+        self.assertTrue(received.is_set())
+
+        await wrtc.stop_all()
+        for ssrc in ssrcs:
+            self.assertTrue(await wrtc.leave_local_sfu(ssrc))
+        self.assertFalse(await wrtc.leave_local_sfu(ssrcs[0]))
+
 
 if __name__ == "__main__":
     unittest.main()
\ No newline at end of file
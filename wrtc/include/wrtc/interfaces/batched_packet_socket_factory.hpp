@@ -0,0 +1,35 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+#include <atomic>
+#include <p2p/base/basic_packet_socket_factory.h>
+#include <rtc_base/physical_socket_server.h>
+#include <wrtc/interfaces/shared_udp_socket.hpp>
+
+namespace wrtc {
+
+    class BatchedPacketSocketFactory final : public webrtc::BasicPacketSocketFactory {
+        webrtc::PhysicalSocketServer* server;
+        std::atomic_uint32_t sharedSocketsPerAddress = 0;
+        std::unique_ptr<SharedUdpSocketPool> sharedPool;
+
+    public:
+        explicit BatchedPacketSocketFactory(webrtc::PhysicalSocketServer* server);
+
+        // Opt-in, 0 gives every new socket its own port again
+        void setSharedSockets(uint32_t socketsPerAddress);
+
+        std::unique_ptr<webrtc::AsyncPacketSocket> CreateUdpSocket(
+            const webrtc::Environment& env,
+            const webrtc::SocketAddress& address,
+            uint16_t minPort,
+            uint16_t maxPort
+        ) override;
+    };
+
+} // wrtc
+#endif
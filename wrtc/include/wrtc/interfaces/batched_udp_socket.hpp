@@ -0,0 +1,104 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+#include <atomic>
+#include <vector>
+#include <sys/socket.h>
+#include <api/task_queue/pending_task_safety_flag.h>
+#include <rtc_base/async_packet_socket.h>
+#include <rtc_base/physical_socket_server.h>
+#include <rtc_base/thread.h>
+
+namespace wrtc {
+
+    // UDP socket that drains reads with recvmmsg and flushes queued sends with sendmmsg, coalescing with UDP GSO when possible
+    class BatchedUdpSocket final : public webrtc::AsyncPacketSocket, public webrtc::Dispatcher {
+    public:
+        struct Stats {
+            uint64_t readWakeups;
+            uint64_t packetsReceived;
+            uint32_t maxReadBatch;
+            uint64_t sendFlushes;
+            uint64_t packetsSent;
+            uint32_t maxSendBatch;
+            uint64_t gsoSends;
+        };
+
+        static std::unique_ptr<BatchedUdpSocket> Create(webrtc::PhysicalSocketServer* server, const webrtc::SocketAddress& address, uint16_t minPort, uint16_t maxPort);
+
+        ~BatchedUdpSocket() override;
+
+        webrtc::SocketAddress GetLocalAddress() const override;
+
+        webrtc::SocketAddress GetRemoteAddress() const override;
+
+        int Send(const void* data, size_t size, const webrtc::AsyncSocketPacketOptions& options) override;
+
+        int SendTo(const void* data, size_t size, const webrtc::SocketAddress& addr, const webrtc::AsyncSocketPacketOptions& options) override;
+
+        int Close() override;
+
+        State GetState() const override;
+
+        int GetOption(webrtc::Socket::Option opt, int* value) override;
+
+        int SetOption(webrtc::Socket::Option opt, int value) override;
+
+        int GetError() const override;
+
+        void SetError(int error) override;
+
+        uint32_t GetRequestedEvents() override;
+
+        void OnEvent(uint32_t ff, int err) override;
+
+        int GetDescriptor() override;
+
+        bool IsDescriptorClosed() override;
+
+        static Stats GetStats();
+
+    private:
+        struct PendingPacket {
+            sockaddr_storage address;
+            socklen_t addressLength;
+            size_t offset;
+            size_t size;
+            int64_t packetId;
+            webrtc::PacketInfo info;
+        };
+
+        webrtc::PhysicalSocketServer* server;
+        webrtc::Thread* thread;
+        int fd;
+        int family;
+        int error = 0;
+        uint32_t requestedEvents = webrtc::DE_READ;
+        bool gsoEnabled = false;
+        bool flushScheduled = false;
+        bool writeBlocked = false;
+        webrtc::SocketAddress localAddress;
+        std::vector<PendingPacket> pending;
+        std::vector<uint8_t> sendBuffer;
+        webrtc::ScopedTaskSafety taskSafety;
+
+        static std::atomic_uint64_t readWakeups, packetsReceived, sendFlushes, packetsSent, gsoSends;
+        static std::atomic_uint32_t maxReadBatch, maxSendBatch;
+
+        BatchedUdpSocket(webrtc::PhysicalSocketServer* server, int fd, int family, const webrtc::SocketAddress& localAddress);
+
+        void DrainReads();
+
+        void Flush();
+
+        void SetWriteBlocked(bool blocked);
+
+        static void UpdateMax(std::atomic_uint32_t& max, uint32_t value);
+    };
+
+} // wrtc
+#endif
@@ -92,6 +92,7 @@ namespace wrtc {
 
         void RtpPacketReceived(const webrtc::RtpPacketReceived& packet) override;
 
+        // Worker thread with mutex held
         void addIncomingAudio(uint32_t ssrc, const std::string& endpoint);
 
         void enableAudioIncoming(bool enable) override;
@@ -0,0 +1,53 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <map>
+#include <p2p/base/basic_packet_socket_factory.h>
+#include <p2p/base/dtls_transport.h>
+#include <p2p/base/p2p_transport_channel.h>
+#include <p2p/client/basic_port_allocator.h>
+#include <wrtc/interfaces/peer_connection/peer_connection_factory.hpp>
+#include <wrtc/interfaces/wrapped_dtls_srtp_transport.hpp>
+
+namespace wrtc {
+
+    // Stand-in for the Telegram group call servers on this host, answers join payloads and forwards RTP and RTCP between participants
+    class LocalSfu {
+    public:
+        LocalSfu();
+
+        ~LocalSfu();
+
+        // Takes the payload of GroupConnection::getJoinPayload and returns what GroupCall::connect expects
+        std::string join(const std::string& joinPayload);
+
+        bool leave(uint32_t ssrc);
+
+    private:
+        struct Participant {
+            std::unique_ptr<webrtc::BasicPortAllocator> portAllocator;
+            std::unique_ptr<webrtc::P2PTransportChannel> transportChannel;
+            std::unique_ptr<webrtc::DtlsTransportInternalImpl> dtlsTransport;
+            std::unique_ptr<WrappedDtlsSrtpTransport> srtpTransport;
+            std::vector<webrtc::Candidate> candidates;
+        };
+
+        PeerConnectionFactory* factory;
+        webrtc::Environment env;
+        webrtc::scoped_refptr<webrtc::RTCCertificate> certificate;
+        // Kept apart from the shared sockets of the calls, which would route both ends of a pair to one handle
+        std::unique_ptr<webrtc::BasicPacketSocketFactory> socketFactory;
+        // Network thread only
+        std::map<uint32_t, std::unique_ptr<Participant>> participants;
+
+        void release(std::unique_ptr<Participant> participant) const;
+
+        void forwardRtp(uint32_t ssrc, const webrtc::CopyOnWriteBuffer& packet) const;
+
+        void forwardRtcp(uint32_t ssrc, const webrtc::CopyOnWriteBuffer& packet) const;
+    };
+
+} // wrtc
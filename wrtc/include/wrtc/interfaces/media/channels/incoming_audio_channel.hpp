@@ -17,12 +17,12 @@ namespace wrtc {
         webrtc::Thread* workerThread;
         webrtc::Thread* networkThread;
         int64_t activityTimestamp = 0;
+        bool attached = false;
 
     public:
         IncomingAudioChannel(
             webrtc::Call* call,
             ChannelManager *channelManager,
-            webrtc::RtpTransport* rtpTransport,
             const MediaContent& mediaContent,
             webrtc::Thread *workerThread,
             webrtc::Thread* networkThread,
@@ -31,11 +31,21 @@ namespace wrtc {
 
         ~IncomingAudioChannel() override;
 
+        // Network thread only, kept apart from construction so a batch of channels shares a single hop
+        void attachTransport(webrtc::RtpTransport* rtpTransport);
+
+        void detachTransport();
+
+        void setEnabled(bool enable) const;
+
         void updateActivity();
 
         [[nodiscard]] int64_t getActivity() const;
 
         uint32_t ssrc() const;
+
+        // Worker thread only
+        bool getStats(webrtc::VoiceMediaReceiveInfo* info) const;
     };
 
 } // wrtc
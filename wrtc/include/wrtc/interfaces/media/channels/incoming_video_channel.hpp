@@ -20,12 +20,12 @@ namespace wrtc {
         webrtc::Thread* workerThread;
         webrtc::Thread* networkThread;
         std::unique_ptr<RawVideoSink> sink;
+        bool attached = false;
 
     public:
         IncomingVideoChannel(
             webrtc::Call* call,
             ChannelManager *channelManager,
-            webrtc::RtpTransport* rtpTransport,
             std::vector<SsrcGroup> ssrcGroups,
             webrtc::UniqueRandomIdGenerator *randomIdGenerator,
             const std::vector<webrtc::Codec>& codecs,
@@ -36,7 +36,17 @@ namespace wrtc {
 
         ~IncomingVideoChannel() override;
 
+        // Network thread only, kept apart from construction so a batch of channels shares a single hop
+        void attachTransport(webrtc::RtpTransport* rtpTransport);
+
+        void detachTransport();
+
+        void setEnabled(bool enable) const;
+
         [[nodiscard]] uint32_t ssrc() const;
+
+        // Worker thread only
+        bool getStats(webrtc::VideoMediaReceiveInfo* info) const;
     };
 
 } // wrtc
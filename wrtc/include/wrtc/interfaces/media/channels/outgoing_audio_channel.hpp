@@ -18,13 +18,13 @@ namespace wrtc {
         std::unique_ptr<webrtc::VoiceChannel> channel;
         webrtc::Thread* workerThread;
         webrtc::Thread* networkThread;
+        bool attached = false;
         webrtc::LocalAudioSinkAdapter* sink;
 
     public:
         OutgoingAudioChannel(
             webrtc::Call* call,
             ChannelManager* channelManager,
-            webrtc::RtpTransport* rtpTransport,
             const MediaContent& mediaContent,
             webrtc::Thread* workerThread,
             webrtc::Thread* networkThread,
@@ -35,7 +35,15 @@ namespace wrtc {
 
         ~OutgoingAudioChannel() override;
 
+        // Network thread only, kept apart from construction so both outgoing channels share a single hop
+        void attachTransport(webrtc::RtpTransport* rtpTransport);
+
+        void detachTransport();
+
         [[nodiscard]] uint32_t ssrc() const;
+
+        // Worker thread only
+        bool getStats(webrtc::VoiceMediaSendInfo* info) const;
     };
 
 } // wrtc
\ No newline at end of file
@@ -17,6 +17,7 @@ namespace wrtc {
         std::unique_ptr<webrtc::VideoChannel> channel;
         webrtc::Thread* workerThread;
         webrtc::Thread* networkThread;
+        bool attached = false;
         std::unique_ptr<webrtc::VideoBitrateAllocatorFactory> bitrateAllocatorFactory;
         LocalVideoAdapter* sink;
 
@@ -24,7 +25,6 @@ namespace wrtc {
         OutgoingVideoChannel(
             webrtc::Call* call,
             ChannelManager* channelManager,
-            webrtc::RtpTransport* rtpTransport,
             const MediaContent& mediaContent,
             webrtc::Thread* workerThread,
             webrtc::Thread* networkThread,
@@ -35,6 +35,14 @@ namespace wrtc {
 
         void set_enabled(bool enable) const;
 
+        // Network thread only, kept apart from construction so both outgoing channels share a single hop
+        void attachTransport(webrtc::RtpTransport* rtpTransport);
+
+        void detachTransport();
+
         [[nodiscard]] uint32_t ssrc() const;
+
+        // Worker thread only
+        bool getStats(webrtc::VideoMediaSendInfo* info) const;
     };
 } // wrtc
\ No newline at end of file
@@ -0,0 +1,56 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <api/audio/audio_mixer.h>
+#include <rtc_base/platform_thread.h>
+
+namespace wrtc {
+
+    // Pulls every incoming audio stream (and so drives its decoding) every 10ms.
+    // With zero threads this happens inline on the ADM thread, otherwise sources are spread across pull threads
+    class PlayoutMixer final: public webrtc::AudioMixer {
+        struct Shard {
+            std::mutex mutex;
+            std::vector<Source*> sources;
+            webrtc::PlatformThread thread;
+            std::atomic_bool running = false;
+            webrtc::AudioFrame frame;
+        };
+
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Shard>> shards;
+        std::vector<Source*> inlineSources;
+        webrtc::AudioFrame inlineFrame;
+        std::atomic_uint64_t totalTicks = 0, totalLateTicks = 0;
+
+        void startShard(Shard* shard);
+
+        static void stopShard(Shard* shard);
+
+        void pull(std::vector<Source*>& sources, webrtc::AudioFrame* frame);
+
+    public:
+        ~PlayoutMixer() override;
+
+        bool AddSource(Source* audioSource) override;
+
+        void RemoveSource(Source* audioSource) override;
+
+        void Mix(size_t numberOfChannels, webrtc::AudioFrame* audioFrameForMixing) override;
+
+        void setThreads(size_t count);
+
+        size_t threads();
+
+        uint64_t ticks() const;
+
+        uint64_t lateTicks() const;
+    };
+
+} // wrtc
@@ -4,32 +4,84 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <functional>
+#include <rtc_base/platform_thread.h>
 #include <wrtc/models/audio_frame.hpp>
 #include <wrtc/interfaces/media/remote_media_interface.hpp>
 
 namespace wrtc {
 
+    // Aggregates incoming audio on its own 10ms clock, so a stalled source never delays the others
+    // The clock parks once every source went idle and resumes with the next frame
     class RemoteAudioSink final: public RemoteMediaInterface, public std::enable_shared_from_this<RemoteAudioSink> {
-        std::atomic<uint32_t> numSources;
-        std::vector<std::unique_ptr<AudioFrame>> audioFrames;
-        std::function<void(const std::vector<std::unique_ptr<AudioFrame>>&)> framesCallback;
+    public:
+        // Slots preallocated up front, the table grows under the lock past this
+        static constexpr size_t kInitialSources = 16;
+        // 10ms of 48kHz stereo audio
+        static constexpr size_t kMaxSamples = 960;
+        static constexpr size_t kJitterDepth = 4;
+        // Frames buffered before a source starts (or restarts after an underrun) playing
+        static constexpr size_t kPrefillFrames = 2;
+        // Ticks without data after which a source slot is released
+        static constexpr int kIdleTicks = 50;
+
+    private:
+        struct Packet {
+            std::array<int16_t, kMaxSamples> samples{};
+            size_t size = 0;
+            int sampleRate = 0;
+            size_t channels = 0;
+            int64_t decodedAtUs = 0;
+        };
+
+        struct Slot {
+            uint32_t ssrc = 0;
+            bool active = false;
+            bool buffering = true;
+            int idleTicks = 0;
+            size_t head = 0, count = 0;
+            std::array<Packet, kJitterDepth> packets;
+        };
+
+        std::mutex mutex;
+        // Deques keep references stable while growing, the callback reads output outside the lock
+        std::deque<Slot> slots;
+        std::deque<Packet> output;
+        std::vector<AudioFrame> audioFrames;
+        std::function<void(const std::vector<AudioFrame>&)> framesCallback;
+        webrtc::PlatformThread thread;
+        std::condition_variable wake;
+        std::atomic_bool running = false;
+        bool parked = false;
+        std::atomic_uint64_t droppedFrames = 0, lateTicks = 0;
+
+        Slot* findSlot(uint32_t ssrc);
+
+        void startClock();
+
+        bool tick();
+
+        void park();
 
     public:
-        explicit RemoteAudioSink(const std::function<void(const std::vector<std::unique_ptr<AudioFrame>>&)>& callback);
+        explicit RemoteAudioSink(const std::function<void(const std::vector<AudioFrame>&)>& callback);
 
         ~RemoteAudioSink() override;
 
         void sendData(std::unique_ptr<AudioFrame> frame);
 
-        void addSource();
+        void clear();
 
-        void removeSource();
+        uint64_t dropped() const;
 
-        void updateAudioSourceCount(int count);
+        uint64_t underruns() const;
     };
 
 } // wrtc
@@ -20,6 +20,8 @@ namespace wrtc {
 
         void OnFrame(const i420ImageData& data, FrameData additionalData) const;
 
+        void OnFrame(const webrtc::scoped_refptr<webrtc::VideoFrameBuffer>& buffer, FrameData additionalData) const;
+
     private:
         webrtc::scoped_refptr<VideoTrackSource> source;
         PeerConnectionFactory* factory;
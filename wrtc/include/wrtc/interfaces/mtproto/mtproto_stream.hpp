@@ -51,7 +51,6 @@ namespace wrtc {
         std::map<std::string, std::unique_ptr<VideoStreamingSharedState>> sharedVideoState;
 
         synchronized_callback<void> requestCurrentTimeCallback;
-        synchronized_callback<int> updateAudioSourceCountCallback;
         synchronized_callback<std::unique_ptr<AudioFrame>> audioFrameCallback;
         synchronized_callback<uint32_t, bool, std::unique_ptr<webrtc::VideoFrame>> videoFrameCallback;
         synchronized_callback<SegmentPartRequest> requestBroadcastPartCallback;
@@ -103,7 +102,5 @@ namespace wrtc {
         void onAudioFrame(const std::function<void(std::unique_ptr<AudioFrame>)>& callback);
 
         void onVideoFrame(const std::function<void(uint32_t, bool, std::unique_ptr<webrtc::VideoFrame>)>& callback);
-
-        void onUpdateAudioSourceCount(const std::function<void(int)>& callback);
     };
 } // wrtc
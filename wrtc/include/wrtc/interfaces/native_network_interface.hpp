@@ -4,14 +4,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <ranges>
 #include <api/scoped_refptr.h>
 #include <pc/dtls_srtp_transport.h>
 #include <p2p/base/dtls_transport.h>
+#include <rtc_base/numerics/sequence_number_unwrapper.h>
 #include <rtc_base/rtc_certificate.h>
 #include <p2p/base/p2p_transport_channel.h>
 #include <p2p/client/basic_port_allocator.h>
 #include <wrtc/models/peer_ice_parameters.hpp>
 #include <wrtc/interfaces/network_interface.hpp>
+#include <wrtc/interfaces/null_transport.hpp>
 #include <rtc_base/third_party/sigslot/sigslot.h>
 #include <wrtc/interfaces/media/channel_manager.hpp>
 #include <wrtc/interfaces/sctp_data_channel_provider_interface_impl.hpp>
@@ -37,6 +41,8 @@ namespace wrtc {
 
         void resetDtlsSrtpTransport();
 
+        void resetNullTransport();
+
         void UpdateAggregateStates_n();
 
         static std::vector<webrtc::SdpVideoFormat> filterSupportedVideoFormats(std::vector<webrtc::SdpVideoFormat> const &formats);
@@ -49,8 +55,36 @@ namespace wrtc {
 
         static int getH264LevelAssymetryAllowedPriority(std::string const &levelAssymetryAllowed);
 
+        void createIncomingSource(const std::string& endpoint, const MediaContent& mediaContent, bool force);
+
+        // Posts the transport attach of the channels created by the batch, channels are only destroyed
+        // after a detach queued behind it on the network thread, so the raw pointers stay valid
+        void attachIncomingChannels();
+
+        std::mutex statsMutex;
+        CallStats cachedStats;
+        bool statsRefreshing = false;
+
+        CallStats collectStats();
+
+        // Network thread only
+        void rtpSent(uint32_t ssrc, uint32_t timestamp);
+
     protected:
-        std::mutex mutex;
+        struct SentStream {
+            // Main ssrc of the outgoing channel, retransmissions and other simulcast layers are not followed
+            std::atomic_uint32_t ssrc = 0;
+            // Network thread only
+            uint32_t trackedSsrc = 0;
+            webrtc::RtpTimestampUnwrapper unwrapper;
+            std::optional<int64_t> lastTimestamp;
+        };
+
+        SentStream sentAudio, sentVideo;
+
+        // Guards the incoming channel maps, pendingContent and channelsClosed. The channels are created and
+        // destroyed on the worker thread, the network thread never takes it
+        mutable std::mutex mutex;
         std::unique_ptr<webrtc::Call> call;
         webrtc::LocalAudioSinkAdapter audioSink;
         LocalVideoAdapter videoSink;
@@ -69,7 +103,10 @@ namespace wrtc {
         std::map<std::string, std::unique_ptr<IncomingAudioChannel>> incomingAudioChannels;
         std::map<std::string, std::unique_ptr<IncomingVideoChannel>> incomingVideoChannels;
         std::map<std::string, MediaContent> pendingContent;
+        std::vector<std::string> pendingAttach;
+        bool channelsClosed = false;
         bool connected = false, failed = false;
+        std::optional<NullTransport::Mode> nullNetwork;
 
         virtual std::pair<webrtc::ServerAddresses, std::vector<webrtc::RelayServerConfig>> getStunAndTurnServers() = 0;
 
@@ -111,11 +148,50 @@ namespace wrtc {
 
         void initConnection(bool supportsPacketSending = false);
 
+        // Creates the missing outgoing channels in one worker hop and attaches them in one network hop
+        void createOutgoingChannels(const std::optional<MediaContent>& audioContent, const std::optional<MediaContent>& videoContent);
+
+        // Any thread, returns right away, the channels are set up in one worker hop and attached in one network hop
         void addIncomingSmartSource(const std::string& endpoint, const MediaContent& mediaContent, bool force = false);
 
+        void addIncomingSmartSources(std::vector<std::pair<std::string, MediaContent>> contents, bool force = false);
+
+        // Any thread, returns right away, keeps the incoming sources listed in contents and releases every other one
+        void syncIncomingSources(std::vector<std::pair<std::string, MediaContent>> contents);
+
+        // Worker thread with mutex held
+        void createIncomingSources(const std::vector<std::pair<std::string, MediaContent>>& contents, bool force);
+
+        // Mutex held
         void removeIncomingAudio(const std::string& endpoint);
 
+        void removeIncomingAudio(const std::vector<std::string>& endpoints);
+
+        // Any thread, returns right away. Disables the channels, detaches them in one network hop, then destroys
+        // them in one worker hop, this interface is kept alive until they are gone
+        void releaseIncomingChannels(
+            std::vector<std::unique_ptr<IncomingAudioChannel>> audioChannels,
+            std::vector<std::unique_ptr<IncomingVideoChannel>> videoChannels
+        );
+
+        template <typename T>
+        static std::vector<std::unique_ptr<T>> drainChannels(std::map<std::string, std::unique_ptr<T>>& channels) {
+            std::vector<std::unique_ptr<T>> drained;
+            drained.reserve(channels.size());
+            for (auto& channel : channels | std::views::values) {
+                drained.push_back(std::move(channel));
+            }
+            channels.clear();
+            return drained;
+        }
+
     public:
+        // Must be called before open, media then flows through a NullTransport instead of ICE and DTLS
+        void setNullNetwork(NullTransport::Mode mode);
+
+        // Must be called before gathering starts, lets ICE use loopback addresses to reach servers on this host
+        void enableLoopbackNetworks();
+
         PeerIceParameters localIceParameters();
 
         std::unique_ptr<webrtc::SSLFingerprint> localFingerprint() const;
@@ -131,6 +207,8 @@ namespace wrtc {
         void enableAudioIncoming(bool enable) override;
 
         void enableVideoIncoming(bool enable, bool isScreenCast) override;
+
+        CallStats getStats(bool cached) override;
     };
 
 } // wrtc
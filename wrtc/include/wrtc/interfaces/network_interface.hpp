@@ -6,6 +6,7 @@
 #include <wrtc/interfaces/media/tracks/media_track_interface.hpp>
 #include <wrtc/interfaces/peer_connection/peer_connection_factory.hpp>
 #include <wrtc/enums.hpp>
+#include <wrtc/models/call_stats.hpp>
 #include <wrtc/models/ice_candidate.hpp>
 #include <wrtc/utils/binary.hpp>
 #include <wrtc/utils/synchronized_callback.hpp>
@@ -22,6 +23,7 @@ namespace wrtc {
         synchronized_callback<IceCandidate> iceCandidateCallback;
         synchronized_callback<ConnectionState, bool> connectionChangeCallback;
         synchronized_callback<bytes::binary> dataChannelMessageCallback;
+        synchronized_callback<bool, int64_t, int64_t> frameSentCallback;
         ConnectionState currentState = ConnectionState::Connecting;
         bool dataChannelOpen = false;
         bool alreadyConnected = false;
@@ -52,6 +54,9 @@ namespace wrtc {
 
         void onDataChannelMessage(const std::function<void(const bytes::binary& data)>& callback);
 
+        // First packet of each outgoing audio or camera frame leaving the socket, mediaTimeMs follows its RTP clock
+        void onFrameSent(const std::function<void(bool video, int64_t mediaTimeMs, int64_t sentAtUs)>& callback);
+
         virtual void close();
 
         virtual void sendDataChannelMessage(const bytes::binary &data) const = 0;
@@ -73,6 +78,9 @@ namespace wrtc {
         virtual void enableAudioIncoming(bool enable);
 
         virtual void enableVideoIncoming(bool enable, bool isScreenCast);
+
+        // Cached returns the last collection right away and refreshes it in the background once stale
+        virtual CallStats getStats(bool cached);
     };
 
 } // wrtc
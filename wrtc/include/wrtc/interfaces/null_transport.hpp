@@ -0,0 +1,78 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <api/task_queue/pending_task_safety_flag.h>
+#include <pc/dtls_transport.h>
+#include <rtc_base/thread.h>
+
+namespace wrtc {
+
+    // Stands in for ICE and DTLS when no network should be touched, RTP is either dropped or handed back as received
+    class NullTransport final : public webrtc::DtlsTransportInternal {
+    public:
+        enum class Mode {
+            Discard,
+            Loopback,
+        };
+
+        NullTransport(Mode mode, webrtc::Thread* networkThread);
+
+        [[nodiscard]] const std::string& transport_name() const override;
+
+        [[nodiscard]] bool writable() const override;
+
+        [[nodiscard]] bool receiving() const override;
+
+        int SendPacket(const char* data, size_t len, const webrtc::AsyncSocketPacketOptions& options, int flags) override;
+
+        int SetOption(webrtc::Socket::Option opt, int value) override;
+
+        bool GetOption(webrtc::Socket::Option opt, int* value) override;
+
+        int GetError() override;
+
+        [[nodiscard]] std::optional<webrtc::NetworkRoute> network_route() const override;
+
+        webrtc::DtlsTransportState dtls_state() const override;
+
+        int component() const override;
+
+        bool IsDtlsActive() const override;
+
+        bool GetDtlsRole(webrtc::SSLRole* role) const override;
+
+        bool SetDtlsRole(webrtc::SSLRole role) override;
+
+        bool GetSslVersionBytes(int* version) const override;
+
+        bool GetSrtpCryptoSuite(int* cipher) const override;
+
+        bool GetSslCipherSuite(int* cipher) const override;
+
+        std::optional<absl::string_view> GetTlsCipherSuiteName() const override;
+
+        uint16_t GetSslPeerSignatureAlgorithm() const override;
+
+        bool SetLocalCertificate(const webrtc::scoped_refptr<webrtc::RTCCertificate>& certificate) override;
+
+        std::unique_ptr<webrtc::SSLCertChain> GetRemoteSSLCertChain() const override;
+
+        bool ExportSrtpKeyingMaterial(webrtc::ZeroOnFreeBuffer<uint8_t>& keying_material) override;
+
+        webrtc::RTCError SetRemoteParameters(absl::string_view digest_alg, const uint8_t* digest, size_t digest_len, std::optional<webrtc::SSLRole> role) override;
+
+        webrtc::IceTransportInternal* ice_transport() override;
+
+        uint16_t GetSslGroupId() const override;
+
+    private:
+        Mode mode;
+        webrtc::Thread* networkThread;
+        std::string transportName;
+        webrtc::ScopedTaskSafety taskSafety;
+    };
+
+} // wrtc
@@ -6,6 +6,7 @@
 
 #include <mutex>
 #include <api/peer_connection_interface.h>
+#include <wrtc/interfaces/media/playout_mixer.hpp>
 #include <wrtc/interfaces/peer_connection/peer_connection_factory_with_context.hpp>
 
 namespace wrtc {
@@ -40,6 +41,11 @@ namespace wrtc {
 
         [[nodiscard]] std::vector<webrtc::SdpVideoFormat> getSupportedVideoFormats() const;
 
+        [[nodiscard]] PlayoutMixer* playoutMixer() const;
+
+        // Process wide, only affects sockets created afterward
+        void setSharedSockets(uint32_t socketsPerAddress) const;
+
     private:
         static std::mutex _mutex;
         static bool initialized;
@@ -55,6 +61,8 @@ namespace wrtc {
 
         webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory_;
         webrtc::scoped_refptr<webrtc::AudioDeviceModule> _audioDeviceModule;
+        webrtc::scoped_refptr<PlayoutMixer> _playoutMixer;
+        webrtc::PacketSocketFactory* batchedSocketFactory = nullptr;
 
         std::vector<webrtc::SdpVideoFormat> supportedVideoFormats;
     };
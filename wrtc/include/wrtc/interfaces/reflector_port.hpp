@@ -3,6 +3,8 @@
 //
 
 #pragma once
+#include <array>
+#include <unordered_map>
 #include <p2p/base/port.h>
 #include <rtc_base/third_party/sigslot/sigslot.h>
 #include <p2p/client/relay_port_factory_interface.h>
@@ -122,7 +124,11 @@ namespace wrtc {
         uint32_t standaloneReflectorRoleId;
 
         webrtc::DiffServCodePoint stunDscpValue;
-        std::map<std::string, uint32_t> resolvedPeerTagsByHostname;
+        // Everything in front of the payload size of a data packet, built once per peer
+        using DataHeader = std::array<uint8_t, 16 + 4>;
+        std::unordered_map<std::string, DataHeader> dataHeadersByHostname;
+        std::unordered_map<uint32_t, webrtc::SocketAddress> candidateAddressesByTag;
+        std::vector<uint8_t> sendBuffer;
         webrtc::RelayCredentials credentials;
         int serverPriority;
 
@@ -151,6 +157,10 @@ namespace wrtc {
         static webrtc::CopyOnWriteBuffer parseHex(std::string const &string);
 
         bool FailAndPruneConnection(const webrtc::SocketAddress& address);
+
+        const DataHeader* ResolveDataHeader(const webrtc::SocketAddress& addr);
+
+        const webrtc::SocketAddress& ResolveCandidateAddress(uint32_t senderTag);
     };
 
 } // wrtc
\ No newline at end of file
@@ -0,0 +1,126 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+#include <atomic>
+#include <deque>
+#include <map>
+#include <wrtc/interfaces/batched_udp_socket.hpp>
+
+namespace wrtc {
+
+    class SharedUdpSocket;
+
+    // Multiplexes the UDP sockets of many calls over a few local sockets.
+    // A remote address belongs to a single call per socket, new remotes are matched by the ICE ufrag of their checks.
+    // Further calls to the same remote, such as an SFU, reach it from another shared socket.
+    class SharedUdpSocketPool final : public sigslot::has_slots<> {
+    public:
+        struct Stats {
+            uint32_t sockets;
+            uint32_t handles;
+            uint32_t overflowSockets;
+            uint64_t unroutedPackets;
+        };
+
+        SharedUdpSocketPool(webrtc::PhysicalSocketServer* server, uint32_t socketsPerAddress);
+
+        ~SharedUdpSocketPool() override;
+
+        void setSocketsPerAddress(uint32_t size);
+
+        // Returns nullptr if no shared socket could be bound to address
+        std::unique_ptr<webrtc::AsyncPacketSocket> CreateSocket(const webrtc::SocketAddress& address);
+
+        static Stats GetStats();
+
+    private:
+        friend class SharedUdpSocket;
+
+        struct Entry {
+            webrtc::IPAddress ip;
+            std::unique_ptr<BatchedUdpSocket> socket;
+            std::map<webrtc::SocketAddress, SharedUdpSocket*> routes;
+            std::map<std::string, SharedUdpSocket*, std::less<>> ufrags;
+            // Sender of every queued packet, in the order the socket reports them as sent
+            std::deque<SharedUdpSocket*> inFlight;
+            uint32_t handles = 0;
+            // Opened past socketsPerAddress because every other socket already carried a call to some remote
+            bool overflow = false;
+        };
+
+        webrtc::PhysicalSocketServer* server;
+        std::atomic_uint32_t socketsPerAddress;
+        std::vector<std::unique_ptr<Entry>> entries;
+
+        static std::atomic_uint32_t totalSockets, totalHandles, totalOverflowSockets;
+        static std::atomic_uint64_t unroutedPackets;
+
+        int SendTo(SharedUdpSocket* handle, const void* data, size_t size, const webrtc::SocketAddress& addr, const webrtc::AsyncSocketPacketOptions& options);
+
+        void Release(SharedUdpSocket* handle);
+
+        void Detach(Entry* entry, SharedUdpSocket* handle);
+
+        void Route(Entry* entry, const webrtc::ReceivedIpPacket& packet);
+
+        Entry* CreateEntry(const webrtc::IPAddress& ip);
+
+        Entry* Spill(SharedUdpSocket* handle, const webrtc::SocketAddress& key);
+
+        Entry* FindEntry(const webrtc::AsyncPacketSocket* socket) const;
+
+        void OnSentPacket(webrtc::AsyncPacketSocket* socket, const webrtc::SentPacketInfo& sentPacket);
+
+        void OnReadyToSend(webrtc::AsyncPacketSocket* socket);
+
+        static webrtc::SocketAddress RouteKey(const webrtc::SocketAddress& address);
+    };
+
+    class SharedUdpSocket final : public webrtc::AsyncPacketSocket {
+    public:
+        SharedUdpSocket(SharedUdpSocketPool* pool, SharedUdpSocketPool::Entry* entry);
+
+        ~SharedUdpSocket() override;
+
+        webrtc::SocketAddress GetLocalAddress() const override;
+
+        webrtc::SocketAddress GetRemoteAddress() const override;
+
+        int Send(const void* data, size_t size, const webrtc::AsyncSocketPacketOptions& options) override;
+
+        int SendTo(const void* data, size_t size, const webrtc::SocketAddress& addr, const webrtc::AsyncSocketPacketOptions& options) override;
+
+        int Close() override;
+
+        State GetState() const override;
+
+        int GetOption(webrtc::Socket::Option opt, int* value) override;
+
+        int SetOption(webrtc::Socket::Option opt, int value) override;
+
+        int GetError() const override;
+
+        void SetError(int error) override;
+
+    private:
+        friend class SharedUdpSocketPool;
+
+        SharedUdpSocketPool* pool;
+        SharedUdpSocketPool::Entry* entry;
+        webrtc::SocketAddress localAddress;
+        // Remotes this call reaches through another shared socket, because its own one carries another call to them
+        std::map<webrtc::SocketAddress, SharedUdpSocketPool::Entry*> spills;
+        std::map<webrtc::Socket::Option, int> options;
+        int error = 0;
+
+        void Deliver(const webrtc::ReceivedIpPacket& packet);
+
+        std::vector<SharedUdpSocketPool::Entry*> SpillEntries() const;
+    };
+
+} // wrtc
+#endif
@@ -12,6 +12,10 @@ namespace wrtc {
         webrtc::RtpHeaderExtensionMap headerExtensionMap;
         synchronized_callback<webrtc::RtpPacketReceived> rtpPacketCallback;
         int decryptionFailureCount = 0;
+        // Protected sizes of RTP and RTCP, network thread only
+        uint64_t totalBytesSent = 0, totalBytesReceived = 0;
+        // Network thread only, set before the first packet is sent
+        std::function<void(uint32_t, uint32_t)> rtpSentCallback;
 
     public:
         WrappedDtlsSrtpTransport(
@@ -22,6 +26,19 @@ namespace wrtc {
 
         void OnRtpPacketReceived(const webrtc::ReceivedIpPacket& packet) override;
 
+        void OnRtcpPacketReceived(const webrtc::ReceivedIpPacket& packet) override;
+
+        bool SendRtpPacket(webrtc::CopyOnWriteBuffer* packet, const webrtc::AsyncSocketPacketOptions& options, int flags) override;
+
+        bool SendRtcpPacket(webrtc::CopyOnWriteBuffer* packet, const webrtc::AsyncSocketPacketOptions& options, int flags) override;
+
+        // Ssrc and RTP timestamp of every packet the socket accepted
+        void onRtpSent(const std::function<void(uint32_t ssrc, uint32_t timestamp)>& callback);
+
+        [[nodiscard]] uint64_t bytesSent() const;
+
+        [[nodiscard]] uint64_t bytesReceived() const;
+
         void UpdateRtpHeaderExtensionMap(const webrtc::RtpHeaderExtensions& headerExtensions) override;
     };
 
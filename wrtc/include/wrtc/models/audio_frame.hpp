@@ -15,6 +15,8 @@ namespace wrtc {
         size_t size = 0;
         int sampleRate = 0;
         size_t channels = 0;
+        // Time the decoded frame was handed over by WebRTC, 0 if unknown
+        int64_t decodedAtUs = 0;
 
         explicit AudioFrame(uint32_t ssrc);
     };
@@ -0,0 +1,41 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace wrtc {
+
+    struct RtpStreamStats {
+        uint32_t ssrc = 0;
+        bool outgoing = false;
+        bool video = false;
+        uint64_t bytes = 0;
+        uint64_t packets = 0;
+        int64_t packetsLost = 0;
+        double fractionLost = 0;
+        double jitterMs = 0;
+        uint64_t nacks = 0;
+        uint64_t plis = 0;
+        // Bits per second since the previous collection
+        uint64_t bitrate = 0;
+        // Average encode time for outgoing video, decode time for incoming video
+        double frameTimeMs = 0;
+        double jitterBufferDelayMs = 0;
+    };
+
+    struct CallStats {
+        // Collection time in ms, 0 if nothing was collected yet
+        int64_t timestamp = 0;
+        double rttMs = 0;
+        uint64_t sendBandwidth = 0;
+        uint64_t receiveBandwidth = 0;
+        int64_t pacerDelayMs = 0;
+        uint64_t transportBytesSent = 0;
+        uint64_t transportBytesReceived = 0;
+        std::vector<RtpStreamStats> streams;
+    };
+
+} // wrtc
@@ -4,6 +4,8 @@
 
 #pragma once
 #include <cstdint>
+#include <api/scoped_refptr.h>
+#include <api/video/i420_buffer.h>
 #include <api/video/video_rotation.h>
 
 namespace wrtc {
@@ -13,6 +15,10 @@ namespace wrtc {
         int64_t absoluteCaptureTimestampMs;
         webrtc::VideoRotation rotation;
         uint16_t width, height;
+        // When the source produced the frame, the start of its send latency, 0 when the source does not tell
+        int64_t producedAtUs = 0;
+        // Packed I420 image owned by the source, pushed as is instead of copying the payload
+        webrtc::scoped_refptr<webrtc::I420Buffer> buffer;
 
         FrameData() = default;
 
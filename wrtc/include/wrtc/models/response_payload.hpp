@@ -27,6 +27,9 @@ namespace wrtc {
         bool isStream = false;
 
         explicit ResponsePayload(const std::string& payload);
+
+        // Audio and video description the Telegram servers answer with, without a transport
+        static json defaultMedia();
     };
 
 } // wrtc
@@ -0,0 +1,60 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <rtc_base/rtc_certificate.h>
+#include <rtc_base/thread.h>
+
+namespace wrtc {
+
+    // Process-wide stock of DTLS certificates, generated in the background so connections never wait on key generation
+    class CertificatePool {
+    public:
+        static constexpr size_t kDefaultSize = 8;
+        static constexpr std::chrono::seconds kDefaultLifetime = std::chrono::minutes(30);
+
+        CertificatePool();
+
+        ~CertificatePool();
+
+        static CertificatePool* GetOrCreateDefault();
+
+        webrtc::scoped_refptr<webrtc::RTCCertificate> take();
+
+        // A zero lifetime keeps certificates until they are taken
+        void configure(size_t size, std::chrono::seconds lifetime);
+
+    private:
+        struct Entry {
+            webrtc::scoped_refptr<webrtc::RTCCertificate> certificate;
+            std::chrono::steady_clock::time_point createdAt;
+        };
+
+        static std::mutex _mutex;
+        // Leaked on purpose, stopping its thread from static destructors would race with the exit of WebRTC itself
+        static CertificatePool* _default;
+
+        std::mutex mutex;
+        std::deque<Entry> ready;
+        size_t targetSize = kDefaultSize;
+        std::chrono::seconds lifetime = kDefaultLifetime;
+        bool refilling = false, rotationScheduled = false;
+        std::unique_ptr<webrtc::Thread> thread;
+
+        static webrtc::scoped_refptr<webrtc::RTCCertificate> generate();
+
+        void purgeExpired();
+
+        void scheduleRefill();
+
+        void scheduleRotation();
+
+        void refill();
+    };
+
+} // wrtc
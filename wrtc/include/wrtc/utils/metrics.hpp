@@ -0,0 +1,136 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace wrtc {
+
+    // Process-wide metric, updated without locks and exported in the Prometheus text format.
+    // Metrics are static objects that link themselves into the registry when constructed.
+    class Metric {
+    public:
+        enum class Type {
+            Counter,
+            Gauge,
+            Histogram,
+        };
+
+        Metric(const Metric&) = delete;
+
+        Metric& operator=(const Metric&) = delete;
+
+        // Snapshot of every registered metric, samples of the same name are grouped under one HELP and TYPE
+        static std::string exportText();
+
+    protected:
+        // Name, help and labels must be string literals, labels are written as in the exposition, e.g. stream="audio"
+        Metric(Type type, const char* name, const char* help, const char* labels);
+
+        virtual ~Metric() = default;
+
+        void writeSample(std::ostringstream& out, const char* suffix, const std::string& extraLabel, const std::string& value) const;
+
+        virtual void write(std::ostringstream& out) const = 0;
+
+    private:
+        Type type;
+        const char* name;
+        const char* help;
+        const char* labels;
+        Metric* next = nullptr;
+
+        static std::atomic<Metric*> head;
+    };
+
+    // Monotonic counter, sharded by thread so concurrent writers do not share a cache line
+    class Counter final : public Metric {
+    public:
+        static constexpr size_t kShards = 16;
+
+        Counter(const char* name, const char* help, const char* labels = "");
+
+        void add(const uint64_t value = 1) {
+            shards[shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        uint64_t value() const;
+
+    protected:
+        void write(std::ostringstream& out) const override;
+
+    private:
+        struct alignas(64) Shard {
+            std::atomic_uint64_t value = 0;
+        };
+
+        std::array<Shard, kShards> shards;
+
+        static std::atomic_size_t nextShard;
+
+        static size_t shardIndex();
+    };
+
+    class Gauge final : public Metric {
+    public:
+        Gauge(const char* name, const char* help, const char* labels = "");
+
+        void add(const int64_t value) {
+            current.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void set(const int64_t value) {
+            current.store(value, std::memory_order_relaxed);
+        }
+
+        int64_t value() const;
+
+    protected:
+        void write(std::ostringstream& out) const override;
+
+    private:
+        std::atomic_int64_t current = 0;
+    };
+
+    // Cumulative histogram with fixed upper bounds, an implicit +Inf bucket catches the rest
+    class Histogram final : public Metric {
+    public:
+        Histogram(const char* name, const char* help, std::initializer_list<double> bounds, const char* labels = "");
+
+        void observe(double value);
+
+    protected:
+        void write(std::ostringstream& out) const override;
+
+    private:
+        std::vector<double> bounds;
+        std::unique_ptr<std::atomic_uint64_t[]> counts;
+        std::atomic<double> sum = 0;
+    };
+
+    namespace metrics {
+        extern Gauge activeCalls;
+        extern Gauge activeReaders;
+        extern Gauge eventQueueDepth;
+        extern Gauge mixerQueueDepth;
+        extern Counter audioUnderruns;
+        extern Counter droppedAudioFrames;
+        extern Counter droppedVideoFrames;
+        extern Counter rtpBytesSent;
+        extern Counter rtpBytesReceived;
+        extern Counter rtpPacketsSent;
+        extern Counter rtpPacketsReceived;
+        extern Counter certificatePoolHits;
+        extern Counter certificatePoolMisses;
+        extern Histogram joinLatency;
+    } // metrics
+
+} // wrtc
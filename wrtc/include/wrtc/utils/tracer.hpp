@@ -0,0 +1,97 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <rtc_base/time_utils.h>
+
+namespace wrtc {
+
+    // Media pipeline trace points, recorded into per-thread rings without locks and exported as Chrome trace JSON.
+    // Every thread only writes its own ring, readers validate each slot with its sequence number.
+    class Tracer {
+    public:
+        static constexpr size_t kDefaultCapacity = 4096;
+
+        class Span {
+            const char* name;
+            int64_t arg;
+            int64_t start;
+
+        public:
+            explicit Span(const char* name, const int64_t arg = 0): name(name), arg(arg), start(enabled() ? webrtc::TimeMicros() : -1) {}
+
+            ~Span() {
+                if (start >= 0) {
+                    record(name, start, webrtc::TimeMicros() - start, arg);
+                }
+            }
+
+            Span(const Span&) = delete;
+
+            Span& operator=(const Span&) = delete;
+        };
+
+        // Capacity applies to rings of threads that record their first event afterward
+        static void setEnabled(bool enable, size_t eventsPerThread = kDefaultCapacity);
+
+        static bool enabled() {
+            return active.load(std::memory_order_relaxed);
+        }
+
+        static void instant(const char* name, int64_t arg = 0);
+
+        // Name must be a string literal, only its pointer is stored
+        static void record(const char* name, int64_t start, int64_t duration, int64_t arg);
+
+        static std::string exportJson();
+
+    private:
+        struct Slot {
+            std::atomic_uint64_t sequence = 0;
+            std::atomic<const char*> name = nullptr;
+            std::atomic_int64_t start = 0, duration = 0, arg = 0;
+        };
+
+        struct Ring {
+            std::unique_ptr<Slot[]> slots;
+            size_t capacity;
+            std::atomic_uint64_t head = 0;
+            // Events before base belong to the thread that owned the ring previously
+            uint64_t base = 0;
+            int64_t threadId = 0;
+            std::string threadName;
+            bool retired = false;
+        };
+
+        struct RingHandle {
+            Ring* ring = nullptr;
+
+            ~RingHandle();
+        };
+
+        static std::atomic_bool active;
+        static std::atomic_size_t capacity;
+        static std::mutex mutex;
+        static std::vector<std::unique_ptr<Ring>> rings;
+
+        static Ring* currentRing();
+    };
+
+} // wrtc
+
+#ifdef NTG_TRACING
+#define WRTC_TRACE_CONCAT_INNER(a, b) a##b
+#define WRTC_TRACE_CONCAT(a, b) WRTC_TRACE_CONCAT_INNER(a, b)
+#define WRTC_TRACE_SCOPE(...) wrtc::Tracer::Span WRTC_TRACE_CONCAT(traceSpan, __LINE__)(__VA_ARGS__)
+#define WRTC_TRACE_INSTANT(...) do { if (wrtc::Tracer::enabled()) wrtc::Tracer::instant(__VA_ARGS__); } while (false)
+#else
+#define WRTC_TRACE_SCOPE(...)
+#define WRTC_TRACE_INSTANT(...) do {} while (false)
+#endif
@@ -0,0 +1,60 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#pragma once
+
+#include <api/video_codecs/video_decoder.h>
+#include <api/video_codecs/video_encoder.h>
+
+namespace wrtc {
+
+    // Forwards to the wrapped encoder, recording each Encode call as a trace span
+    class TracedVideoEncoder final : public webrtc::VideoEncoder {
+        std::unique_ptr<webrtc::VideoEncoder> encoder;
+
+    public:
+        explicit TracedVideoEncoder(std::unique_ptr<webrtc::VideoEncoder> encoder);
+
+        void SetFecControllerOverride(webrtc::FecControllerOverride* fecControllerOverride) override;
+
+        int32_t InitEncode(const webrtc::VideoCodec* codecSettings, const Settings& settings) override;
+
+        int32_t RegisterEncodeCompleteCallback(webrtc::EncodedImageCallback* callback) override;
+
+        int32_t Release() override;
+
+        int32_t Encode(const webrtc::VideoFrame& frame, const std::vector<webrtc::VideoFrameType>* frameTypes) override;
+
+        void SetRates(const RateControlParameters& parameters) override;
+
+        void OnPacketLossRateUpdate(float packetLossRate) override;
+
+        void OnRttUpdate(int64_t rttMs) override;
+
+        void OnLossNotification(const LossNotification& lossNotification) override;
+
+        [[nodiscard]] EncoderInfo GetEncoderInfo() const override;
+    };
+
+    // Forwards to the wrapped decoder, recording each Decode call as a trace span
+    class TracedVideoDecoder final : public webrtc::VideoDecoder {
+        std::unique_ptr<webrtc::VideoDecoder> decoder;
+
+    public:
+        explicit TracedVideoDecoder(std::unique_ptr<webrtc::VideoDecoder> decoder);
+
+        bool Configure(const Settings& settings) override;
+
+        int32_t Decode(const webrtc::EncodedImage& inputImage, bool missingFrames, int64_t renderTimeMs) override;
+
+        int32_t RegisterDecodeCompleteCallback(webrtc::DecodedImageCallback* callback) override;
+
+        int32_t Release() override;
+
+        [[nodiscard]] DecoderInfo GetDecoderInfo() const override;
+
+        [[nodiscard]] const char* ImplementationName() const override;
+    };
+
+} // wrtc
@@ -0,0 +1,34 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <wrtc/interfaces/batched_packet_socket_factory.hpp>
+
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+#include <wrtc/interfaces/batched_udp_socket.hpp>
+
+namespace wrtc {
+    BatchedPacketSocketFactory::BatchedPacketSocketFactory(webrtc::PhysicalSocketServer* server): BasicPacketSocketFactory(server), server(server) {}
+
+    void BatchedPacketSocketFactory::setSharedSockets(const uint32_t socketsPerAddress) {
+        sharedSocketsPerAddress = socketsPerAddress;
+    }
+
+    std::unique_ptr<webrtc::AsyncPacketSocket> BatchedPacketSocketFactory::CreateUdpSocket(const webrtc::Environment& env, const webrtc::SocketAddress& address, const uint16_t minPort, const uint16_t maxPort) {
+        // Sockets asking for a specific port or range keep their own
+        if (const auto shared = sharedSocketsPerAddress.load(); shared && address.port() == 0 && minPort == 0 && maxPort == 0) {
+            if (!sharedPool) {
+                sharedPool = std::make_unique<SharedUdpSocketPool>(server, shared);
+            }
+            sharedPool->setSocketsPerAddress(shared);
+            if (auto socket = sharedPool->CreateSocket(address)) {
+                return socket;
+            }
+        }
+        if (auto socket = BatchedUdpSocket::Create(server, address, minPort, maxPort)) {
+            return socket;
+        }
+        return BasicPacketSocketFactory::CreateUdpSocket(env, address, minPort, maxPort);
+    }
+} // wrtc
+#endif
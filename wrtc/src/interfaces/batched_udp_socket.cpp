@@ -0,0 +1,455 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <wrtc/interfaces/batched_udp_socket.hpp>
+
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+#include <array>
+#include <cstring>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <rtc_base/logging.h>
+#include <rtc_base/time_utils.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+namespace wrtc {
+    namespace {
+        constexpr size_t kBatchSize = 32;
+        constexpr size_t kMaxPacketSize = 2048;
+        // Reads handled per wakeup before giving the other sockets a turn
+        constexpr size_t kMaxReadRounds = 8;
+        constexpr size_t kMaxPending = 256;
+        constexpr size_t kMaxSegments = 64;
+        constexpr size_t kMaxGsoBytes = 65000;
+
+        union SegmentControl {
+            char buffer[CMSG_SPACE(sizeof(uint16_t))];
+            cmsghdr align;
+        };
+    }
+
+    std::atomic_uint64_t BatchedUdpSocket::readWakeups = 0;
+    std::atomic_uint64_t BatchedUdpSocket::packetsReceived = 0;
+    std::atomic_uint64_t BatchedUdpSocket::sendFlushes = 0;
+    std::atomic_uint64_t BatchedUdpSocket::packetsSent = 0;
+    std::atomic_uint64_t BatchedUdpSocket::gsoSends = 0;
+    std::atomic_uint32_t BatchedUdpSocket::maxReadBatch = 0;
+    std::atomic_uint32_t BatchedUdpSocket::maxSendBatch = 0;
+
+    BatchedUdpSocket::BatchedUdpSocket(webrtc::PhysicalSocketServer* server, const int fd, const int family, const webrtc::SocketAddress& localAddress):
+        server(server), thread(webrtc::Thread::Current()), fd(fd), family(family), localAddress(localAddress) {
+        int segment = 0;
+        socklen_t length = sizeof(segment);
+        gsoEnabled = getsockopt(fd, SOL_UDP, UDP_SEGMENT, &segment, &length) == 0;
+        sendBuffer.reserve(kMaxPending * kMaxPacketSize / 4);
+        pending.reserve(kMaxPending);
+        server->Add(this);
+    }
+
+    std::unique_ptr<BatchedUdpSocket> BatchedUdpSocket::Create(webrtc::PhysicalSocketServer* server, const webrtc::SocketAddress& address, const uint16_t minPort, const uint16_t maxPort) {
+        const int family = address.family();
+        const int fd = socket(family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            RTC_LOG(LS_WARNING) << "Failed to create batched UDP socket: " << errno;
+            return nullptr;
+        }
+        const auto bindTo = [&](const uint16_t port) {
+            const webrtc::SocketAddress candidate(address.ipaddr(), port);
+            sockaddr_storage storage{};
+            const auto length = candidate.ToSockAddrStorage(&storage);
+            return bind(fd, reinterpret_cast<sockaddr*>(&storage), static_cast<socklen_t>(length)) == 0;
+        };
+        bool bound = false;
+        if (minPort == 0 && maxPort == 0) {
+            bound = bindTo(address.port());
+        } else {
+            for (uint32_t port = minPort; !bound && port <= maxPort; port++) {
+                bound = bindTo(static_cast<uint16_t>(port));
+            }
+        }
+        sockaddr_storage storage{};
+        socklen_t length = sizeof(storage);
+        webrtc::SocketAddress localAddress;
+        if (!bound || getsockname(fd, reinterpret_cast<sockaddr*>(&storage), &length) != 0 || !webrtc::SocketAddressFromSockAddrStorage(storage, &localAddress)) {
+            RTC_LOG(LS_WARNING) << "Failed to bind batched UDP socket to " << address.ToSensitiveString() << ": " << errno;
+            close(fd);
+            return nullptr;
+        }
+        return std::unique_ptr<BatchedUdpSocket>(new BatchedUdpSocket(server, fd, family, localAddress));
+    }
+
+    BatchedUdpSocket::~BatchedUdpSocket() {
+        Close();
+    }
+
+    webrtc::SocketAddress BatchedUdpSocket::GetLocalAddress() const {
+        return localAddress;
+    }
+
+    webrtc::SocketAddress BatchedUdpSocket::GetRemoteAddress() const {
+        return {};
+    }
+
+    int BatchedUdpSocket::Send(const void*, size_t, const webrtc::AsyncSocketPacketOptions&) {
+        SetError(ENOTCONN);
+        return -1;
+    }
+
+    int BatchedUdpSocket::SendTo(const void* data, const size_t size, const webrtc::SocketAddress& addr, const webrtc::AsyncSocketPacketOptions& options) {
+        if (fd < 0) {
+            SetError(EBADF);
+            return -1;
+        }
+        if (size > kMaxGsoBytes) {
+            SetError(EMSGSIZE);
+            return -1;
+        }
+        if (pending.size() >= kMaxPending) {
+            const auto alive = taskSafety.flag();
+            Flush();
+            if (!alive->alive()) {
+                return -1;
+            }
+            if (pending.size() >= kMaxPending) {
+                SetError(EWOULDBLOCK);
+                return -1;
+            }
+        }
+        PendingPacket packet{};
+        packet.addressLength = static_cast<socklen_t>(
+            family == AF_INET6 && addr.family() == AF_INET ? addr.ToDualStackSockAddrStorage(&packet.address) : addr.ToSockAddrStorage(&packet.address)
+        );
+        if (packet.addressLength == 0) {
+            SetError(EINVAL);
+            return -1;
+        }
+        packet.offset = sendBuffer.size();
+        packet.size = size;
+        packet.packetId = options.packet_id;
+        packet.info = options.info_signaled_after_sent;
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        sendBuffer.insert(sendBuffer.end(), bytes, bytes + size);
+        pending.push_back(packet);
+        // Everything sent during the current task goes out with a single sendmmsg
+        if (!flushScheduled && !writeBlocked) {
+            flushScheduled = true;
+            thread->PostTask(SafeTask(taskSafety.flag(), [this] {
+                flushScheduled = false;
+                Flush();
+            }));
+        }
+        return static_cast<int>(size);
+    }
+
+    int BatchedUdpSocket::Close() {
+        if (fd < 0) {
+            return 0;
+        }
+        server->Remove(this);
+        close(fd);
+        fd = -1;
+        pending.clear();
+        sendBuffer.clear();
+        return 0;
+    }
+
+    webrtc::AsyncPacketSocket::State BatchedUdpSocket::GetState() const {
+        return fd < 0 ? STATE_CLOSED : STATE_BOUND;
+    }
+
+    int BatchedUdpSocket::GetOption(const webrtc::Socket::Option opt, int* value) {
+        int level, name;
+        switch (opt) {
+        case webrtc::Socket::OPT_RCVBUF:
+            level = SOL_SOCKET;
+            name = SO_RCVBUF;
+            break;
+        case webrtc::Socket::OPT_SNDBUF:
+            level = SOL_SOCKET;
+            name = SO_SNDBUF;
+            break;
+        case webrtc::Socket::OPT_DSCP:
+            level = family == AF_INET6 ? IPPROTO_IPV6 : IPPROTO_IP;
+            name = family == AF_INET6 ? IPV6_TCLASS : IP_TOS;
+            break;
+        default:
+            return -1;
+        }
+        socklen_t length = sizeof(*value);
+        if (getsockopt(fd, level, name, value, &length) != 0) {
+            SetError(errno);
+            return -1;
+        }
+        if (opt == webrtc::Socket::OPT_DSCP) {
+            *value >>= 2;
+        }
+        return 0;
+    }
+
+    int BatchedUdpSocket::SetOption(const webrtc::Socket::Option opt, int value) {
+        int level, name;
+        switch (opt) {
+        case webrtc::Socket::OPT_RCVBUF:
+            level = SOL_SOCKET;
+            name = SO_RCVBUF;
+            break;
+        case webrtc::Socket::OPT_SNDBUF:
+            level = SOL_SOCKET;
+            name = SO_SNDBUF;
+            break;
+        case webrtc::Socket::OPT_DSCP:
+            level = family == AF_INET6 ? IPPROTO_IPV6 : IPPROTO_IP;
+            name = family == AF_INET6 ? IPV6_TCLASS : IP_TOS;
+            value <<= 2;
+            break;
+        case webrtc::Socket::OPT_DONTFRAGMENT:
+            level = family == AF_INET6 ? IPPROTO_IPV6 : IPPROTO_IP;
+            name = family == AF_INET6 ? IPV6_MTU_DISCOVER : IP_MTU_DISCOVER;
+            value = value ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
+            break;
+        default:
+            return -1;
+        }
+        if (setsockopt(fd, level, name, &value, sizeof(value)) != 0) {
+            SetError(errno);
+            return -1;
+        }
+        return 0;
+    }
+
+    int BatchedUdpSocket::GetError() const {
+        return error;
+    }
+
+    void BatchedUdpSocket::SetError(const int error) {
+        this->error = error;
+    }
+
+    uint32_t BatchedUdpSocket::GetRequestedEvents() {
+        return requestedEvents;
+    }
+
+    void BatchedUdpSocket::OnEvent(const uint32_t ff, int) {
+        const auto alive = taskSafety.flag();
+        if (ff & webrtc::DE_READ) {
+            DrainReads();
+            if (!alive->alive() || fd < 0) {
+                return;
+            }
+        }
+        if (ff & webrtc::DE_WRITE) {
+            SetWriteBlocked(false);
+            Flush();
+            if (alive->alive() && !writeBlocked) {
+                SignalReadyToSend(this);
+            }
+        }
+    }
+
+    int BatchedUdpSocket::GetDescriptor() {
+        return fd;
+    }
+
+    bool BatchedUdpSocket::IsDescriptorClosed() {
+        return fd < 0;
+    }
+
+    BatchedUdpSocket::Stats BatchedUdpSocket::GetStats() {
+        return {
+            readWakeups,
+            packetsReceived,
+            maxReadBatch,
+            sendFlushes,
+            packetsSent,
+            maxSendBatch,
+            gsoSends,
+        };
+    }
+
+    void BatchedUdpSocket::DrainReads() {
+        thread_local std::array<std::array<uint8_t, kMaxPacketSize>, kBatchSize> buffers;
+        thread_local std::array<sockaddr_storage, kBatchSize> addresses;
+        thread_local std::array<iovec, kBatchSize> iovs;
+        thread_local std::array<mmsghdr, kBatchSize> messages;
+
+        const auto alive = taskSafety.flag();
+        uint32_t batch = 0;
+        for (size_t round = 0; round < kMaxReadRounds; round++) {
+            for (size_t i = 0; i < kBatchSize; i++) {
+                iovs[i] = {buffers[i].data(), buffers[i].size()};
+                auto& header = messages[i].msg_hdr;
+                header = {};
+                header.msg_name = &addresses[i];
+                header.msg_namelen = sizeof(sockaddr_storage);
+                header.msg_iov = &iovs[i];
+                header.msg_iovlen = 1;
+            }
+            const int received = recvmmsg(fd, messages.data(), kBatchSize, MSG_DONTWAIT, nullptr);
+            if (received <= 0) {
+                if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                    SetError(errno);
+                }
+                break;
+            }
+            batch += received;
+            const auto arrival = webrtc::Timestamp::Micros(webrtc::TimeMicros());
+            for (int i = 0; i < received; i++) {
+                if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                    RTC_LOG(LS_VERBOSE) << "Dropping truncated datagram on " << localAddress.ToSensitiveString();
+                    continue;
+                }
+                webrtc::SocketAddress source;
+                webrtc::SocketAddressFromSockAddrStorage(addresses[i], &source);
+                NotifyPacketReceived(webrtc::ReceivedIpPacket(
+                    webrtc::MakeArrayView(buffers[i].data(), messages[i].msg_len),
+                    source,
+                    arrival
+                ));
+                // The socket may be closed or destroyed by any packet handler
+                if (!alive->alive() || fd < 0) {
+                    return;
+                }
+            }
+            if (received < static_cast<int>(kBatchSize)) {
+                break;
+            }
+        }
+        readWakeups++;
+        packetsReceived += batch;
+        UpdateMax(maxReadBatch, batch);
+    }
+
+    void BatchedUdpSocket::Flush() {
+        if (fd < 0 || writeBlocked || pending.empty()) {
+            return;
+        }
+        thread_local std::array<mmsghdr, kBatchSize> messages;
+        thread_local std::array<iovec, kBatchSize> iovs;
+        thread_local std::array<SegmentControl, kBatchSize> controls;
+        thread_local std::array<size_t, kBatchSize> runEnds;
+
+        const auto alive = taskSafety.flag();
+        size_t next = 0;
+        while (next < pending.size()) {
+            size_t count = 0;
+            bool usedGso = false;
+            for (size_t cursor = next; count < kBatchSize && cursor < pending.size(); count++) {
+                const auto& first = pending[cursor];
+                size_t end = cursor + 1;
+                size_t total = first.size;
+                // GSO needs equal sized segments to one destination, only the last one may be shorter
+                while (gsoEnabled && end < pending.size() && end - cursor < kMaxSegments &&
+                    pending[end - 1].size == first.size && pending[end].size <= first.size &&
+                    total + pending[end].size <= kMaxGsoBytes &&
+                    pending[end].addressLength == first.addressLength &&
+                    memcmp(&pending[end].address, &first.address, first.addressLength) == 0) {
+                    total += pending[end].size;
+                    end++;
+                }
+                // Packets are appended in order, so a run is contiguous in the send buffer
+                iovs[count] = {sendBuffer.data() + first.offset, total};
+                auto& header = messages[count].msg_hdr;
+                header = {};
+                header.msg_name = const_cast<sockaddr_storage*>(&first.address);
+                header.msg_namelen = first.addressLength;
+                header.msg_iov = &iovs[count];
+                header.msg_iovlen = 1;
+                if (end - cursor > 1) {
+                    usedGso = true;
+                    header.msg_control = controls[count].buffer;
+                    header.msg_controllen = sizeof(controls[count].buffer);
+                    auto* cmsg = CMSG_FIRSTHDR(&header);
+                    cmsg->cmsg_level = SOL_UDP;
+                    cmsg->cmsg_type = UDP_SEGMENT;
+                    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                    const auto segmentSize = static_cast<uint16_t>(first.size);
+                    memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+                }
+                runEnds[count] = end;
+                cursor = end;
+            }
+
+            const int sent = sendmmsg(fd, messages.data(), static_cast<unsigned int>(count), MSG_DONTWAIT);
+            size_t consumed;
+            if (sent == 0) {
+                SetWriteBlocked(true);
+                break;
+            }
+            if (sent < 0) {
+                const int sendError = errno;
+                if (sendError == EAGAIN || sendError == EWOULDBLOCK) {
+                    SetWriteBlocked(true);
+                    break;
+                }
+                if (usedGso && (sendError == EIO || sendError == EINVAL)) {
+                    RTC_LOG(LS_WARNING) << "UDP GSO rejected (" << sendError << "), sending one datagram per message";
+                    gsoEnabled = false;
+                    continue;
+                }
+                // Drop the first message, like a failed sendto would
+                SetError(sendError);
+                RTC_LOG(LS_VERBOSE) << "sendmmsg failed on " << localAddress.ToSensitiveString() << ": " << sendError;
+                consumed = 1;
+            } else {
+                consumed = sent;
+                sendFlushes++;
+                packetsSent += runEnds[consumed - 1] - next;
+                UpdateMax(maxSendBatch, static_cast<uint32_t>(runEnds[consumed - 1] - next));
+                for (size_t i = 0; i < consumed; i++) {
+                    if (messages[i].msg_hdr.msg_controllen) {
+                        gsoSends++;
+                    }
+                }
+            }
+
+            const auto end = runEnds[consumed - 1];
+            const auto now = webrtc::TimeMillis();
+            for (size_t i = next; i < end; i++) {
+                webrtc::SentPacketInfo sentPacket(pending[i].packetId, now, pending[i].info);
+                webrtc::CopySocketInformationToPacketInfo(pending[i].size, *this, &sentPacket.info);
+                SignalSentPacket(this, sentPacket);
+                if (!alive->alive()) {
+                    return;
+                }
+            }
+            if (fd < 0) {
+                return;
+            }
+            next = end;
+        }
+
+        if (next == pending.size()) {
+            pending.clear();
+            sendBuffer.clear();
+        } else if (next > 0) {
+            const auto base = pending[next].offset;
+            sendBuffer.erase(sendBuffer.begin(), sendBuffer.begin() + static_cast<std::ptrdiff_t>(base));
+            pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(next));
+            for (auto& packet : pending) {
+                packet.offset -= base;
+            }
+        }
+    }
+
+    void BatchedUdpSocket::SetWriteBlocked(const bool blocked) {
+        if (writeBlocked == blocked) {
+            return;
+        }
+        writeBlocked = blocked;
+        requestedEvents = blocked ? webrtc::DE_READ | webrtc::DE_WRITE : webrtc::DE_READ;
+        server->Update(this);
+    }
+
+    void BatchedUdpSocket::UpdateMax(std::atomic_uint32_t& max, const uint32_t value) {
+        auto current = max.load(std::memory_order_relaxed);
+        while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+} // wrtc
+#endif
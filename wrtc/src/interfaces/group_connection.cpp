@@ -77,6 +77,9 @@ namespace wrtc {
     }
 
     void GroupConnection::start() {
+        if (nullNetwork) {
+            return;
+        }
         transportChannel->MaybeStartGathering();
         restartDataChannel();
     }
@@ -160,7 +163,7 @@ namespace wrtc {
         std::weak_ptr weak(shared_from_this());
         networkThread()->PostTask([weak, candidate] {
             const auto strong = std::static_pointer_cast<const GroupConnection>(weak.lock());
-            if (!strong) {
+            if (!strong || !strong->transportChannel) {
                 return;
             }
             strong->transportChannel->AddRemoteCandidate(candidate);
@@ -175,6 +178,9 @@ namespace wrtc {
                 return;
             }
             strong->remoteParameters = remoteIceParameters;
+            if (!strong->transportChannel) {
+                return;
+            }
             const webrtc::IceParameters parameters(
                 remoteIceParameters.ufrag,
                 remoteIceParameters.pwd,
@@ -215,7 +221,7 @@ namespace wrtc {
                 mtprotoStream = nullptr;
                 alreadyConnected = false;
                 if (const auto audioSink = remoteAudioSink.lock()) {
-                    audioSink->updateAudioSourceCount(0);
+                    audioSink->clear();
                 }
                 remoteScreenCastSink.reset();
             }
@@ -254,15 +260,6 @@ namespace wrtc {
                     }
                 }
             });
-            mtprotoStream->onUpdateAudioSourceCount([weak](const int count) {
-                const auto strong = std::static_pointer_cast<GroupConnection>(weak.lock());
-                if (!strong) {
-                    return;
-                }
-                if (const auto audioSink = strong->remoteAudioSink.lock()) {
-                    audioSink->updateAudioSourceCount(count);
-                }
-            });
             break;
         default:
             throw RTCException("Invalid connection mode");
@@ -338,17 +335,19 @@ namespace wrtc {
             return;
         }
         const std::string endpoint = std::to_string(packet.Ssrc());
+        std::lock_guard lock(mutex);
+        const auto channel = incomingAudioChannels.find(endpoint);
         if (packet.HasExtension(webrtc::kRtpExtensionAudioLevel)) {
             webrtc::AudioLevel audioLevel;
             if (packet.GetExtension<webrtc::AudioLevelExtension>(&audioLevel)) {
-                if (incomingAudioChannels.contains(endpoint)) incomingAudioChannels[endpoint]->updateActivity();
+                if (channel != incomingAudioChannels.end()) channel->second->updateActivity();
             }
         }
         if (packet.PayloadType() == 111) {
-            if (!incomingAudioChannels.contains(endpoint)) {
+            if (channel == incomingAudioChannels.end()) {
                 addIncomingAudio(packet.Ssrc(), endpoint);
             } else {
-                incomingAudioChannels[endpoint]->updateActivity();
+                channel->second->updateActivity();
             }
         }
     }
@@ -363,18 +362,6 @@ namespace wrtc {
         audioContent.rtpExtensions = media.audioRtpExtensions;
         audioContent.payloadTypes = media.audioPayloadTypes;
 
-        if (!audioChannel) {
-            audioChannel = std::make_unique<OutgoingAudioChannel>(
-                call.get(),
-                channelManager.get(),
-                dtlsSrtpTransport.get(),
-                audioContent,
-                workerThread(),
-                networkThread(),
-                &audioSink
-            );
-        }
-
         if (videoChannel && videoChannel->ssrc() != outgoingVideoSsrc) {
             videoChannel = nullptr;
         }
@@ -385,26 +372,28 @@ namespace wrtc {
         videoContent.rtpExtensions = media.videoRtpExtensions;
         videoContent.payloadTypes = media.videoPayloadTypes;
 
-        if (!videoChannel) {
-            videoChannel = std::make_unique<OutgoingVideoChannel>(
-                call.get(),
-                channelManager.get(),
-                dtlsSrtpTransport.get(),
-                videoContent,
-                workerThread(),
-                networkThread(),
-                &videoSink
-            );
+        createOutgoingChannels(audioContent, videoContent);
+
+        if (nullNetwork == NullTransport::Mode::Loopback) {
+            // Our own audio shows up as an unknown ssrc, video needs its groups announced like a remote participant
+            addIncomingVideo(std::to_string(outgoingVideoSsrc), outgoingVideoSsrcGroups);
         }
     }
 
     uint32_t GroupConnection::addIncomingVideo(const std::string& endpoint, const std::vector<SsrcGroup>& ssrcGroups) {
-        if (pendingContent.contains(endpoint)) {
-            return 0;
-        }
         MediaContent mediaContent;
         mediaContent.type = MediaContent::Type::Video;
         mediaContent.ssrcGroups = ssrcGroups;
+        {
+            std::lock_guard lock(mutex);
+            if (pendingContent.contains(endpoint)) {
+                return 0;
+            }
+            if (!mtprotoStream) {
+                // Listed right away so getEndpoints sees it, the channel itself is set up on the worker thread
+                pendingContent[endpoint] = mediaContent;
+            }
+        }
         if (mtprotoStream) {
             mtprotoStream->addIncomingVideo(
                 endpoint,
@@ -412,7 +401,19 @@ namespace wrtc {
                 mediaContent.isScreenCast()
             );
         } else {
-            addIncomingSmartSource(endpoint, mediaContent);
+            std::weak_ptr weak(shared_from_this());
+            workerThread()->PostTask([weak, endpoint, mediaContent] {
+                const auto strong = std::static_pointer_cast<GroupConnection>(weak.lock());
+                if (!strong) {
+                    return;
+                }
+                std::lock_guard lock(strong->mutex);
+                // Removed again before the worker got to it
+                if (!strong->pendingContent.contains(endpoint)) {
+                    return;
+                }
+                strong->createIncomingSources({{endpoint, mediaContent}}, true);
+            });
         }
         return mediaContent.mainSsrc();
     }
@@ -421,11 +422,18 @@ namespace wrtc {
         if (mtprotoStream) {
             return mtprotoStream->removeIncomingVideo(endpoint);
         }
-        if (!pendingContent.contains(endpoint)) {
-            return false;
+        std::vector<std::unique_ptr<IncomingVideoChannel>> removed;
+        {
+            std::lock_guard lock(mutex);
+            if (!pendingContent.contains(endpoint)) {
+                return false;
+            }
+            if (auto node = incomingVideoChannels.extract(endpoint)) {
+                removed.push_back(std::move(node.mapped()));
+            }
+            pendingContent.erase(endpoint);
         }
-        if (incomingVideoChannels.contains(endpoint)) incomingVideoChannels.erase(endpoint);
-        pendingContent.erase(endpoint);
+        releaseIncomingChannels({}, std::move(removed));
         return true;
     }
 
@@ -435,7 +443,7 @@ namespace wrtc {
         audioContent.ssrc = ssrc;
         audioContent.rtpExtensions = mediaConfig.audioRtpExtensions;
         audioContent.payloadTypes = mediaConfig.audioPayloadTypes;
-        addIncomingSmartSource(endpoint, audioContent);
+        createIncomingSources({{endpoint, audioContent}}, false);
     }
 
     void GroupConnection::enableAudioIncoming(const bool enable) {
@@ -472,9 +480,7 @@ namespace wrtc {
                     removeChannels.push_back(channelId);
                 }
             }
-            for (const auto &channelId : removeChannels) {
-                strong->removeIncomingAudio(channelId);
-            }
+            strong->removeIncomingAudio(removeChannels);
             strong->beginAudioChannelCleanupTimer();
         }, webrtc::TimeDelta::Millis(500));
     }
@@ -0,0 +1,238 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <algorithm>
+#include <ranges>
+#include <thread>
+#include <modules/rtp_rtcp/source/rtp_packet_received.h>
+#include <p2p/base/p2p_constants.h>
+#include <rtc_base/crypto_random.h>
+#include <rtc_base/logging.h>
+#include <rtc_base/ssl_fingerprint.h>
+#include <wrtc/exceptions.hpp>
+#include <wrtc/interfaces/local_sfu.hpp>
+#include <wrtc/interfaces/native_network_interface.hpp>
+#include <wrtc/models/response_payload.hpp>
+#include <wrtc/utils/certificate_pool.hpp>
+#include <wrtc/utils/json.hpp>
+
+namespace wrtc {
+    LocalSfu::LocalSfu():
+        factory(PeerConnectionFactory::GetOrCreateDefault()),
+        env(PeerConnectionFactory::environment()),
+        certificate(CertificatePool::GetOrCreateDefault()->take()) {
+        socketFactory = std::make_unique<webrtc::BasicPacketSocketFactory>(factory->networkThread()->socketserver());
+    }
+
+    LocalSfu::~LocalSfu() {
+        // Nothing left to tear down, spares the network thread at exit
+        if (participants.empty()) {
+            return;
+        }
+        factory->networkThread()->BlockingCall([this] {
+            for (auto& participant : participants | std::views::values) {
+                release(std::move(participant));
+            }
+            participants.clear();
+        });
+    }
+
+    std::string LocalSfu::join(const std::string& joinPayload) {
+        uint32_t ssrc;
+        webrtc::IceParameters remoteParameters;
+        std::unique_ptr<webrtc::SSLFingerprint> remoteFingerprint;
+        try {
+            auto data = json::parse(joinPayload);
+            ssrc = static_cast<uint32_t>(data["ssrc"].get<int32_t>());
+            remoteParameters = webrtc::IceParameters(data["ufrag"].get<std::string>(), data["pwd"].get<std::string>(), false);
+            if (!data["fingerprints"].empty()) {
+                remoteFingerprint = webrtc::SSLFingerprint::CreateUniqueFromRfc4572(
+                    data["fingerprints"][0]["hash"].get<std::string>(),
+                    data["fingerprints"][0]["fingerprint"].get<std::string>()
+                );
+            }
+        } catch (std::exception& e) {
+            RTC_LOG(LS_ERROR) << "Invalid join payload: " << e.what();
+            throw TransportParseException("Invalid join payload");
+        }
+        if (!remoteFingerprint) {
+            RTC_LOG(LS_ERROR) << "Join payload has no usable fingerprint";
+            throw TransportParseException("Fingerprint not found");
+        }
+
+        const webrtc::IceParameters localParameters(
+            webrtc::CreateRandomString(webrtc::ICE_UFRAG_LENGTH),
+            webrtc::CreateRandomString(webrtc::ICE_PWD_LENGTH),
+            false
+        );
+        factory->networkThread()->BlockingCall([&] {
+            auto participant = std::make_unique<Participant>();
+            participant->portAllocator = std::make_unique<webrtc::BasicPortAllocator>(
+                env,
+                factory->networkManager(),
+                socketFactory.get(),
+                nullptr,
+                nullptr
+            );
+            participant->portAllocator->set_flags(
+                participant->portAllocator->flags() |
+                webrtc::PORTALLOCATOR_DISABLE_TCP |
+                webrtc::PORTALLOCATOR_DISABLE_STUN |
+                webrtc::PORTALLOCATOR_DISABLE_RELAY
+            );
+            participant->portAllocator->SetNetworkIgnoreMask(0);
+            participant->portAllocator->set_step_delay(webrtc::kMinimumStepDelay);
+            participant->portAllocator->Initialize();
+            participant->portAllocator->SetConfiguration({}, {}, 0, webrtc::NO_PRUNE);
+
+            webrtc::IceTransportInit iceTransportInit(env);
+            iceTransportInit.set_port_allocator(participant->portAllocator.get());
+            participant->transportChannel = webrtc::P2PTransportChannel::Create("sfu", 0, std::move(iceTransportInit));
+            webrtc::IceConfig iceConfig;
+            iceConfig.continual_gathering_policy = webrtc::GATHER_ONCE;
+            participant->transportChannel->SetIceConfig(iceConfig);
+            participant->transportChannel->SetIceParameters(localParameters);
+            participant->transportChannel->SetRemoteIceParameters(remoteParameters);
+            participant->transportChannel->SetIceRole(webrtc::ICEROLE_CONTROLLING);
+            participant->transportChannel->SubscribeCandidateGathered([raw = participant.get()](webrtc::IceTransportInternal*, const webrtc::Candidate& candidate) {
+                raw->candidates.push_back(candidate);
+            });
+
+            // Clients join as the passive side, so the handshake starts from here
+            participant->dtlsTransport = std::make_unique<webrtc::DtlsTransportInternalImpl>(env, participant->transportChannel.get(), NativeNetworkInterface::getDefaultCryptoOptions());
+            participant->dtlsTransport->SetDtlsRole(webrtc::SSL_CLIENT);
+            participant->dtlsTransport->SetLocalCertificate(certificate);
+            participant->dtlsTransport->SetRemoteParameters(remoteFingerprint->algorithm, remoteFingerprint->digest.data(), remoteFingerprint->digest.size(), std::nullopt);
+
+            participant->srtpTransport = std::make_unique<WrappedDtlsSrtpTransport>(
+                true,
+                env.field_trials(),
+                [this, ssrc](const webrtc::RtpPacketReceived& packet) {
+                    forwardRtp(ssrc, packet.Buffer());
+                }
+            );
+            participant->srtpTransport->SubscribeRtcpPacketReceived(participant.get(), [this, ssrc](webrtc::CopyOnWriteBuffer packet, std::optional<webrtc::Timestamp>, webrtc::EcnMarking) {
+                forwardRtcp(ssrc, packet);
+            });
+            participant->srtpTransport->SetDtlsTransports(participant->dtlsTransport.get(), nullptr);
+            participant->transportChannel->MaybeStartGathering();
+
+            if (const auto previous = participants.find(ssrc); previous != participants.end()) {
+                RTC_LOG(LS_WARNING) << "Participant " << ssrc << " joined the local SFU again, dropping the previous transport";
+                auto stale = std::move(previous->second);
+                participants.erase(previous);
+                release(std::move(stale));
+            }
+            participants.emplace(ssrc, std::move(participant));
+        });
+
+        // Host candidates only, gathering takes a few milliseconds
+        std::vector<webrtc::Candidate> candidates;
+        for (int attempt = 0; attempt < 200; attempt++) {
+            const auto complete = factory->networkThread()->BlockingCall([&] {
+                const auto participant = participants.find(ssrc);
+                if (participant == participants.end() || participant->second->transportChannel->gathering_state() != webrtc::kIceGatheringComplete) {
+                    return false;
+                }
+                candidates = participant->second->candidates;
+                return true;
+            });
+            if (complete) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        // Loopback keeps every packet on this host, other addresses are only offered when it is missing
+        if (std::ranges::any_of(candidates, [](const webrtc::Candidate& candidate) { return candidate.address().IsLoopbackIP(); })) {
+            std::erase_if(candidates, [](const webrtc::Candidate& candidate) {
+                return !candidate.address().IsLoopbackIP();
+            });
+        }
+        if (candidates.empty()) {
+            leave(ssrc);
+            RTC_LOG(LS_ERROR) << "Local SFU gathered no candidates";
+            throw RTCException("Local SFU gathered no candidates");
+        }
+
+        auto rawCandidates = json::array();
+        for (const auto& candidate : candidates) {
+            rawCandidates.push_back({
+                {"generation", "0"},
+                {"component", "1"},
+                {"protocol", candidate.protocol()},
+                {"port", std::to_string(candidate.address().port())},
+                {"ip", candidate.address().ipaddr().ToString()},
+                {"foundation", candidate.foundation()},
+                {"id", candidate.id()},
+                {"priority", std::to_string(candidate.priority())},
+                {"type", "host"},
+                {"network", std::to_string(candidate.network_id())}
+            });
+        }
+        const auto fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*certificate);
+        auto response = ResponsePayload::defaultMedia();
+        response["transport"] = json{
+            {"ufrag", localParameters.ufrag},
+            {"pwd", localParameters.pwd},
+            {"fingerprints",
+                {
+                    {
+                        {"hash", fingerprint->algorithm},
+                        {"setup", "active"},
+                        {"fingerprint", fingerprint->GetRfc4572Fingerprint()}
+                    }
+                }
+            },
+            {"candidates", rawCandidates}
+        };
+        RTC_LOG(LS_INFO) << "Participant " << ssrc << " joined the local SFU with " << candidates.size() << " candidates";
+        return response.dump();
+    }
+
+    bool LocalSfu::leave(const uint32_t ssrc) {
+        return factory->networkThread()->BlockingCall([&] {
+            const auto participant = participants.find(ssrc);
+            if (participant == participants.end()) {
+                return false;
+            }
+            auto removed = std::move(participant->second);
+            participants.erase(participant);
+            release(std::move(removed));
+            RTC_LOG(LS_INFO) << "Participant " << ssrc << " left the local SFU";
+            return true;
+        });
+    }
+
+    void LocalSfu::release(std::unique_ptr<Participant> participant) const {
+        if (!participant) {
+            return;
+        }
+        participant->srtpTransport->SetDtlsTransports(nullptr, nullptr);
+        participant->srtpTransport = nullptr;
+        participant->dtlsTransport = nullptr;
+        participant->transportChannel = nullptr;
+        participant->portAllocator = nullptr;
+    }
+
+    void LocalSfu::forwardRtp(const uint32_t ssrc, const webrtc::CopyOnWriteBuffer& packet) const {
+        for (const auto& [other, participant] : participants) {
+            if (other == ssrc || !participant->srtpTransport->IsSrtpActive()) {
+                continue;
+            }
+            // Protecting writes in place, the copy keeps the source intact for the next participant
+            auto copy = packet;
+            participant->srtpTransport->SendRtpPacket(&copy, webrtc::AsyncSocketPacketOptions(), webrtc::PF_SRTP_BYPASS);
+        }
+    }
+
+    void LocalSfu::forwardRtcp(const uint32_t ssrc, const webrtc::CopyOnWriteBuffer& packet) const {
+        for (const auto& [other, participant] : participants) {
+            if (other == ssrc || !participant->srtpTransport->IsSrtpActive()) {
+                continue;
+            }
+            auto copy = packet;
+            participant->srtpTransport->SendRtcpPacket(&copy, webrtc::AsyncSocketPacketOptions(), webrtc::PF_SRTP_BYPASS);
+        }
+    }
+} // wrtc
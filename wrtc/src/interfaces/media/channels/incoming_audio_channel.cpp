@@ -11,7 +11,6 @@ namespace wrtc {
     IncomingAudioChannel::IncomingAudioChannel(
         webrtc::Call* call,
         ChannelManager *channelManager,
-        webrtc::RtpTransport* rtpTransport,
         const MediaContent& mediaContent,
         webrtc::Thread *workerThread,
         webrtc::Thread* networkThread,
@@ -25,17 +24,6 @@ namespace wrtc {
         audioOptions.audio_jitter_buffer_fast_accelerate = true;
         audioOptions.audio_jitter_buffer_min_delay_ms = 50;
 
-        channel = channelManager->CreateVoiceChannel(
-            call,
-            webrtc::MediaConfig(),
-            streamId,
-            false,
-            NativeNetworkInterface::getDefaultCryptoOptions(),
-            audioOptions
-        );
-        networkThread->BlockingCall([&] {
-           channel->SetRtpTransport(rtpTransport);
-        });
         std::vector<webrtc::Codec> codecs;
         for (const auto &[id, name, clockrate, channels, feedbackTypes, parameters] : mediaContent.payloadTypes) {
             webrtc::Codec codec = webrtc::CreateAudioCodec(static_cast<int>(id), name, static_cast<int>(clockrate), channels);
@@ -73,13 +61,18 @@ namespace wrtc {
         incomingDescription->AddStream(streamParams);
 
         workerThread->BlockingCall([&] {
+            channel = channelManager->CreateVoiceChannel(
+                call,
+                webrtc::MediaConfig(),
+                streamId,
+                false,
+                NativeNetworkInterface::getDefaultCryptoOptions(),
+                audioOptions
+            );
             channel->SetPayloadTypeDemuxingEnabled(true);
             std::string errorDesc;
             channel->SetLocalContent(outgoingDescription.get(), webrtc::SdpType::kOffer, errorDesc);
             channel->SetRemoteContent(incomingDescription.get(), webrtc::SdpType::kAnswer, errorDesc);
-        });
-        channel->Enable(true);
-        workerThread->BlockingCall([&] {
             auto rawSink = std::make_unique<RawAudioSink>();
             rawSink->setRemoteAudioSink(_ssrc, [remoteAudioSink](std::unique_ptr<AudioFrame> frame) {
                 if (const auto remoteAudio = remoteAudioSink.lock()) {
@@ -88,18 +81,41 @@ namespace wrtc {
             });
             channel->receive_channel()->SetRawAudioSink(_ssrc, std::move(rawSink));
         });
+        channel->Enable(true);
     }
 
     IncomingAudioChannel::~IncomingAudioChannel() {
         channel->Enable(false);
-        networkThread->BlockingCall([&] {
-           channel->SetRtpTransport(nullptr);
-        });
+        if (attached) {
+            networkThread->BlockingCall([&] {
+                detachTransport();
+            });
+        }
         workerThread->BlockingCall([&] {
             channel = nullptr;
         });
     }
 
+    void IncomingAudioChannel::attachTransport(webrtc::RtpTransport* rtpTransport) {
+        if (attached) {
+            return;
+        }
+        channel->SetRtpTransport(rtpTransport);
+        attached = true;
+    }
+
+    void IncomingAudioChannel::detachTransport() {
+        if (!attached) {
+            return;
+        }
+        channel->SetRtpTransport(nullptr);
+        attached = false;
+    }
+
+    void IncomingAudioChannel::setEnabled(const bool enable) const {
+        channel->Enable(enable);
+    }
+
     void IncomingAudioChannel::updateActivity() {
         activityTimestamp = webrtc::TimeMillis();
     }
@@ -111,4 +127,8 @@ namespace wrtc {
     uint32_t IncomingAudioChannel::ssrc() const {
         return _ssrc;
     }
+
+    bool IncomingAudioChannel::getStats(webrtc::VoiceMediaReceiveInfo* info) const {
+        return channel && channel->receive_channel()->GetStats(info, false);
+    }
 } // wrtc
\ No newline at end of file
@@ -11,7 +11,6 @@ namespace wrtc {
     IncomingVideoChannel::IncomingVideoChannel(
         webrtc::Call* call,
         ChannelManager* channelManager,
-        webrtc::RtpTransport* rtpTransport,
         std::vector<SsrcGroup> ssrcGroups,
         webrtc::UniqueRandomIdGenerator *randomIdGenerator,
         const std::vector<webrtc::Codec>& codecs,
@@ -24,20 +23,6 @@ namespace wrtc {
         const auto streamId = "video" + std::to_string(mid);
         videoBitrateAllocatorFactory = webrtc::CreateBuiltinVideoBitrateAllocatorFactory();
 
-        channel = channelManager->CreateVideoChannel(
-            call,
-            webrtc::MediaConfig(),
-            streamId,
-            false,
-            NativeNetworkInterface::getDefaultCryptoOptions(),
-            webrtc::VideoOptions(),
-            videoBitrateAllocatorFactory.get()
-        );
-
-        networkThread->BlockingCall([&] {
-            channel->SetRtpTransport(rtpTransport);
-        });
-
         auto outgoingVideoDescription = std::make_unique<webrtc::VideoContentDescription>();
         outgoingVideoDescription->AddRtpHeaderExtension(webrtc::RtpExtension(webrtc::RtpExtension::kAbsSendTimeUri, 2));
         outgoingVideoDescription->AddRtpHeaderExtension(webrtc::RtpExtension(webrtc::RtpExtension::kTransportSequenceNumberUri, 3));
@@ -88,6 +73,15 @@ namespace wrtc {
         incomingVideoDescription->AddStream(videoRecvStreamParams);
 
         workerThread->BlockingCall([&] {
+            channel = channelManager->CreateVideoChannel(
+                call,
+                webrtc::MediaConfig(),
+                streamId,
+                false,
+                NativeNetworkInterface::getDefaultCryptoOptions(),
+                webrtc::VideoOptions(),
+                videoBitrateAllocatorFactory.get()
+            );
             channel->SetPayloadTypeDemuxingEnabled(false);
             std::string errorDesc;
             channel->SetLocalContent(outgoingVideoDescription.get(), webrtc::SdpType::kOffer, errorDesc);
@@ -106,16 +100,42 @@ namespace wrtc {
 
     IncomingVideoChannel::~IncomingVideoChannel() {
         channel->Enable(false);
-        networkThread->BlockingCall([&] {
-           channel->SetRtpTransport(nullptr);
-        });
+        if (attached) {
+            networkThread->BlockingCall([&] {
+                detachTransport();
+            });
+        }
         workerThread->BlockingCall([&] {
             channel = nullptr;
         });
         sink = nullptr;
     }
 
+    void IncomingVideoChannel::attachTransport(webrtc::RtpTransport* rtpTransport) {
+        if (attached) {
+            return;
+        }
+        channel->SetRtpTransport(rtpTransport);
+        attached = true;
+    }
+
+    void IncomingVideoChannel::detachTransport() {
+        if (!attached) {
+            return;
+        }
+        channel->SetRtpTransport(nullptr);
+        attached = false;
+    }
+
+    void IncomingVideoChannel::setEnabled(const bool enable) const {
+        channel->Enable(enable);
+    }
+
     uint32_t IncomingVideoChannel::ssrc() const {
         return _ssrc;
     }
+
+    bool IncomingVideoChannel::getStats(webrtc::VideoMediaReceiveInfo* info) const {
+        return channel && channel->receive_channel()->GetStats(info);
+    }
 } // wrtc
\ No newline at end of file
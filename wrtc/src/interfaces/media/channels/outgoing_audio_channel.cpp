@@ -10,7 +10,6 @@ namespace wrtc {
     OutgoingAudioChannel::OutgoingAudioChannel(
         webrtc::Call *call,
         ChannelManager *channelManager,
-        webrtc::RtpTransport* rtpTransport,
         const MediaContent& mediaContent,
         webrtc::Thread *workerThread,
         webrtc::Thread* networkThread,
@@ -30,9 +29,6 @@ namespace wrtc {
             NativeNetworkInterface::getDefaultCryptoOptions(),
             audioOptions
         );
-        networkThread->BlockingCall([&] {
-            channel->SetRtpTransport(rtpTransport);
-        });
         std::vector<webrtc::Codec> codecs;
         for (const auto &[id, name, clockrate, channels, feedbackTypes, parameters] : mediaContent.payloadTypes) {
             if (name == "opus") {
@@ -93,16 +89,38 @@ namespace wrtc {
 
     OutgoingAudioChannel::~OutgoingAudioChannel() {
         channel->Enable(false);
-        networkThread->BlockingCall([&] {
-            channel->SetRtpTransport(nullptr);
-        });
+        if (attached) {
+            networkThread->BlockingCall([&] {
+                detachTransport();
+            });
+        }
         workerThread->BlockingCall([&] {
             channel = nullptr;
         });
         sink = nullptr;
     }
 
+    void OutgoingAudioChannel::attachTransport(webrtc::RtpTransport* rtpTransport) {
+        if (attached) {
+            return;
+        }
+        channel->SetRtpTransport(rtpTransport);
+        attached = true;
+    }
+
+    void OutgoingAudioChannel::detachTransport() {
+        if (!attached) {
+            return;
+        }
+        channel->SetRtpTransport(nullptr);
+        attached = false;
+    }
+
     uint32_t OutgoingAudioChannel::ssrc() const {
         return _ssrc;
     }
+
+    bool OutgoingAudioChannel::getStats(webrtc::VoiceMediaSendInfo* info) const {
+        return channel && channel->send_channel()->GetStats(info);
+    }
 } // wrtc
\ No newline at end of file
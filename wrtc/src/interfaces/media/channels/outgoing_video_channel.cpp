@@ -11,7 +11,6 @@ namespace wrtc {
     OutgoingVideoChannel::OutgoingVideoChannel(
         webrtc::Call *call,
         ChannelManager *channelManager,
-        webrtc::RtpTransport *rtpTransport,
         const MediaContent &mediaContent,
         webrtc::Thread *workerThread,
         webrtc::Thread *networkThread,
@@ -29,9 +28,6 @@ namespace wrtc {
             videoOptions,
             bitrateAllocatorFactory.get()
         );
-        networkThread->BlockingCall([&] {
-            channel->SetRtpTransport(rtpTransport);
-        });
         std::vector<webrtc::Codec> unsortedCodecs;
         for (const auto &[id, name, clockrate, channels, feedbackTypes, parameters] : mediaContent.payloadTypes) {
             webrtc::Codec codec = webrtc::CreateVideoCodec(static_cast<int>(id), name);
@@ -108,9 +104,11 @@ namespace wrtc {
 
     OutgoingVideoChannel::~OutgoingVideoChannel() {
         channel->Enable(false);
-        networkThread->BlockingCall([&] {
-            channel->SetRtpTransport(nullptr);
-        });
+        if (attached) {
+            networkThread->BlockingCall([&] {
+                detachTransport();
+            });
+        }
         workerThread->BlockingCall([&] {
             channel = nullptr;
             bitrateAllocatorFactory = nullptr;
@@ -125,7 +123,27 @@ namespace wrtc {
         });
     }
 
+    void OutgoingVideoChannel::attachTransport(webrtc::RtpTransport* rtpTransport) {
+        if (attached) {
+            return;
+        }
+        channel->SetRtpTransport(rtpTransport);
+        attached = true;
+    }
+
+    void OutgoingVideoChannel::detachTransport() {
+        if (!attached) {
+            return;
+        }
+        channel->SetRtpTransport(nullptr);
+        attached = false;
+    }
+
     uint32_t OutgoingVideoChannel::ssrc() const {
         return _ssrc;
     }
+
+    bool OutgoingVideoChannel::getStats(webrtc::VideoMediaSendInfo* info) const {
+        return channel && channel->send_channel()->GetStats(info);
+    }
 } // wrtc
\ No newline at end of file
@@ -0,0 +1,146 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <algorithm>
+#include <rtc_base/logging.h>
+#include <wrtc/utils/sync_helper.hpp>
+#include <wrtc/interfaces/media/playout_mixer.hpp>
+
+namespace wrtc {
+    static constexpr auto kFrameTime = std::chrono::milliseconds(10);
+    static constexpr int kMaxSampleRate = 48000;
+
+    PlayoutMixer::~PlayoutMixer() {
+        std::lock_guard lock(mutex);
+        for (const auto& shard : shards) {
+            stopShard(shard.get());
+        }
+        shards.clear();
+    }
+
+    bool PlayoutMixer::AddSource(Source* audioSource) {
+        std::lock_guard lock(mutex);
+        if (shards.empty()) {
+            inlineSources.push_back(audioSource);
+            return true;
+        }
+        const auto shard = std::ranges::min_element(shards, {}, [](const std::unique_ptr<Shard>& s) {
+            return s->sources.size();
+        })->get();
+        std::lock_guard shardLock(shard->mutex);
+        shard->sources.push_back(audioSource);
+        return true;
+    }
+
+    void PlayoutMixer::RemoveSource(Source* audioSource) {
+        std::lock_guard lock(mutex);
+        std::erase(inlineSources, audioSource);
+        for (const auto& shard : shards) {
+            // Taking the shard lock waits for an in-flight pull, the source is never touched after this returns
+            std::lock_guard shardLock(shard->mutex);
+            std::erase(shard->sources, audioSource);
+        }
+    }
+
+    void PlayoutMixer::Mix(const size_t numberOfChannels, webrtc::AudioFrame* audioFrameForMixing) {
+        {
+            std::lock_guard lock(mutex);
+            if (!inlineSources.empty()) {
+                const auto start = std::chrono::steady_clock::now();
+                pull(inlineSources, &inlineFrame);
+                if (std::chrono::steady_clock::now() - start > kFrameTime) {
+                    ++totalLateTicks;
+                }
+            }
+        }
+        // Incoming audio is consumed through the raw sinks, the ADM only needs a valid silent frame
+        audioFrameForMixing->UpdateFrame(
+            0,
+            nullptr,
+            kMaxSampleRate / 100,
+            kMaxSampleRate,
+            webrtc::AudioFrame::kNormalSpeech,
+            webrtc::AudioFrame::kVadUnknown,
+            numberOfChannels
+        );
+    }
+
+    void PlayoutMixer::pull(std::vector<Source*>& sources, webrtc::AudioFrame* frame) {
+        for (const auto source : sources) {
+            source->GetAudioFrameWithInfo(std::min(source->PreferredSampleRate(), kMaxSampleRate), frame);
+        }
+        ++totalTicks;
+    }
+
+    void PlayoutMixer::startShard(Shard* shard) {
+        shard->running = true;
+        shard->thread = webrtc::PlatformThread::SpawnJoinable(
+            [this, shard] {
+                SyncHelper clock(kFrameTime);
+                clock.synchronizeTime();
+                while (shard->running) {
+                    clock.waitNextFrame();
+                    const auto start = std::chrono::steady_clock::now();
+                    {
+                        std::lock_guard lock(shard->mutex);
+                        pull(shard->sources, &shard->frame);
+                    }
+                    if (std::chrono::steady_clock::now() - start > kFrameTime) {
+                        // Overrun: skip the missed ticks instead of bursting to catch up
+                        ++totalLateTicks;
+                        clock.synchronizeTime();
+                    }
+                }
+            },
+            "ntg-playout",
+            webrtc::ThreadAttributes().SetPriority(webrtc::ThreadPriority::kRealtime)
+        );
+    }
+
+    void PlayoutMixer::stopShard(Shard* shard) {
+        shard->running = false;
+        shard->thread.Finalize();
+    }
+
+    void PlayoutMixer::setThreads(const size_t count) {
+        std::lock_guard lock(mutex);
+        if (count == shards.size()) {
+            return;
+        }
+        std::vector<Source*> sources = std::move(inlineSources);
+        inlineSources.clear();
+        for (const auto& shard : shards) {
+            stopShard(shard.get());
+            sources.insert(sources.end(), shard->sources.begin(), shard->sources.end());
+        }
+        shards.clear();
+        RTC_LOG(LS_INFO) << "Playout pulling on " << count << " threads for " << sources.size() << " sources";
+        if (count == 0) {
+            inlineSources = std::move(sources);
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                shards.push_back(std::make_unique<Shard>());
+            }
+            for (size_t i = 0; i < sources.size(); i++) {
+                shards[i % count]->sources.push_back(sources[i]);
+            }
+            for (const auto& shard : shards) {
+                startShard(shard.get());
+            }
+        }
+    }
+
+    size_t PlayoutMixer::threads() {
+        std::lock_guard lock(mutex);
+        return shards.size();
+    }
+
+    uint64_t PlayoutMixer::ticks() const {
+        return totalTicks;
+    }
+
+    uint64_t PlayoutMixer::lateTicks() const {
+        return totalLateTicks;
+    }
+} // wrtc
@@ -3,16 +3,20 @@
 //
 
 #include <utility>
+#include <rtc_base/time_utils.h>
 #include <wrtc/interfaces/media/raw_audio_sink.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace wrtc {
     void RawAudioSink::OnData(const Data& audio) {
         if (callbackData) {
+            WRTC_TRACE_SCOPE("raw_audio_sink", ssrc);
             auto frame = std::make_unique<AudioFrame>(ssrc);
             frame->size = audio.samples_per_channel * audio.channels * sizeof(int16_t);
             frame->data = audio.data;
             frame->sampleRate = audio.sample_rate;
             frame->channels = audio.channels;
+            frame->decodedAtUs = webrtc::TimeMicros();
             callbackData(std::move(frame));
         }
     }
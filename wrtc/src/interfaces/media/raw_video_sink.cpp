@@ -3,10 +3,12 @@
 //
 
 #include <wrtc/interfaces/media/raw_video_sink.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace wrtc {
     void RawVideoSink::OnFrame(const webrtc::VideoFrame& frame) {
         if (callbackData) {
+            WRTC_TRACE_SCOPE("raw_video_sink", ssrc);
             callbackData(ssrc, std::make_unique<webrtc::VideoFrame>(frame));
         }
     }
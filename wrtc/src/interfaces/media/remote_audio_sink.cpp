@@ -2,34 +2,177 @@
 // Created by Laky64 on 07/10/24.
 //
 
+#include <algorithm>
+#include <rtc_base/logging.h>
+#include <wrtc/utils/sync_helper.hpp>
 #include <wrtc/interfaces/media/remote_audio_sink.hpp>
+#include <wrtc/utils/metrics.hpp>
 
 namespace wrtc {
-    RemoteAudioSink::RemoteAudioSink(const std::function<void(const std::vector<std::unique_ptr<AudioFrame>>&)>& callback): numSources(0) {
+    RemoteAudioSink::RemoteAudioSink(const std::function<void(const std::vector<AudioFrame>&)>& callback): slots(kInitialSources), output(kInitialSources) {
         framesCallback = callback;
+        audioFrames.reserve(kInitialSources);
     }
 
     RemoteAudioSink::~RemoteAudioSink() {
+        if (running) {
+            {
+                std::lock_guard lock(mutex);
+                running = false;
+            }
+            wake.notify_one();
+            thread.Finalize();
+        }
         audioFrames.clear();
     }
 
-    void RemoteAudioSink::sendData(std::unique_ptr<AudioFrame> frame) {
-        audioFrames.push_back(std::move(frame));
-        if (audioFrames.size() >= numSources) {
+    RemoteAudioSink::Slot* RemoteAudioSink::findSlot(const uint32_t ssrc) {
+        Slot* freeSlot = nullptr;
+        for (auto& slot : slots) {
+            if (slot.active && slot.ssrc == ssrc) {
+                return &slot;
+            }
+            if (!slot.active && !freeSlot) {
+                freeSlot = &slot;
+            }
+        }
+        if (!freeSlot) {
+            RTC_LOG(LS_INFO) << "Remote audio sources exceed " << slots.size() << " slots, growing the table";
+            freeSlot = &slots.emplace_back();
+            output.emplace_back();
+        }
+        freeSlot->ssrc = ssrc;
+        freeSlot->active = true;
+        freeSlot->buffering = true;
+        freeSlot->idleTicks = 0;
+        freeSlot->head = 0;
+        freeSlot->count = 0;
+        return freeSlot;
+    }
+
+    void RemoteAudioSink::sendData(const std::unique_ptr<AudioFrame> frame) {
+        const auto samples = frame->size / sizeof(int16_t);
+        std::lock_guard lock(mutex);
+        if (samples > kMaxSamples) {
+            ++droppedFrames;
+            metrics::droppedAudioFrames.add();
+            return;
+        }
+        Slot* slot = findSlot(frame->ssrc);
+        if (slot->count == kJitterDepth) {
+            // Late frame policy: the buffer is full, so the oldest frame is discarded to bound latency
+            slot->head = (slot->head + 1) % kJitterDepth;
+            slot->count--;
+            ++droppedFrames;
+            metrics::droppedAudioFrames.add();
+        }
+        auto& packet = slot->packets[(slot->head + slot->count) % kJitterDepth];
+        std::copy_n(frame->data, samples, packet.samples.data());
+        packet.size = frame->size;
+        packet.sampleRate = frame->sampleRate;
+        packet.channels = frame->channels;
+        packet.decodedAtUs = frame->decodedAtUs;
+        slot->count++;
+        slot->idleTicks = 0;
+        if (!running) {
+            startClock();
+        } else if (parked) {
+            parked = false;
+            wake.notify_one();
+        }
+    }
+
+    void RemoteAudioSink::startClock() {
+        running = true;
+        thread = webrtc::PlatformThread::SpawnJoinable(
+            [this] {
+                SyncHelper clock(std::chrono::milliseconds(10));
+                clock.synchronizeTime();
+                while (running) {
+                    clock.waitNextFrame();
+                    if (!running) {
+                        break;
+                    }
+                    if (!tick()) {
+                        park();
+                        clock.synchronizeTime();
+                    }
+                }
+            },
+            "RemoteAudioSink",
+            webrtc::ThreadAttributes().SetPriority(webrtc::ThreadPriority::kRealtime)
+        );
+    }
+
+    void RemoteAudioSink::park() {
+        std::unique_lock lock(mutex);
+        // A frame may have arrived since the tick released the lock
+        parked = std::ranges::none_of(slots, [](const Slot& slot) {
+            return slot.active;
+        });
+        wake.wait(lock, [this] {
+            return !parked || !running;
+        });
+        parked = false;
+    }
+
+    bool RemoteAudioSink::tick() {
+        std::unique_lock lock(mutex);
+        audioFrames.clear();
+        bool hasSources = false;
+        size_t outputIndex = 0;
+        for (auto& slot : slots) {
+            if (!slot.active) {
+                continue;
+            }
+            hasSources = true;
+            if (slot.buffering && slot.count >= kPrefillFrames) {
+                slot.buffering = false;
+            }
+            if (slot.buffering) {
+                if (++slot.idleTicks > kIdleTicks) {
+                    slot.active = false;
+                }
+                continue;
+            }
+            if (slot.count == 0) {
+                ++lateTicks;
+                metrics::audioUnderruns.add();
+                slot.buffering = true;
+                continue;
+            }
+            // Frames are swapped into preallocated output packets, the slot keeps receiving while callbacks run
+            std::swap(output[outputIndex], slot.packets[slot.head]);
+            slot.head = (slot.head + 1) % kJitterDepth;
+            slot.count--;
+
+            const auto& packet = output[outputIndex++];
+            auto& frame = audioFrames.emplace_back(slot.ssrc);
+            frame.data = packet.samples.data();
+            frame.size = packet.size;
+            frame.sampleRate = packet.sampleRate;
+            frame.channels = packet.channels;
+            frame.decodedAtUs = packet.decodedAtUs;
+        }
+        lock.unlock();
+        if (hasSources && framesCallback) {
             framesCallback(audioFrames);
-            audioFrames.clear();
         }
+        return hasSources;
     }
 
-    void RemoteAudioSink::addSource() {
-        ++numSources;
+    void RemoteAudioSink::clear() {
+        std::lock_guard lock(mutex);
+        for (auto& slot : slots) {
+            slot.active = false;
+        }
     }
 
-    void RemoteAudioSink::removeSource() {
-        --numSources;
+    uint64_t RemoteAudioSink::dropped() const {
+        return droppedFrames;
     }
 
-    void RemoteAudioSink::updateAudioSourceCount(const int count) {
-        numSources = count;
+    uint64_t RemoteAudioSink::underruns() const {
+        return lateTicks;
     }
-} // wrtc
\ No newline at end of file
+} // wrtc
@@ -4,6 +4,7 @@
 
 #include <wrtc/interfaces/media/rtc_audio_source.hpp>
 #include <rtc_base/crypto_random.h>
+#include <wrtc/utils/tracer.hpp>
 
 namespace wrtc {
     RTCAudioSource::RTCAudioSource() {
@@ -21,6 +22,7 @@ namespace wrtc {
     }
 
     void RTCAudioSource::OnData(const RTCOnDataEvent &data, const FrameData additionalData) const {
+        WRTC_TRACE_SCOPE("audio_source.push");
         source->PushData(data, additionalData.absoluteCaptureTimestampMs);
     }
 } // wrtc
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <wrtc/interfaces/media/rtc_video_source.hpp>
 #include <rtc_base/crypto_random.h>
+#include <wrtc/utils/tracer.hpp>
 
 namespace wrtc {
     RTCVideoSource::RTCVideoSource() {
@@ -21,8 +22,13 @@ namespace wrtc {
     }
 
     void RTCVideoSource::OnFrame(const i420ImageData& data, const FrameData additionalData) const {
+        OnFrame(data.buffer(), additionalData);
+    }
+
+    void RTCVideoSource::OnFrame(const webrtc::scoped_refptr<webrtc::VideoFrameBuffer>& buffer, const FrameData additionalData) const {
+        WRTC_TRACE_SCOPE("video_source.push");
         const auto frame = webrtc::VideoFrame::Builder()
-            .set_video_frame_buffer(data.buffer())
+            .set_video_frame_buffer(buffer)
             .set_timestamp_rtp(0)
             .set_timestamp_ms(additionalData.absoluteCaptureTimestampMs)
             .set_rotation(additionalData.rotation)
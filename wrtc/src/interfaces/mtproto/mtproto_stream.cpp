@@ -28,7 +28,6 @@ namespace wrtc {
         videoFrameCallback = nullptr;
         requestCurrentTimeCallback = nullptr;
         requestBroadcastPartCallback = nullptr;
-        updateAudioSourceCountCallback = nullptr;
         running = false;
     }
 
@@ -197,10 +196,6 @@ namespace wrtc {
         videoFrameCallback = callback;
     }
 
-    void MTProtoStream::onUpdateAudioSourceCount(const std::function<void(int count)>& callback) {
-        updateAudioSourceCountCallback = callback;
-    }
-
     std::map<int64_t, MediaSegment*> MTProtoStream::filterSegments(const MediaSegment::Status status) const {
         std::map<int64_t, MediaSegment*> availableSegments;
         for (const auto& [fst, snd] : segments) {
@@ -263,6 +258,7 @@ namespace wrtc {
                         frame->sampleRate = static_cast<int>(buffer->sampleRate);
                         frame->data = buffer->data.data();
                         frame->size = buffer->data.size() * sizeof(int16_t);
+                        frame->decodedAtUs = webrtc::TimeMicros();
                         strong->audioFrameCallback(std::move(frame));
                     }
                 }
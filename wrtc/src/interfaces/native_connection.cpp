@@ -198,31 +198,18 @@ namespace wrtc {
         if (!coordinatedState) {
             return;
         }
+        std::optional<MediaContent> audioContent, videoContent;
         if (audioChannelId) {
             if (const auto audioSsrc = contentNegotiationContext->outgoingChannelSsrc(*audioChannelId)) {
                 if (audioChannel && audioChannel->ssrc() != audioSsrc.value()) {
                     audioChannel = nullptr;
                 }
-                std::optional<MediaContent> audioContent;
                 for (const auto &content : coordinatedState->outgoingContents) {
                     if (content.type == MediaContent::Type::Audio && content.ssrc == audioSsrc.value()) {
                         audioContent = content;
                         break;
                     }
                 }
-                if (audioContent) {
-                    if (!audioChannel) {
-                        audioChannel = std::make_unique<OutgoingAudioChannel>(
-                            call.get(),
-                            channelManager.get(),
-                            dtlsSrtpTransport.get(),
-                            *audioContent,
-                            workerThread(),
-                            networkThread(),
-                            &audioSink
-                        );
-                    }
-                }
             }
         }
         if (videoChannelId) {
@@ -230,47 +217,22 @@ namespace wrtc {
                 if (videoChannel && videoChannel->ssrc() != videoSsrc.value()) {
                     videoChannel = nullptr;
                 }
-                std::optional<MediaContent> videoContent;
                 for (const auto &content : coordinatedState->outgoingContents) {
                     if (content.type == MediaContent::Type::Video && content.ssrc == videoSsrc.value()) {
                         videoContent = content;
                         break;
                     }
                 }
-                if (videoContent) {
-                    if (!videoChannel) {
-                        videoChannel = std::make_unique<OutgoingVideoChannel>(
-                            call.get(),
-                            channelManager.get(),
-                            dtlsSrtpTransport.get(),
-                            *videoContent,
-                            workerThread(),
-                            networkThread(),
-                            &videoSink
-                        );
-                    }
-                }
             }
         }
+        createOutgoingChannels(audioContent, videoContent);
 
-        std::unordered_set<uint32_t> remoteChannels;
-        for (const auto &content : coordinatedState->incomingContents) {
-            remoteChannels.insert(content.ssrc);
-        }
-        auto removeChannel = [&](auto &channels) {
-            std::erase_if(channels, [&](const auto &entry) {
-                if (const uint32_t ssrc = entry.second->ssrc(); !remoteChannels.contains(ssrc)) {
-                    pendingContent.erase(entry.first);
-                    return true;
-                }
-                return false;
-            });
-        };
-        removeChannel(incomingAudioChannels);
-        removeChannel(incomingVideoChannels);
+        std::vector<std::pair<std::string, MediaContent>> contents;
         for (const auto &content : coordinatedState->incomingContents) {
-            addIncomingSmartSource(std::to_string(content.ssrc), content);
+            contents.emplace_back(std::to_string(content.ssrc), content);
         }
+        // The channel maps are only touched on the worker thread, under the mutex
+        syncIncomingSources(std::move(contents));
     }
 
     void NativeConnection::notifyStateUpdated() {
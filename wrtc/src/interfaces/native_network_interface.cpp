@@ -2,20 +2,95 @@
 // Created by Laky64 on 01/10/24.
 //
 
+#include <map>
 #include <ranges>
+#include <unordered_set>
 #include <p2p/base/basic_async_resolver_factory.h>
 #include <p2p/base/p2p_constants.h>
 #include <p2p/client/basic_port_allocator.h>
 #include <pc/media_factory.h>
 #include <rtc_base/crypto_random.h>
-#include <rtc_base/rtc_certificate_generator.h>
+#include <rtc_base/ssl_stream_adapter.h>
 #include <rtc_base/time_utils.h>
 #include <wrtc/exceptions.hpp>
 #include <wrtc/interfaces/native_network_interface.hpp>
 #include <wrtc/interfaces/wrapped_dtls_srtp_transport.hpp>
 #include <wrtc/models/outgoing_video_format.hpp>
+#include <wrtc/utils/certificate_pool.hpp>
 
 namespace wrtc {
+    namespace {
+        // Stats fields changed types across WebRTC releases, these accept both forms
+        template <typename T>
+        uint64_t counter(const T& value) {
+            if constexpr (requires { value.value_or(0); }) {
+                return static_cast<uint64_t>(value.value_or(0));
+            } else {
+                return static_cast<uint64_t>(value);
+            }
+        }
+
+        template <typename T>
+        double milliseconds(const T& value) {
+            if constexpr (requires { value.template ms<double>(); }) {
+                return value.template ms<double>();
+            } else {
+                return static_cast<double>(value);
+            }
+        }
+
+        template <typename Info>
+        RtpStreamStats senderStats(const Info& info, const bool video) {
+            RtpStreamStats stats;
+            stats.ssrc = info.ssrc();
+            stats.outgoing = true;
+            stats.video = video;
+            stats.bytes = counter(info.payload_bytes_sent) + counter(info.header_and_padding_bytes_sent);
+            stats.packets = counter(info.packets_sent);
+            stats.packetsLost = info.packets_lost;
+            stats.fractionLost = info.fraction_lost;
+            if constexpr (requires { info.nacks_received; }) {
+                stats.nacks = counter(info.nacks_received);
+            }
+            if constexpr (requires { info.plis_received; info.frames_encoded; info.total_encode_time_ms; }) {
+                stats.plis = counter(info.plis_received);
+                if (info.frames_encoded) {
+                    stats.frameTimeMs = milliseconds(info.total_encode_time_ms) / info.frames_encoded;
+                }
+            }
+            return stats;
+        }
+
+        template <typename Info>
+        RtpStreamStats receiverStats(const Info& info, const bool video) {
+            RtpStreamStats stats;
+            stats.ssrc = info.ssrc();
+            stats.video = video;
+            stats.bytes = counter(info.payload_bytes_received) + counter(info.header_and_padding_bytes_received);
+            stats.packets = counter(info.packets_received);
+            stats.packetsLost = info.packets_lost;
+            stats.fractionLost = info.fraction_lost;
+            if constexpr (requires { info.nacks_sent; }) {
+                stats.nacks = counter(info.nacks_sent);
+            }
+            if constexpr (requires { info.jitter_ms; }) {
+                stats.jitterMs = info.jitter_ms;
+            }
+            if constexpr (requires { info.jitter_buffer_delay_seconds; info.jitter_buffer_emitted_count; }) {
+                if (info.jitter_buffer_emitted_count) {
+                    stats.jitterBufferDelayMs = info.jitter_buffer_delay_seconds * 1000 / static_cast<double>(info.jitter_buffer_emitted_count);
+                }
+            }
+            if constexpr (requires { info.plis_sent; info.frames_decoded; info.total_decode_time; }) {
+                stats.plis = counter(info.plis_sent);
+                if (info.frames_decoded) {
+                    stats.frameTimeMs = milliseconds(info.total_decode_time) / info.frames_decoded;
+                }
+            }
+            return stats;
+        }
+    }
+
     void NativeNetworkInterface::initConnection(bool supportsPacketSending) {
         std::weak_ptr weak(shared_from_this());
         networkThread()->PostTask([weak, supportsPacketSending] {
@@ -28,10 +103,7 @@ namespace wrtc {
                 webrtc::CreateRandomString(webrtc::ICE_PWD_LENGTH),
                 true
             );
-            strong->localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(
-                webrtc::KeyParams(webrtc::KT_ECDSA),
-                std::nullopt
-            );
+            strong->localCertificate = CertificatePool::GetOrCreateDefault()->take();
             strong->asyncResolverFactory = std::make_unique<webrtc::BasicAsyncDnsResolverFactory>();
             strong->dtlsSrtpTransport = std::make_unique<WrappedDtlsSrtpTransport>(
                 true,
@@ -50,6 +122,10 @@ namespace wrtc {
                     });
                 }
             );
+            // The transport is owned by this interface, so the callback never outlives it
+            static_cast<WrappedDtlsSrtpTransport*>(strong->dtlsSrtpTransport.get())->onRtpSent([raw = strong.get()](const uint32_t ssrc, const uint32_t timestamp) {
+                raw->rtpSent(ssrc, timestamp);
+            });
             strong->dtlsSrtpTransport->SetDtlsTransports(nullptr, nullptr);
             strong->dtlsSrtpTransport->SubscribeReadyToSend(strong.get(), [weak](const bool readyToSend) {
                 const auto strongListener = weak.lock();
@@ -107,8 +183,111 @@ namespace wrtc {
         availableVideoFormats = filterSupportedVideoFormats(factory->getSupportedVideoFormats());
     }
 
+    void NativeNetworkInterface::createOutgoingChannels(const std::optional<MediaContent>& audioContent, const std::optional<MediaContent>& videoContent) {
+        std::vector<OutgoingAudioChannel*> createdAudio;
+        std::vector<OutgoingVideoChannel*> createdVideo;
+        // The channel constructors run their worker calls inline from here
+        workerThread()->BlockingCall([&] {
+            if (audioContent && !audioChannel) {
+                audioChannel = std::make_unique<OutgoingAudioChannel>(
+                    call.get(),
+                    channelManager.get(),
+                    *audioContent,
+                    workerThread(),
+                    networkThread(),
+                    &audioSink
+                );
+                sentAudio.ssrc = audioChannel->ssrc();
+                createdAudio.push_back(audioChannel.get());
+            }
+            if (videoContent && !videoChannel) {
+                videoChannel = std::make_unique<OutgoingVideoChannel>(
+                    call.get(),
+                    channelManager.get(),
+                    *videoContent,
+                    workerThread(),
+                    networkThread(),
+                    &videoSink
+                );
+                sentVideo.ssrc = videoChannel->ssrc();
+                createdVideo.push_back(videoChannel.get());
+            }
+        });
+        if (createdAudio.empty() && createdVideo.empty()) {
+            return;
+        }
+        networkThread()->BlockingCall([&] {
+            for (const auto channel : createdAudio) {
+                channel->attachTransport(dtlsSrtpTransport.get());
+            }
+            for (const auto channel : createdVideo) {
+                channel->attachTransport(dtlsSrtpTransport.get());
+            }
+        });
+    }
+
     void NativeNetworkInterface::addIncomingSmartSource(const std::string& endpoint, const MediaContent& mediaContent, const bool force) {
-        std::lock_guard lock(mutex);
+        addIncomingSmartSources({{endpoint, mediaContent}}, force);
+    }
+
+    void NativeNetworkInterface::addIncomingSmartSources(std::vector<std::pair<std::string, MediaContent>> contents, const bool force) {
+        if (contents.empty()) {
+            return;
+        }
+        std::weak_ptr weak(shared_from_this());
+        workerThread()->PostTask([weak, contents = std::move(contents), force] {
+            const auto strong = weak.lock();
+            if (!strong) {
+                return;
+            }
+            std::lock_guard lock(strong->mutex);
+            strong->createIncomingSources(contents, force);
+        });
+    }
+
+    void NativeNetworkInterface::syncIncomingSources(std::vector<std::pair<std::string, MediaContent>> contents) {
+        std::weak_ptr weak(shared_from_this());
+        workerThread()->PostTask([weak, contents = std::move(contents)] {
+            const auto strong = weak.lock();
+            if (!strong) {
+                return;
+            }
+            std::lock_guard lock(strong->mutex);
+            std::unordered_set<uint32_t> remoteChannels;
+            for (const auto& content : contents | std::views::values) {
+                remoteChannels.insert(content.ssrc);
+            }
+            auto removeChannels = [&](auto& channels) {
+                std::vector<typename std::decay_t<decltype(channels)>::mapped_type> removed;
+                for (auto it = channels.begin(); it != channels.end();) {
+                    if (!remoteChannels.contains(it->second->ssrc())) {
+                        strong->pendingContent.erase(it->first);
+                        removed.push_back(std::move(it->second));
+                        it = channels.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                return removed;
+            };
+            auto removedAudio = removeChannels(strong->incomingAudioChannels);
+            auto removedVideo = removeChannels(strong->incomingVideoChannels);
+            strong->releaseIncomingChannels(std::move(removedAudio), std::move(removedVideo));
+            strong->createIncomingSources(contents, false);
+        });
+    }
+
+    void NativeNetworkInterface::createIncomingSources(const std::vector<std::pair<std::string, MediaContent>>& contents, const bool force) {
+        if (channelsClosed) {
+            return;
+        }
+        for (const auto& [endpoint, mediaContent] : contents) {
+            createIncomingSource(endpoint, mediaContent, force);
+        }
+        attachIncomingChannels();
+    }
+
+    void NativeNetworkInterface::createIncomingSource(const std::string& endpoint, const MediaContent& mediaContent, const bool force) {
         if (pendingContent.contains(endpoint) && !force) {
             return;
         }
@@ -145,16 +324,15 @@ namespace wrtc {
                 }
             }
             RTC_LOG(LS_INFO) << "Adding incoming audio channel with ssrc " << mediaContent.mainSsrc();
-            if (const auto sink = remoteAudioSink.lock()) sink->addSource();
             incomingAudioChannels[endpoint] = std::make_unique<IncomingAudioChannel>(
                 call.get(),
                 channelManager.get(),
-                dtlsSrtpTransport.get(),
                 mediaContent,
                 workerThread(),
                 networkThread(),
                 remoteAudioSink
             );
+            pendingAttach.push_back(endpoint);
         } else if (isAddable && mediaContent.type == MediaContent::Type::Video) {
             auto videoCodecs = OutgoingVideoFormat::getVideoCodecs(
                 availableVideoFormats,
@@ -164,7 +342,6 @@ namespace wrtc {
             incomingVideoChannels[endpoint] = std::make_unique<IncomingVideoChannel>(
                 call.get(),
                 channelManager.get(),
-                dtlsSrtpTransport.get(),
                 mediaContent.ssrcGroups,
                 factory->ssrcGenerator(),
                 videoCodecs,
@@ -172,6 +349,7 @@ namespace wrtc {
                 networkThread(),
                 mediaContent.isScreenCast() ? remoteScreenCastSink : remoteVideoSink
             );
+            pendingAttach.push_back(endpoint);
         }
         if (pendingContent.contains(endpoint)) {
             return;
@@ -188,14 +366,79 @@ namespace wrtc {
         pendingContent[endpoint] = mediaContent;
     }
 
+    void NativeNetworkInterface::attachIncomingChannels() {
+        if (pendingAttach.empty()) {
+            return;
+        }
+        std::vector<IncomingAudioChannel*> audioChannels;
+        std::vector<IncomingVideoChannel*> videoChannels;
+        for (const auto& endpoint : pendingAttach) {
+            if (const auto it = incomingAudioChannels.find(endpoint); it != incomingAudioChannels.end()) {
+                audioChannels.push_back(it->second.get());
+            }
+            if (const auto it = incomingVideoChannels.find(endpoint); it != incomingVideoChannels.end()) {
+                videoChannels.push_back(it->second.get());
+            }
+        }
+        pendingAttach.clear();
+        networkThread()->PostTask([strong = shared_from_this(), audioChannels = std::move(audioChannels), videoChannels = std::move(videoChannels)] {
+            for (const auto channel : audioChannels) {
+                channel->attachTransport(strong->dtlsSrtpTransport.get());
+            }
+            for (const auto channel : videoChannels) {
+                channel->attachTransport(strong->dtlsSrtpTransport.get());
+            }
+        });
+    }
+
     void NativeNetworkInterface::removeIncomingAudio(const std::string& endpoint) {
-        if (!pendingContent.contains(endpoint)) {
+        removeIncomingAudio(std::vector{endpoint});
+    }
+
+    void NativeNetworkInterface::removeIncomingAudio(const std::vector<std::string>& endpoints) {
+        std::vector<std::unique_ptr<IncomingAudioChannel>> removed;
+        for (const auto& endpoint : endpoints) {
+            if (!pendingContent.contains(endpoint)) {
+                continue;
+            }
+            RTC_LOG(LS_INFO) << "Removing incoming audio channel with ssrc " << endpoint;
+            if (auto node = incomingAudioChannels.extract(endpoint)) {
+                removed.push_back(std::move(node.mapped()));
+            }
+            pendingContent.erase(endpoint);
+        }
+        releaseIncomingChannels(std::move(removed), {});
+    }
+
+    void NativeNetworkInterface::releaseIncomingChannels(
+        std::vector<std::unique_ptr<IncomingAudioChannel>> audioChannels,
+        std::vector<std::unique_ptr<IncomingVideoChannel>> videoChannels
+    ) {
+        if (audioChannels.empty() && videoChannels.empty()) {
             return;
         }
-        RTC_LOG(LS_INFO) << "Removing incoming audio channel with ssrc " << endpoint;
-        if (incomingAudioChannels.contains(endpoint)) incomingAudioChannels.erase(endpoint);
-        pendingContent.erase(endpoint);
-        if (const auto sink = remoteAudioSink.lock()) sink->removeSource();
+        // Holding this interface keeps webrtc::Call alive until the last channel is destroyed
+        workerThread()->PostTask([strong = shared_from_this(), audioChannels = std::move(audioChannels), videoChannels = std::move(videoChannels)]() mutable {
+            for (const auto& channel : audioChannels) {
+                channel->setEnabled(false);
+            }
+            for (const auto& channel : videoChannels) {
+                channel->setEnabled(false);
+            }
+            // Queued behind the attach of these channels, so it always finds them attached
+            strong->networkThread()->PostTask([strong, audioChannels = std::move(audioChannels), videoChannels = std::move(videoChannels)]() mutable {
+                for (const auto& channel : audioChannels) {
+                    channel->detachTransport();
+                }
+                for (const auto& channel : videoChannels) {
+                    channel->detachTransport();
+                }
+                strong->workerThread()->PostTask([strong, audioChannels = std::move(audioChannels), videoChannels = std::move(videoChannels)]() mutable {
+                    audioChannels.clear();
+                    videoChannels.clear();
+                });
+            });
+        });
     }
 
     void NativeNetworkInterface::DtlsReadyToSend(const bool isReadyToSend) {
@@ -214,7 +457,7 @@ namespace wrtc {
     }
 
     void NativeNetworkInterface::UpdateAggregateStates_n() {
-        const auto state = transportChannel->GetIceTransportState();
+        const auto state = transportChannel ? transportChannel->GetIceTransportState() : webrtc::IceTransportState::kConnected;
         bool isConnected = false;
         switch (state) {
         case webrtc::IceTransportState::kConnected:
@@ -237,6 +480,10 @@ namespace wrtc {
     }
 
     void NativeNetworkInterface::resetDtlsSrtpTransport() {
+        if (nullNetwork) {
+            resetNullTransport();
+            return;
+        }
         portAllocator = std::make_unique<webrtc::BasicPortAllocator>(
             environment(),
             factory->networkManager(),
@@ -304,6 +551,38 @@ namespace wrtc {
         dtlsSrtpTransport->SetDtlsTransports(dtlsTransport.get(), nullptr);
     }
 
+    void NativeNetworkInterface::resetNullTransport() {
+        dtlsTransport = std::make_unique<NullTransport>(*nullNetwork, networkThread());
+        dtlsSrtpTransport->SetDtlsTransports(dtlsTransport.get(), nullptr);
+        // Both directions share a key, so looped back packets decrypt as if a peer sent them
+        int keyLength = 0, saltLength = 0;
+        webrtc::GetSrtpKeyAndSaltLengths(webrtc::kSrtpAes128CmSha1_80, &keyLength, &saltLength);
+        std::string material;
+        webrtc::CreateRandomData(keyLength + saltLength, &material);
+        const webrtc::ZeroOnFreeBuffer<uint8_t> key(reinterpret_cast<const uint8_t*>(material.data()), material.size());
+        if (!dtlsSrtpTransport->SetRtpParams(webrtc::kSrtpAes128CmSha1_80, key, {}, webrtc::kSrtpAes128CmSha1_80, key, {})) {
+            RTC_LOG(LS_ERROR) << "Failed to set SRTP parameters on the null transport";
+        }
+        UpdateAggregateStates_n();
+    }
+
+    void NativeNetworkInterface::setNullNetwork(const NullTransport::Mode mode) {
+        nullNetwork = mode;
+    }
+
+    void NativeNetworkInterface::enableLoopbackNetworks() {
+        std::weak_ptr weak(shared_from_this());
+        networkThread()->PostTask([weak] {
+            const auto strong = weak.lock();
+            if (!strong || !strong->portAllocator) {
+                return;
+            }
+            // Pooled sessions already gathered without loopback
+            strong->portAllocator->SetNetworkIgnoreMask(0);
+            strong->portAllocator->DiscardCandidatePool();
+        });
+    }
+
     webrtc::CryptoOptions NativeNetworkInterface::getDefaultCryptoOptions() {
         auto options = webrtc::CryptoOptions();
         options.srtp.enable_aes128_sha1_80_crypto_cipher = true;
@@ -312,6 +591,7 @@ namespace wrtc {
     }
 
     std::vector<std::string> NativeNetworkInterface::getEndpoints() const {
+        std::lock_guard lock(mutex);
         std::vector<std::string> endpoints;
         for (const auto &[endpoint, media] : pendingContent) {
             if (media.type == MediaContent::Type::Video) {
@@ -332,20 +612,22 @@ namespace wrtc {
         NetworkInterface::enableAudioIncoming(enable);
 
         std::weak_ptr weak(shared_from_this());
-        workerThread()->BlockingCall([weak, enable] {
+        workerThread()->PostTask([weak, enable] {
             const auto strong = weak.lock();
             if (!strong) {
                 return;
             }
+            std::lock_guard lock(strong->mutex);
             if (enable) {
+                std::vector<std::pair<std::string, MediaContent>> contents;
                 for (const auto& [endpoint, mediaContent] : strong->pendingContent) {
                     if (mediaContent.type == MediaContent::Type::Audio) {
-                        strong->addIncomingSmartSource(endpoint, mediaContent, true);
+                        contents.emplace_back(endpoint, mediaContent);
                     }
                 }
+                strong->createIncomingSources(contents, true);
             } else {
-                std::lock_guard lock(strong->mutex);
-                strong->incomingAudioChannels.clear();
+                strong->releaseIncomingChannels(drainChannels(strong->incomingAudioChannels), {});
             }
         });
     }
@@ -362,23 +644,30 @@ namespace wrtc {
         }
         NetworkInterface::enableVideoIncoming(enable, isScreenCast);
         std::weak_ptr weak(shared_from_this());
-        workerThread()->BlockingCall([weak, enable, isScreenCast] {
+        workerThread()->PostTask([weak, enable, isScreenCast] {
             const auto strong = weak.lock();
             if (!strong) {
                 return;
             }
+            std::lock_guard lock(strong->mutex);
             if (enable) {
+                std::vector<std::pair<std::string, MediaContent>> contents;
                 for (const auto& [endpoint, mediaContent] : strong->pendingContent) {
                     if (mediaContent.type == MediaContent::Type::Video && mediaContent.isScreenCast() == isScreenCast) {
-                        strong->addIncomingSmartSource(endpoint, mediaContent, true);
+                        contents.emplace_back(endpoint, mediaContent);
                     }
                 }
+                strong->createIncomingSources(contents, true);
             } else {
+                std::vector<std::unique_ptr<IncomingVideoChannel>> removed;
                 for (const auto& [endpoint, mediaContent] : strong->pendingContent) {
                     if (mediaContent.type == MediaContent::Type::Video && mediaContent.isScreenCast() == isScreenCast) {
-                        strong->incomingVideoChannels.erase(endpoint);
+                        if (auto node = strong->incomingVideoChannels.extract(endpoint)) {
+                            removed.push_back(std::move(node.mapped()));
+                        }
                     }
                 }
+                strong->releaseIncomingChannels({}, std::move(removed));
             }
         });
     }
@@ -402,11 +691,36 @@ namespace wrtc {
             if (!strong) {
                 return;
             }
+            std::lock_guard lock(strong->mutex);
+            strong->channelsClosed = true;
             strong->pendingContent.clear();
+            auto audioChannels = drainChannels(strong->incomingAudioChannels);
+            auto videoChannels = drainChannels(strong->incomingVideoChannels);
+            for (const auto& channel : audioChannels) {
+                channel->setEnabled(false);
+            }
+            for (const auto& channel : videoChannels) {
+                channel->setEnabled(false);
+            }
+            // Every channel of this call leaves the transport in a single hop, queued behind any pending attach
+            strong->networkThread()->BlockingCall([&] {
+                if (strong->audioChannel) {
+                    strong->audioChannel->detachTransport();
+                }
+                if (strong->videoChannel) {
+                    strong->videoChannel->detachTransport();
+                }
+                for (const auto& channel : audioChannels) {
+                    channel->detachTransport();
+                }
+                for (const auto& channel : videoChannels) {
+                    channel->detachTransport();
+                }
+            });
             strong->audioChannel = nullptr;
             strong->videoChannel = nullptr;
-            strong->incomingAudioChannels.clear();
-            strong->incomingVideoChannels.clear();
+            audioChannels.clear();
+            videoChannels.clear();
             strong->remoteAudioSink.reset();
             strong->remoteVideoSink.reset();
             strong->remoteScreenCastSink.reset();
@@ -614,4 +928,125 @@ namespace wrtc {
         }
         return 1;
     }
+
+    CallStats NativeNetworkInterface::getStats(const bool cached) {
+        if (!cached) {
+            return collectStats();
+        }
+        std::lock_guard lock(statsMutex);
+        if (!statsRefreshing && webrtc::TimeMillis() - cachedStats.timestamp >= 1000) {
+            statsRefreshing = true;
+            std::weak_ptr weak(shared_from_this());
+            signalingThread()->PostTask([weak] {
+                if (const auto strong = weak.lock()) {
+                    (void) strong->collectStats();
+                }
+            });
+        }
+        return cachedStats;
+    }
+
+    void NativeNetworkInterface::rtpSent(const uint32_t ssrc, const uint32_t timestamp) {
+        const bool video = ssrc == sentVideo.ssrc;
+        if (!video && ssrc != sentAudio.ssrc) {
+            return;
+        }
+        auto& stream = video ? sentVideo : sentAudio;
+        if (stream.trackedSsrc != ssrc) {
+            stream.trackedSsrc = ssrc;
+            stream.unwrapper.Reset();
+            stream.lastTimestamp.reset();
+        }
+        // Later packets of a frame share its timestamp, retransmissions carry an older one
+        const auto unwrapped = stream.unwrapper.Unwrap(timestamp);
+        if (stream.lastTimestamp && unwrapped <= *stream.lastTimestamp) {
+            return;
+        }
+        stream.lastTimestamp = unwrapped;
+        // Opus is the only audio codec negotiated, video always runs at 90kHz
+        const auto mediaTimeMs = unwrapped / (video ? 90 : 48);
+        (void) frameSentCallback(video, mediaTimeMs, webrtc::TimeMicros());
+    }
+
+    CallStats NativeNetworkInterface::collectStats() {
+        CallStats stats;
+        // The lock is taken on the worker, like the channel cleanup does, never across the hop
+        workerThread()->BlockingCall([&] {
+            std::lock_guard lock(mutex);
+            if (call) {
+                const auto callStats = call->GetStats();
+                stats.sendBandwidth = std::max(callStats.send_bandwidth_bps, 0);
+                stats.receiveBandwidth = std::max(callStats.recv_bandwidth_bps, 0);
+                stats.pacerDelayMs = callStats.pacer_delay_ms;
+                stats.rttMs = static_cast<double>(std::max<int64_t>(callStats.rtt_ms, 0));
+            }
+            if (webrtc::VoiceMediaSendInfo info; audioChannel && audioChannel->getStats(&info)) {
+                for (const auto& sender : info.senders) {
+                    stats.streams.push_back(senderStats(sender, false));
+                }
+            }
+            if (webrtc::VideoMediaSendInfo info; videoChannel && videoChannel->getStats(&info)) {
+                for (const auto& sender : info.senders) {
+                    stats.streams.push_back(senderStats(sender, true));
+                }
+            }
+            for (const auto& channel : incomingAudioChannels | std::views::values) {
+                if (webrtc::VoiceMediaReceiveInfo info; channel->getStats(&info)) {
+                    for (const auto& receiver : info.receivers) {
+                        stats.streams.push_back(receiverStats(receiver, false));
+                    }
+                }
+            }
+            for (const auto& channel : incomingVideoChannels | std::views::values) {
+                if (webrtc::VideoMediaReceiveInfo info; channel->getStats(&info)) {
+                    for (const auto& receiver : info.receivers) {
+                        stats.streams.push_back(receiverStats(receiver, true));
+                    }
+                }
+            }
+        });
+        networkThread()->BlockingCall([&] {
+            webrtc::IceTransportStats iceStats;
+            if (!transportChannel) {
+                // Without ICE, e.g. on the null network, the SRTP transport sees every byte that goes out
+                if (dtlsSrtpTransport) {
+                    const auto* srtpTransport = static_cast<WrappedDtlsSrtpTransport*>(dtlsSrtpTransport.get());
+                    stats.transportBytesSent = srtpTransport->bytesSent();
+                    stats.transportBytesReceived = srtpTransport->bytesReceived();
+                }
+                return;
+            }
+            if (!transportChannel->GetStats(&iceStats)) {
+                return;
+            }
+            for (const auto& info : iceStats.connection_infos) {
+                if (!info.best_connection) {
+                    continue;
+                }
+                // The ICE round trip is measured even while no media flows
+                if (info.rtt) {
+                    stats.rttMs = static_cast<double>(info.rtt);
+                }
+                stats.transportBytesSent = info.sent_total_bytes;
+                stats.transportBytesReceived = info.recv_total_bytes;
+            }
+        });
+        stats.timestamp = webrtc::TimeMillis();
+
+        std::lock_guard lock(statsMutex);
+        if (const auto elapsed = stats.timestamp - cachedStats.timestamp; cachedStats.timestamp && elapsed > 0) {
+            std::map<std::pair<uint32_t, bool>, uint64_t> previousBytes;
+            for (const auto& stream : cachedStats.streams) {
+                previousBytes[{stream.ssrc, stream.outgoing}] = stream.bytes;
+            }
+            for (auto& stream : stats.streams) {
+                if (const auto it = previousBytes.find({stream.ssrc, stream.outgoing}); it != previousBytes.end() && stream.bytes >= it->second) {
+                    stream.bitrate = (stream.bytes - it->second) * 8000 / elapsed;
+                }
+            }
+        }
+        cachedStats = stats;
+        statsRefreshing = false;
+        return stats;
+    }
 } // wrtc
\ No newline at end of file
@@ -53,6 +53,10 @@ namespace wrtc {
         dataChannelMessageCallback = callback;
     }
 
+    void NetworkInterface::onFrameSent(const std::function<void(bool video, int64_t mediaTimeMs, int64_t sentAtUs)>& callback) {
+        frameSentCallback = callback;
+    }
+
     void NetworkInterface::close() {
         if (factory) {
             factory = nullptr;
@@ -78,4 +82,8 @@ namespace wrtc {
             cameraIncoming = enable;
         }
     }
+
+    CallStats NetworkInterface::getStats(bool) {
+        return {};
+    }
 } // wrtc
\ No newline at end of file
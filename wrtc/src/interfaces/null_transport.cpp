@@ -0,0 +1,121 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <rtc_base/time_utils.h>
+#include <wrtc/interfaces/null_transport.hpp>
+
+namespace wrtc {
+    NullTransport::NullTransport(const Mode mode, webrtc::Thread* networkThread): mode(mode), networkThread(networkThread), transportName("null") {}
+
+    const std::string& NullTransport::transport_name() const {
+        return transportName;
+    }
+
+    bool NullTransport::writable() const {
+        return true;
+    }
+
+    bool NullTransport::receiving() const {
+        return true;
+    }
+
+    int NullTransport::SendPacket(const char* data, const size_t len, const webrtc::AsyncSocketPacketOptions& options, const int flags) {
+        webrtc::SentPacketInfo sentPacket(options.packet_id, webrtc::TimeMillis(), options.info_signaled_after_sent);
+        sentPacket.info.packet_size_bytes = len;
+        NotifySentPacket(this, sentPacket);
+        // Only SRTP is handed back, anything else would be answered by ourselves
+        if (mode == Mode::Loopback && (flags & webrtc::PF_SRTP_BYPASS)) {
+            networkThread->PostTask(SafeTask(taskSafety.flag(), [this, packet = std::vector<uint8_t>(data, data + len)] {
+                NotifyPacketReceived(
+                    webrtc::ReceivedIpPacket(
+                        webrtc::MakeArrayView(packet.data(), packet.size()),
+                        webrtc::SocketAddress(),
+                        webrtc::Timestamp::Micros(webrtc::TimeMicros())
+                    )
+                );
+            }));
+        }
+        return static_cast<int>(len);
+    }
+
+    int NullTransport::SetOption(webrtc::Socket::Option opt, int value) {
+        return 0;
+    }
+
+    bool NullTransport::GetOption(webrtc::Socket::Option opt, int* value) {
+        return false;
+    }
+
+    int NullTransport::GetError() {
+        return 0;
+    }
+
+    std::optional<webrtc::NetworkRoute> NullTransport::network_route() const {
+        return std::nullopt;
+    }
+
+    webrtc::DtlsTransportState NullTransport::dtls_state() const {
+        return webrtc::DtlsTransportState::kNew;
+    }
+
+    int NullTransport::component() const {
+        return 0;
+    }
+
+    bool NullTransport::IsDtlsActive() const {
+        return false;
+    }
+
+    bool NullTransport::GetDtlsRole(webrtc::SSLRole* role) const {
+        return false;
+    }
+
+    bool NullTransport::SetDtlsRole(webrtc::SSLRole role) {
+        return false;
+    }
+
+    bool NullTransport::GetSslVersionBytes(int* version) const {
+        return false;
+    }
+
+    bool NullTransport::GetSrtpCryptoSuite(int* cipher) const {
+        return false;
+    }
+
+    bool NullTransport::GetSslCipherSuite(int* cipher) const {
+        return false;
+    }
+
+    std::optional<absl::string_view> NullTransport::GetTlsCipherSuiteName() const {
+        return std::nullopt;
+    }
+
+    uint16_t NullTransport::GetSslPeerSignatureAlgorithm() const {
+        return 0;
+    }
+
+    bool NullTransport::SetLocalCertificate(const webrtc::scoped_refptr<webrtc::RTCCertificate>& certificate) {
+        return false;
+    }
+
+    std::unique_ptr<webrtc::SSLCertChain> NullTransport::GetRemoteSSLCertChain() const {
+        return nullptr;
+    }
+
+    bool NullTransport::ExportSrtpKeyingMaterial(webrtc::ZeroOnFreeBuffer<uint8_t>& keying_material) {
+        return false;
+    }
+
+    webrtc::RTCError NullTransport::SetRemoteParameters(absl::string_view digest_alg, const uint8_t* digest, size_t digest_len, std::optional<webrtc::SSLRole> role) {
+        return webrtc::RTCError::OK();
+    }
+
+    webrtc::IceTransportInternal* NullTransport::ice_transport() {
+        return nullptr;
+    }
+
+    uint16_t NullTransport::GetSslGroupId() const {
+        return 0;
+    }
+} // wrtc
@@ -12,7 +12,9 @@
 #include <api/audio_codecs/builtin_audio_encoder_factory.h>
 #include <api/audio_codecs/builtin_audio_decoder_factory.h>
 #include <pc/media_factory.h>
+#include <rtc_base/physical_socket_server.h>
 #include <wrtc/interfaces/media/audio_device_module.hpp>
+#include <wrtc/interfaces/batched_packet_socket_factory.hpp>
 #include <wrtc/utils/java_context.hpp>
 
 extern "C" {
@@ -29,7 +31,9 @@ namespace wrtc {
 
     PeerConnectionFactory::PeerConnectionFactory() {
         av_log_set_level(AV_LOG_QUIET);
-        network_thread_ = webrtc::Thread::CreateWithSocketServer();
+        auto socketServer = std::make_unique<webrtc::PhysicalSocketServer>();
+        [[maybe_unused]] auto* physicalSocketServer = socketServer.get();
+        network_thread_ = std::make_unique<webrtc::Thread>(std::move(socketServer));
         network_thread_->SetName("ntg-net", nullptr);
         network_thread_->Start();
         worker_thread_ = webrtc::Thread::Create();
@@ -49,6 +53,11 @@ namespace wrtc {
         dependencies.worker_thread = worker_thread_.get();
         dependencies.signaling_thread = signaling_thread_.get();
         dependencies.env = env;
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+        auto socketFactory = std::make_unique<BatchedPacketSocketFactory>(physicalSocketServer);
+        batchedSocketFactory = socketFactory.get();
+        dependencies.packet_socket_factory = std::move(socketFactory);
+#endif
         dependencies.event_log_factory = std::make_unique<webrtc::RtcEventLogFactory>(&env.task_queue_factory());
         jniEnv = GetJNIEnv();
         dependencies.adm = worker_thread_->BlockingCall([&] {
@@ -66,7 +75,8 @@ namespace wrtc {
         dependencies.video_encoder_factory = config.CreateVideoEncoderFactory();
         dependencies.video_decoder_factory = config.CreateVideoDecoderFactory();
 #endif
-        dependencies.audio_mixer = nullptr;
+        _playoutMixer = webrtc::make_ref_counted<PlayoutMixer>();
+        dependencies.audio_mixer = _playoutMixer;
         supportedVideoFormats = dependencies.video_encoder_factory->GetSupportedFormats();
         EnableMedia(dependencies);
         if (!factory_) {
@@ -83,6 +93,7 @@ namespace wrtc {
             });
         }
         factory_ = nullptr;
+        _playoutMixer = nullptr;
         worker_thread_->Stop();
         signaling_thread_->Stop();
         network_thread_->Stop();
@@ -144,6 +155,18 @@ namespace wrtc {
         return supportedVideoFormats;
     }
 
+    PlayoutMixer* PeerConnectionFactory::playoutMixer() const {
+        return _playoutMixer.get();
+    }
+
+    void PeerConnectionFactory::setSharedSockets([[maybe_unused]] const uint32_t socketsPerAddress) const {
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+        if (batchedSocketFactory) {
+            static_cast<BatchedPacketSocketFactory*>(batchedSocketFactory)->setSharedSockets(socketsPerAddress);
+        }
+#endif
+    }
+
     PeerConnectionFactory* PeerConnectionFactory::GetOrCreateDefault() {
         std::lock_guard lock(_mutex);
         if (initialized == false) {
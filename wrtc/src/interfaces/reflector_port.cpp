@@ -18,6 +18,7 @@
 #include <api/transport/stun.h>
 #include <p2p/base/connection.h>
 #include <rtc_base/async_packet_socket.h>
+#include <rtc_base/byte_order.h>
 #include <rtc_base/checks.h>
 #include <rtc_base/logging.h>
 #include <rtc_base/net_helper.h>
@@ -394,47 +395,69 @@ namespace wrtc {
     }
 
     int ReflectorPort::SendTo(const void* data, size_t size, const webrtc::SocketAddress& addr, const webrtc::AsyncSocketPacketOptions& options, bool payload) {
-        webrtc::CopyOnWriteBuffer targetPeerTag;
-        auto syntheticHostname = addr.hostname();
-        uint32_t resolvedPeerTag = 0;
-        if (auto resolvedPeerTagIt = resolvedPeerTagsByHostname.find(syntheticHostname); resolvedPeerTagIt != resolvedPeerTagsByHostname.end()) {
-            resolvedPeerTag = resolvedPeerTagIt->second;
-        } else {
-            const auto prefixFormat = "reflector-" + std::to_string(static_cast<uint32_t>(serverId)) + "-";
-            std::string suffixFormat = ".reflector";
-            if (!absl::StartsWith(syntheticHostname, prefixFormat) || !absl::EndsWith(syntheticHostname, suffixFormat)) {
-                RTC_LOG(LS_ERROR) << ToString() << ": Discarding SendTo request with destination " << addr.ToString();
-                return -1;
-            }
-            auto startPosition = prefixFormat.size();
-            auto tagString = syntheticHostname.substr(startPosition, syntheticHostname.size() - suffixFormat.size() - startPosition);
-            std::stringstream tagStringStream(tagString);
-            tagStringStream >> resolvedPeerTag;
-            if (resolvedPeerTag == 0) {
-                RTC_LOG(LS_ERROR) << ToString() << ": Discarding SendTo request with destination " << addr.ToString() << " (could not parse peer tag)";
-                return -1;
-            }
-            resolvedPeerTagsByHostname.insert(std::make_pair(syntheticHostname, resolvedPeerTag));
+        const auto header = ResolveDataHeader(addr);
+        if (!header) {
+            return -1;
         }
-        targetPeerTag.AppendData(peerTag.data(), peerTag.size() - 4);
-        targetPeerTag.AppendData(reinterpret_cast<uint8_t*>(&resolvedPeerTag), 4);
-
-        webrtc::ByteBufferWriter bufferWriter;
-        bufferWriter.Write(webrtc::MakeArrayView(targetPeerTag.data(), targetPeerTag.size()));
-        bufferWriter.Write(webrtc::MakeArrayView(reinterpret_cast<const uint8_t*>(&randomTag), 4));
-
-        bufferWriter.WriteUInt32(static_cast<uint32_t>(size));
-        bufferWriter.Write(webrtc::MakeArrayView(static_cast<const uint8_t*>(data), size));
-        while (bufferWriter.Length() % 4 != 0) {
-            bufferWriter.WriteUInt8(0);
+        const size_t length = (header->size() + 4 + size + 3) & ~static_cast<size_t>(3);
+        if (sendBuffer.size() < length) {
+            sendBuffer.resize(length);
         }
+        auto* out = sendBuffer.data();
+        memcpy(out, header->data(), header->size());
+        webrtc::SetBE32(out + header->size(), static_cast<uint32_t>(size));
+        memcpy(out + header->size() + 4, data, size);
+        const size_t written = header->size() + 4 + size;
+        memset(out + written, 0, length - written);
+
         webrtc::AsyncSocketPacketOptions modified_options(options);
         CopyPortInformationToPacketInfo(&modified_options.info_signaled_after_sent);
-        modified_options.info_signaled_after_sent.turn_overhead_bytes = bufferWriter.Length() - size;
-        (void) Send(bufferWriter.Data(), bufferWriter.Length(), modified_options);
+        modified_options.info_signaled_after_sent.turn_overhead_bytes = length - size;
+        (void) Send(out, length, modified_options);
         return static_cast<int>(size);
     }
 
+    const ReflectorPort::DataHeader* ReflectorPort::ResolveDataHeader(const webrtc::SocketAddress& addr) {
+        const auto& syntheticHostname = addr.hostname();
+        if (const auto it = dataHeadersByHostname.find(syntheticHostname); it != dataHeadersByHostname.end()) {
+            return &it->second;
+        }
+        const auto prefixFormat = "reflector-" + std::to_string(static_cast<uint32_t>(serverId)) + "-";
+        const std::string suffixFormat = ".reflector";
+        if (!absl::StartsWith(syntheticHostname, prefixFormat) || !absl::EndsWith(syntheticHostname, suffixFormat)) {
+            RTC_LOG(LS_ERROR) << ToString() << ": Discarding SendTo request with destination " << addr.ToString();
+            return nullptr;
+        }
+        const auto startPosition = prefixFormat.size();
+        const auto tagString = syntheticHostname.substr(startPosition, syntheticHostname.size() - suffixFormat.size() - startPosition);
+        uint32_t resolvedPeerTag = 0;
+        std::stringstream tagStringStream(tagString);
+        tagStringStream >> resolvedPeerTag;
+        if (resolvedPeerTag == 0) {
+            RTC_LOG(LS_ERROR) << ToString() << ": Discarding SendTo request with destination " << addr.ToString() << " (could not parse peer tag)";
+            return nullptr;
+        }
+        DataHeader header{};
+        memcpy(header.data(), peerTag.data(), 16 - 4);
+        memcpy(header.data() + 16 - 4, &resolvedPeerTag, 4);
+        memcpy(header.data() + 16, &randomTag, 4);
+        return &dataHeadersByHostname.emplace(syntheticHostname, header).first->second;
+    }
+
+    const webrtc::SocketAddress& ReflectorPort::ResolveCandidateAddress(const uint32_t senderTag) {
+        if (const auto it = candidateAddressesByTag.find(senderTag); it != candidateAddressesByTag.end()) {
+            return it->second;
+        }
+        // Sender tags come from the wire, keep the cache bounded
+        if (candidateAddressesByTag.size() >= 256) {
+            candidateAddressesByTag.clear();
+        }
+        const auto ipFormat = "reflector-" + std::to_string(static_cast<uint32_t>(serverId)) + "-" + std::to_string(senderTag) + ".reflector";
+        webrtc::SocketAddress candidateAddress(ipFormat, serverAddress.address.port());
+        candidateAddress.SetResolvedIP(serverAddress.address.ipaddr());
+        return candidateAddressesByTag.emplace(senderTag, std::move(candidateAddress)).first->second;
+    }
+
     bool ReflectorPort::CanHandleIncomingPacketsFrom(const webrtc::SocketAddress& addr) const {
         return serverAddress.address == addr;
     }
@@ -528,9 +551,7 @@ namespace wrtc {
                     << ToString()
                     << ": Received data packet with invalid size tag";
                 } else {
-                    const auto ipFormat = "reflector-" + std::to_string(static_cast<uint32_t>(serverId)) + "-" + std::to_string(senderTag) + ".reflector";
-                    webrtc::SocketAddress candidateAddress(ipFormat, serverAddress.address.port());
-                    candidateAddress.SetResolvedIP(serverAddress.address.ipaddr());
+                    const auto& candidateAddress = ResolveCandidateAddress(senderTag);
                     int64_t packet_timestamp = -1;
                     if (packet_time_us.has_value()) {
                         packet_timestamp = packet_time_us->us_or(-1);
@@ -0,0 +1,338 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <wrtc/interfaces/shared_udp_socket.hpp>
+
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+#include <algorithm>
+#include <optional>
+#include <ranges>
+#include <rtc_base/byte_order.h>
+#include <rtc_base/logging.h>
+
+namespace wrtc {
+    namespace {
+        // USERNAME of a STUN binding request, without parsing the whole message
+        std::optional<std::string_view> bindingRequestUsername(const uint8_t* data, const size_t size) {
+            if (size < 20 || (data[0] & 0xc0) != 0 || webrtc::GetBE16(data) != 0x0001 || webrtc::GetBE32(data + 4) != 0x2112a442) {
+                return std::nullopt;
+            }
+            const size_t end = std::min<size_t>(size, 20 + webrtc::GetBE16(data + 2));
+            for (size_t offset = 20; offset + 4 <= end;) {
+                const auto type = webrtc::GetBE16(data + offset);
+                const size_t length = webrtc::GetBE16(data + offset + 2);
+                if (offset + 4 + length > end) {
+                    break;
+                }
+                if (type == 0x0006) {
+                    return std::string_view(reinterpret_cast<const char*>(data + offset + 4), length);
+                }
+                offset += 4 + ((length + 3) & ~static_cast<size_t>(3));
+            }
+            return std::nullopt;
+        }
+    }
+
+    std::atomic_uint32_t SharedUdpSocketPool::totalSockets = 0;
+    std::atomic_uint32_t SharedUdpSocketPool::totalHandles = 0;
+    std::atomic_uint32_t SharedUdpSocketPool::totalOverflowSockets = 0;
+    std::atomic_uint64_t SharedUdpSocketPool::unroutedPackets = 0;
+
+    SharedUdpSocketPool::SharedUdpSocketPool(webrtc::PhysicalSocketServer* server, const uint32_t socketsPerAddress): server(server), socketsPerAddress(socketsPerAddress) {}
+
+    SharedUdpSocketPool::~SharedUdpSocketPool() {
+        totalSockets -= static_cast<uint32_t>(entries.size());
+        totalOverflowSockets -= static_cast<uint32_t>(std::ranges::count_if(entries, [](const auto& entry) {
+            return entry->overflow;
+        }));
+        entries.clear();
+    }
+
+    void SharedUdpSocketPool::setSocketsPerAddress(const uint32_t size) {
+        socketsPerAddress = size;
+    }
+
+    std::unique_ptr<webrtc::AsyncPacketSocket> SharedUdpSocketPool::CreateSocket(const webrtc::SocketAddress& address) {
+        const auto limit = std::max<uint32_t>(socketsPerAddress, 1);
+        Entry* selected = nullptr;
+        uint32_t sameAddress = 0;
+        for (const auto& entry : entries) {
+            if (entry->ip != address.ipaddr()) {
+                continue;
+            }
+            sameAddress++;
+            if (!selected || entry->handles < selected->handles) {
+                selected = entry.get();
+            }
+        }
+        if (!selected || sameAddress < limit) {
+            if (auto* entry = CreateEntry(address.ipaddr())) {
+                selected = entry;
+            }
+        }
+        if (!selected) {
+            return nullptr;
+        }
+        selected->handles++;
+        totalHandles++;
+        return std::make_unique<SharedUdpSocket>(this, selected);
+    }
+
+    SharedUdpSocketPool::Stats SharedUdpSocketPool::GetStats() {
+        return {
+            totalSockets,
+            totalHandles,
+            totalOverflowSockets,
+            unroutedPackets,
+        };
+    }
+
+    int SharedUdpSocketPool::SendTo(SharedUdpSocket* handle, const void* data, const size_t size, const webrtc::SocketAddress& addr, const webrtc::AsyncSocketPacketOptions& options) {
+        const auto key = RouteKey(addr);
+        auto* entry = handle->entry;
+        if (const auto spill = handle->spills.find(key); spill != handle->spills.end()) {
+            entry = spill->second;
+        } else if (const auto [route, _] = entry->routes.try_emplace(key, handle); route->second != handle) {
+            // The remote tells calls apart by 5-tuple, so this call reaches it from another shared socket
+            entry = Spill(handle, key);
+            if (!entry) {
+                handle->SetError(EADDRINUSE);
+                return -1;
+            }
+        }
+        if (const auto username = bindingRequestUsername(static_cast<const uint8_t*>(data), size)) {
+            // Outgoing checks carry "remote:local", learn the local ufrag to route the peer's checks back.
+            // A spilled call learns it on its own socket too, which is where its candidate points.
+            if (const auto separator = username->find(':'); separator != std::string_view::npos) {
+                const auto ufrag = username->substr(separator + 1);
+                for (auto* target : {entry, handle->entry}) {
+                    if (!target->ufrags.contains(ufrag)) {
+                        target->ufrags.emplace(std::string(ufrag), handle);
+                    }
+                }
+            }
+        }
+        const int result = entry->socket->SendTo(data, size, addr, options);
+        if (result < 0) {
+            handle->SetError(entry->socket->GetError());
+            return result;
+        }
+        entry->inFlight.push_back(handle);
+        return result;
+    }
+
+    void SharedUdpSocketPool::Release(SharedUdpSocket* handle) {
+        for (auto* entry : handle->SpillEntries()) {
+            Detach(entry, handle);
+        }
+        handle->spills.clear();
+        Detach(handle->entry, handle);
+        totalHandles--;
+    }
+
+    void SharedUdpSocketPool::Detach(Entry* entry, SharedUdpSocket* handle) {
+        std::erase_if(entry->routes, [handle](const auto& route) {
+            return route.second == handle;
+        });
+        std::erase_if(entry->ufrags, [handle](const auto& ufrag) {
+            return ufrag.second == handle;
+        });
+        std::ranges::replace(entry->inFlight, handle, nullptr);
+        if (--entry->handles == 0) {
+            if (entry->overflow) {
+                totalOverflowSockets--;
+            }
+            std::erase_if(entries, [entry](const auto& e) {
+                return e.get() == entry;
+            });
+            totalSockets--;
+        }
+    }
+
+    void SharedUdpSocketPool::Route(Entry* entry, const webrtc::ReceivedIpPacket& packet) {
+        const auto key = RouteKey(packet.source_address());
+        // Checks carry "local:remote", which also covers remotes we never sent to
+        const auto payload = packet.payload();
+        if (const auto username = bindingRequestUsername(payload.data(), payload.size())) {
+            const auto ufrag = username->substr(0, username->find(':'));
+            if (const auto owner = entry->ufrags.find(ufrag); owner != entry->ufrags.end()) {
+                entry->routes.try_emplace(key, owner->second);
+                owner->second->Deliver(packet);
+                return;
+            }
+        }
+        if (const auto route = entry->routes.find(key); route != entry->routes.end()) {
+            route->second->Deliver(packet);
+            return;
+        }
+        unroutedPackets++;
+    }
+
+    SharedUdpSocketPool::Entry* SharedUdpSocketPool::CreateEntry(const webrtc::IPAddress& ip) {
+        auto socket = BatchedUdpSocket::Create(server, webrtc::SocketAddress(ip, 0), 0, 0);
+        if (!socket) {
+            return nullptr;
+        }
+        auto entry = std::make_unique<Entry>();
+        entry->ip = ip;
+        entry->socket = std::move(socket);
+        entry->socket->RegisterReceivedPacketCallback([this, raw = entry.get()](webrtc::AsyncPacketSocket*, const webrtc::ReceivedIpPacket& packet) {
+            Route(raw, packet);
+        });
+        entry->socket->SignalSentPacket.connect(this, &SharedUdpSocketPool::OnSentPacket);
+        entry->socket->SignalReadyToSend.connect(this, &SharedUdpSocketPool::OnReadyToSend);
+        totalSockets++;
+        return entries.emplace_back(std::move(entry)).get();
+    }
+
+    SharedUdpSocketPool::Entry* SharedUdpSocketPool::Spill(SharedUdpSocket* handle, const webrtc::SocketAddress& key) {
+        // Least loaded shared socket that carries no call to this remote yet, a new one only when all of them do
+        Entry* selected = nullptr;
+        for (const auto& entry : entries) {
+            if (entry->ip == handle->entry->ip && !entry->routes.contains(key) && (!selected || entry->handles < selected->handles)) {
+                selected = entry.get();
+            }
+        }
+        if (!selected) {
+            selected = CreateEntry(handle->entry->ip);
+            if (!selected) {
+                return nullptr;
+            }
+            selected->overflow = true;
+            totalOverflowSockets++;
+        }
+        if (const auto used = handle->SpillEntries(); std::ranges::find(used, selected) == used.end()) {
+            selected->handles++;
+            for (const auto& [opt, value] : handle->options) {
+                selected->socket->SetOption(opt, value);
+            }
+        }
+        selected->routes.emplace(key, handle);
+        handle->spills.emplace(key, selected);
+        RTC_LOG(LS_VERBOSE) << "Shared socket " << handle->localAddress.ToSensitiveString() << " reaches " << key.ToSensitiveString() << " through " << selected->socket->GetLocalAddress().ToSensitiveString();
+        return selected;
+    }
+
+    SharedUdpSocketPool::Entry* SharedUdpSocketPool::FindEntry(const webrtc::AsyncPacketSocket* socket) const {
+        for (const auto& entry : entries) {
+            if (entry->socket.get() == socket) {
+                return entry.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void SharedUdpSocketPool::OnSentPacket(webrtc::AsyncPacketSocket* socket, const webrtc::SentPacketInfo& sentPacket) {
+        auto* entry = FindEntry(socket);
+        if (!entry || entry->inFlight.empty()) {
+            return;
+        }
+        auto* handle = entry->inFlight.front();
+        entry->inFlight.pop_front();
+        if (handle) {
+            handle->SignalSentPacket(handle, sentPacket);
+        }
+    }
+
+    void SharedUdpSocketPool::OnReadyToSend(webrtc::AsyncPacketSocket* socket) {
+        const auto* entry = FindEntry(socket);
+        if (!entry) {
+            return;
+        }
+        std::vector<SharedUdpSocket*> handles;
+        for (const auto& handle : entry->routes | std::views::values) {
+            if (std::ranges::find(handles, handle) == handles.end()) {
+                handles.push_back(handle);
+            }
+        }
+        for (auto* handle : handles) {
+            handle->SignalReadyToSend(handle);
+        }
+    }
+
+    webrtc::SocketAddress SharedUdpSocketPool::RouteKey(const webrtc::SocketAddress& address) {
+        // Sends may carry a hostname and IPv4 arrives mapped on dual stack sockets
+        return {address.ipaddr().Normalized(), address.port()};
+    }
+
+    SharedUdpSocket::SharedUdpSocket(SharedUdpSocketPool* pool, SharedUdpSocketPool::Entry* entry):
+        pool(pool), entry(entry), localAddress(entry->socket->GetLocalAddress()) {}
+
+    SharedUdpSocket::~SharedUdpSocket() {
+        Close();
+    }
+
+    webrtc::SocketAddress SharedUdpSocket::GetLocalAddress() const {
+        return localAddress;
+    }
+
+    webrtc::SocketAddress SharedUdpSocket::GetRemoteAddress() const {
+        return {};
+    }
+
+    int SharedUdpSocket::Send(const void*, size_t, const webrtc::AsyncSocketPacketOptions&) {
+        SetError(ENOTCONN);
+        return -1;
+    }
+
+    int SharedUdpSocket::SendTo(const void* data, const size_t size, const webrtc::SocketAddress& addr, const webrtc::AsyncSocketPacketOptions& options) {
+        if (!entry) {
+            SetError(EBADF);
+            return -1;
+        }
+        return pool->SendTo(this, data, size, addr, options);
+    }
+
+    int SharedUdpSocket::Close() {
+        if (entry) {
+            pool->Release(this);
+            entry = nullptr;
+        }
+        return 0;
+    }
+
+    webrtc::AsyncPacketSocket::State SharedUdpSocket::GetState() const {
+        return entry ? STATE_BOUND : STATE_CLOSED;
+    }
+
+    int SharedUdpSocket::GetOption(const webrtc::Socket::Option opt, int* value) {
+        if (const auto it = options.find(opt); it != options.end()) {
+            *value = it->second;
+            return 0;
+        }
+        return entry ? entry->socket->GetOption(opt, value) : -1;
+    }
+
+    int SharedUdpSocket::SetOption(const webrtc::Socket::Option opt, const int value) {
+        // Applied to the shared socket as well, the last call to set an option wins
+        options[opt] = value;
+        for (const auto* spill : SpillEntries()) {
+            spill->socket->SetOption(opt, value);
+        }
+        return entry ? entry->socket->SetOption(opt, value) : -1;
+    }
+
+    int SharedUdpSocket::GetError() const {
+        return error;
+    }
+
+    void SharedUdpSocket::SetError(const int error) {
+        this->error = error;
+    }
+
+    void SharedUdpSocket::Deliver(const webrtc::ReceivedIpPacket& packet) {
+        NotifyPacketReceived(packet);
+    }
+
+    std::vector<SharedUdpSocketPool::Entry*> SharedUdpSocket::SpillEntries() const {
+        std::vector<SharedUdpSocketPool::Entry*> result;
+        for (auto* entry : spills | std::views::values) {
+            if (std::ranges::find(result, entry) == result.end()) {
+                result.push_back(entry);
+            }
+        }
+        return result;
+    }
+} // wrtc
+#endif
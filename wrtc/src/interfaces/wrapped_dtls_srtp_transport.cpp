@@ -4,7 +4,10 @@
 
 #include <modules/rtp_rtcp/source/rtp_packet_received.h>
 #include <wrtc/interfaces/wrapped_dtls_srtp_transport.hpp>
+#include <modules/rtp_rtcp/source/byte_io.h>
 #include <modules/rtp_rtcp/source/rtp_util.h>
+#include <wrtc/utils/metrics.hpp>
+#include <wrtc/utils/tracer.hpp>
 
 namespace wrtc {
     template <typename Tag, typename Tag::pfn_t pfn>
@@ -34,6 +37,9 @@ namespace wrtc {
             return;
         }
 
+        metrics::rtpPacketsReceived.add();
+        metrics::rtpBytesReceived.add(packet.payload().size());
+        totalBytesReceived += packet.payload().size();
         webrtc::CopyOnWriteBuffer payload(packet.payload());
         if (!(this->*c_pfn_SrtpTransport_UnprotectRtp)(payload)) {
             if (decryptionFailureCount % 100 == 0) {
@@ -52,12 +58,54 @@ namespace wrtc {
         parsedPacket.set_ecn(packet.ecn());
 
         if (parsedPacket.Parse(payload)) {
+            WRTC_TRACE_INSTANT("rtp.receive", parsedPacket.Ssrc());
             (void) rtpPacketCallback(parsedPacket);
         }
 
         DemuxPacket(payload, packet.arrival_time().value_or(webrtc::Timestamp::MinusInfinity()), packet.ecn());
     }
 
+    bool WrappedDtlsSrtpTransport::SendRtpPacket(webrtc::CopyOnWriteBuffer* packet, const webrtc::AsyncSocketPacketOptions& options, const int flags) {
+        const auto ssrc = webrtc::ParseRtpSsrc(*packet);
+        const auto timestamp = webrtc::ByteReader<uint32_t>::ReadBigEndian(packet->cdata() + 4);
+        WRTC_TRACE_INSTANT("rtp.send", ssrc);
+        metrics::rtpPacketsSent.add();
+        metrics::rtpBytesSent.add(packet->size());
+        const auto sent = DtlsSrtpTransport::SendRtpPacket(packet, options, flags);
+        if (sent) {
+            totalBytesSent += packet->size();
+            if (rtpSentCallback) {
+                rtpSentCallback(ssrc, timestamp);
+            }
+        }
+        return sent;
+    }
+
+    void WrappedDtlsSrtpTransport::OnRtcpPacketReceived(const webrtc::ReceivedIpPacket& packet) {
+        totalBytesReceived += packet.payload().size();
+        DtlsSrtpTransport::OnRtcpPacketReceived(packet);
+    }
+
+    bool WrappedDtlsSrtpTransport::SendRtcpPacket(webrtc::CopyOnWriteBuffer* packet, const webrtc::AsyncSocketPacketOptions& options, const int flags) {
+        const auto sent = DtlsSrtpTransport::SendRtcpPacket(packet, options, flags);
+        if (sent) {
+            totalBytesSent += packet->size();
+        }
+        return sent;
+    }
+
+    void WrappedDtlsSrtpTransport::onRtpSent(const std::function<void(uint32_t ssrc, uint32_t timestamp)>& callback) {
+        rtpSentCallback = callback;
+    }
+
+    uint64_t WrappedDtlsSrtpTransport::bytesSent() const {
+        return totalBytesSent;
+    }
+
+    uint64_t WrappedDtlsSrtpTransport::bytesReceived() const {
+        return totalBytesReceived;
+    }
+
     void WrappedDtlsSrtpTransport::UpdateRtpHeaderExtensionMap(const webrtc::RtpHeaderExtensions& headerExtensions) {
         headerExtensionMap = webrtc::RtpHeaderExtensionMap(headerExtensions);
         DtlsSrtpTransport::UpdateRtpHeaderExtensionMap(headerExtensions);
@@ -6,10 +6,10 @@
 
 #include <media/base/media_engine.h>
 #include <p2p/base/transport_description.h>
-#include <rtc_base/rtc_certificate_generator.h>
 #include <pc/webrtc_session_description_factory.h>
 
 #include <wrtc/exceptions.hpp>
+#include <wrtc/utils/certificate_pool.hpp>
 
 namespace wrtc {
     ContentNegotiationContext::ContentNegotiationContext(
@@ -20,11 +20,7 @@ namespace wrtc {
         webrtc::PayloadTypeSuggester *payloadTypeSuggester
     ) :isOutgoing(isOutgoing), uniqueRandomIdGenerator(uniqueRandomIdGenerator) {
         transportDescriptionFactory = std::make_unique<webrtc::TransportDescriptionFactory>(env.field_trials());
-        const auto tempCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(
-            webrtc::KeyParams(webrtc::KT_ECDSA),
-            std::nullopt
-        );
-        transportDescriptionFactory->set_certificate(tempCertificate);
+        transportDescriptionFactory->set_certificate(CertificatePool::GetOrCreateDefault()->take());
         codecLookupHelper = std::make_unique<CodecLookupHelper>(
             mediaEngine,
             transportDescriptionFactory.get(),
@@ -235,7 +231,7 @@ namespace wrtc {
                 if (std::to_string(channel.ssrc) == id) {
                     found = true;
                     auto mappedContent = convertSignalingContentToContentInfo(std::to_string(channel.ssrc), channel, webrtc::RtpTransceiverDirection::kRecvOnly);
-                    auto localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(webrtc::KT_ECDSA), std::nullopt);
+                    const auto& localCertificate = transportDescriptionFactory->certificate();
                     std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
                     if (localCertificate) {
                         fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*localCertificate);
@@ -259,7 +255,7 @@ namespace wrtc {
                 if (channel.id == id) {
                     found = true;
                     auto mappedContent = convertSignalingContentToContentInfo(channel.id, channel.content, webrtc::RtpTransceiverDirection::kSendOnly);
-                    auto localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(webrtc::KT_ECDSA), std::nullopt);
+                    const auto& localCertificate = transportDescriptionFactory->certificate();
                     std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
                     if (localCertificate) {
                         fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*localCertificate);
@@ -282,7 +278,7 @@ namespace wrtc {
 
             if (!found) {
                 auto mappedContent = createInactiveContentInfo("_" + id);
-                auto localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(webrtc::KT_ECDSA), std::nullopt);
+                const auto& localCertificate = transportDescriptionFactory->certificate();
                 std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
                 if (localCertificate) {
                     fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*localCertificate);
@@ -504,7 +500,7 @@ namespace wrtc {
                         contentDescription.header_extensions.emplace_back(extension.uri, extension.id);
                     }
                     answerOptions.media_description_options.push_back(contentDescription);
-                    auto localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(webrtc::KT_ECDSA), std::nullopt);
+                    const auto& localCertificate = transportDescriptionFactory->certificate();
                     std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
                     if (localCertificate) {
                         fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*localCertificate);
@@ -533,7 +529,7 @@ namespace wrtc {
                         contentDescription.header_extensions.emplace_back(extension.uri, extension.id);
                     }
                     answerOptions.media_description_options.push_back(contentDescription);
-                    auto localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(webrtc::KT_ECDSA), std::nullopt);
+                    const auto& localCertificate = transportDescriptionFactory->certificate();
                     std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
                     if (localCertificate) {
                         fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*localCertificate);
@@ -557,7 +553,7 @@ namespace wrtc {
                 auto mappedContent = createInactiveContentInfo("_" + id);
                 webrtc::MediaDescriptionOptions contentDescription(webrtc::MediaType::AUDIO, "_" + id, webrtc::RtpTransceiverDirection::kInactive, false);
                 answerOptions.media_description_options.push_back(contentDescription);
-                auto localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(webrtc::KT_ECDSA), std::nullopt);
+                const auto& localCertificate = transportDescriptionFactory->certificate();
                 std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
                 if (localCertificate) {
                     fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*localCertificate);
@@ -581,7 +577,7 @@ namespace wrtc {
                 channelIdOrder.push_back(std::to_string(content.ssrc));
                 answerOptions.media_description_options.push_back(getIncomingContentDescription(content));
                 auto mappedContent = convertSignalingContentToContentInfo(std::to_string(content.ssrc), content, webrtc::RtpTransceiverDirection::kSendOnly);
-                auto localCertificate = webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(webrtc::KT_ECDSA), std::nullopt);
+                const auto& localCertificate = transportDescriptionFactory->certificate();
                 std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
                 if (localCertificate) {
                     fingerprint = webrtc::SSLFingerprint::CreateFromCertificate(*localCertificate);
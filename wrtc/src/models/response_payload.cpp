@@ -83,6 +83,36 @@ namespace wrtc {
         }
     }
 
+    json ResponsePayload::defaultMedia() {
+        return json::parse(R"({
+            "audio": {
+                "payload-types": [
+                    {"id": 111, "name": "opus", "clockrate": 48000, "channels": 2, "parameters": {"minptime": 10, "useinbandfec": 1}, "rtcp-fbs": [{"type": "transport-cc"}]}
+                ],
+                "rtp-hdrexts": [
+                    {"id": 1, "uri": "urn:ietf:params:rtp-hdrext:ssrc-audio-level"},
+                    {"id": 2, "uri": "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"},
+                    {"id": 3, "uri": "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01"}
+                ]
+            },
+            "video": {
+                "payload-types": [
+                    {"id": 100, "name": "VP8", "clockrate": 90000, "rtcp-fbs": [{"type": "goog-remb"}, {"type": "transport-cc"}, {"type": "ccm", "subtype": "fir"}, {"type": "nack"}, {"type": "nack", "subtype": "pli"}]},
+                    {"id": 101, "name": "rtx", "clockrate": 90000, "parameters": {"apt": 100}},
+                    {"id": 102, "name": "VP9", "clockrate": 90000, "rtcp-fbs": [{"type": "goog-remb"}, {"type": "transport-cc"}, {"type": "ccm", "subtype": "fir"}, {"type": "nack"}, {"type": "nack", "subtype": "pli"}]},
+                    {"id": 103, "name": "rtx", "clockrate": 90000, "parameters": {"apt": 102}},
+                    {"id": 104, "name": "H264", "clockrate": 90000, "parameters": {"level-asymmetry-allowed": 1, "packetization-mode": 1, "profile-level-id": "42e01f"}, "rtcp-fbs": [{"type": "goog-remb"}, {"type": "transport-cc"}, {"type": "ccm", "subtype": "fir"}, {"type": "nack"}, {"type": "nack", "subtype": "pli"}]},
+                    {"id": 105, "name": "rtx", "clockrate": 90000, "parameters": {"apt": 104}}
+                ],
+                "rtp-hdrexts": [
+                    {"id": 2, "uri": "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"},
+                    {"id": 3, "uri": "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01"},
+                    {"id": 13, "uri": "urn:3gpp:video-orientation"}
+                ]
+            }
+        }));
+    }
+
     std::vector<webrtc::RtpExtension> ResponsePayload::parseRtpExtensions(const json& data) {
         std::vector<webrtc::RtpExtension> result;
         for (const auto& extension : data["rtp-hdrexts"]) {
@@ -0,0 +1,128 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <rtc_base/logging.h>
+#include <rtc_base/rtc_certificate_generator.h>
+#include <wrtc/utils/certificate_pool.hpp>
+#include <wrtc/utils/metrics.hpp>
+
+namespace wrtc {
+    std::mutex CertificatePool::_mutex{};
+    CertificatePool* CertificatePool::_default = nullptr;
+
+    CertificatePool::CertificatePool() {
+        thread = webrtc::Thread::Create();
+        thread->SetName("ntg-cert", nullptr);
+        thread->Start();
+        std::lock_guard lock(mutex);
+        scheduleRefill();
+    }
+
+    CertificatePool::~CertificatePool() {
+        thread->Stop();
+    }
+
+    CertificatePool* CertificatePool::GetOrCreateDefault() {
+        std::lock_guard lock(_mutex);
+        if (!_default) {
+            _default = new CertificatePool();
+        }
+        return _default;
+    }
+
+    webrtc::scoped_refptr<webrtc::RTCCertificate> CertificatePool::take() {
+        {
+            std::lock_guard lock(mutex);
+            purgeExpired();
+            if (!ready.empty()) {
+                auto certificate = std::move(ready.front().certificate);
+                ready.pop_front();
+                scheduleRefill();
+                metrics::certificatePoolHits.add();
+                return certificate;
+            }
+            scheduleRefill();
+        }
+        metrics::certificatePoolMisses.add();
+        RTC_LOG(LS_WARNING) << "Certificate pool exhausted, generating inline";
+        return generate();
+    }
+
+    void CertificatePool::configure(const size_t size, const std::chrono::seconds lifetime) {
+        std::lock_guard lock(mutex);
+        targetSize = size;
+        this->lifetime = lifetime;
+        while (ready.size() > targetSize) {
+            ready.pop_back();
+        }
+        purgeExpired();
+        scheduleRefill();
+    }
+
+    webrtc::scoped_refptr<webrtc::RTCCertificate> CertificatePool::generate() {
+        return webrtc::RTCCertificateGenerator::GenerateCertificate(
+            webrtc::KeyParams(webrtc::KT_ECDSA),
+            std::nullopt
+        );
+    }
+
+    void CertificatePool::purgeExpired() {
+        if (lifetime.count() == 0) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        while (!ready.empty() && now - ready.front().createdAt >= lifetime) {
+            ready.pop_front();
+        }
+    }
+
+    void CertificatePool::scheduleRefill() {
+        if (refilling || ready.size() >= targetSize) {
+            return;
+        }
+        refilling = true;
+        thread->PostTask([this] {
+            refill();
+        });
+    }
+
+    void CertificatePool::scheduleRotation() {
+        if (rotationScheduled || targetSize == 0 || lifetime.count() == 0) {
+            return;
+        }
+        rotationScheduled = true;
+        thread->PostDelayedTask([this] {
+            std::lock_guard lock(mutex);
+            rotationScheduled = false;
+            purgeExpired();
+            scheduleRefill();
+            scheduleRotation();
+        }, webrtc::TimeDelta::Seconds(lifetime.count()));
+    }
+
+    void CertificatePool::refill() {
+        while (true) {
+            {
+                std::lock_guard lock(mutex);
+                purgeExpired();
+                if (ready.size() >= targetSize) {
+                    refilling = false;
+                    scheduleRotation();
+                    return;
+                }
+            }
+            auto certificate = generate();
+            if (!certificate) {
+                std::lock_guard lock(mutex);
+                refilling = false;
+                return;
+            }
+            std::lock_guard lock(mutex);
+            // The pool may have been shrunk while generating
+            if (ready.size() < targetSize) {
+                ready.push_back({std::move(certificate), std::chrono::steady_clock::now()});
+            }
+        }
+    }
+} // wrtc
@@ -0,0 +1,144 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <wrtc/utils/metrics.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+
+namespace wrtc {
+    namespace {
+        std::string formatDouble(const double value) {
+            std::ostringstream out;
+            out << std::setprecision(std::numeric_limits<double>::digits10) << value;
+            return out.str();
+        }
+    }
+
+    std::atomic<Metric*> Metric::head = nullptr;
+    std::atomic_size_t Counter::nextShard = 0;
+
+    Metric::Metric(const Type type, const char* name, const char* help, const char* labels): type(type), name(name), help(help), labels(labels) {
+        next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    std::string Metric::exportText() {
+        std::vector<const Metric*> registered;
+        for (auto metric = head.load(std::memory_order_acquire); metric; metric = metric->next) {
+            registered.push_back(metric);
+        }
+        // The registry is a stack, reversing keeps declaration order among samples of the same name
+        std::ranges::reverse(registered);
+        std::ranges::stable_sort(registered, [](const Metric* a, const Metric* b) {
+            return std::strcmp(a->name, b->name) < 0;
+        });
+        std::ostringstream out;
+        const char* previous = nullptr;
+        for (const auto metric : registered) {
+            if (!previous || std::strcmp(previous, metric->name) != 0) {
+                out << "# HELP " << metric->name << ' ' << metric->help << '\n';
+                out << "# TYPE " << metric->name << ' ';
+                switch (metric->type) {
+                case Type::Counter:
+                    out << "counter";
+                    break;
+                case Type::Gauge:
+                    out << "gauge";
+                    break;
+                case Type::Histogram:
+                    out << "histogram";
+                    break;
+                }
+                out << '\n';
+                previous = metric->name;
+            }
+            metric->write(out);
+        }
+        return out.str();
+    }
+
+    void Metric::writeSample(std::ostringstream& out, const char* suffix, const std::string& extraLabel, const std::string& value) const {
+        out << name << suffix;
+        const bool hasLabels = *labels != '\0';
+        if (hasLabels || !extraLabel.empty()) {
+            out << '{' << labels;
+            if (hasLabels && !extraLabel.empty()) {
+                out << ',';
+            }
+            out << extraLabel << '}';
+        }
+        out << ' ' << value << '\n';
+    }
+
+    Counter::Counter(const char* name, const char* help, const char* labels): Metric(Type::Counter, name, help, labels) {}
+
+    uint64_t Counter::value() const {
+        uint64_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void Counter::write(std::ostringstream& out) const {
+        writeSample(out, "", {}, std::to_string(value()));
+    }
+
+    size_t Counter::shardIndex() {
+        thread_local const size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return index;
+    }
+
+    Gauge::Gauge(const char* name, const char* help, const char* labels): Metric(Type::Gauge, name, help, labels) {}
+
+    int64_t Gauge::value() const {
+        return current.load(std::memory_order_relaxed);
+    }
+
+    void Gauge::write(std::ostringstream& out) const {
+        writeSample(out, "", {}, std::to_string(value()));
+    }
+
+    Histogram::Histogram(const char* name, const char* help, const std::initializer_list<double> bounds, const char* labels):
+        Metric(Type::Histogram, name, help, labels), bounds(bounds), counts(std::make_unique<std::atomic_uint64_t[]>(bounds.size() + 1)) {}
+
+    void Histogram::observe(const double value) {
+        const auto bucket = std::ranges::lower_bound(bounds, value) - bounds.begin();
+        counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        auto current = sum.load(std::memory_order_relaxed);
+        while (!sum.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {}
+    }
+
+    void Histogram::write(std::ostringstream& out) const {
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < bounds.size(); i++) {
+            cumulative += counts[i].load(std::memory_order_relaxed);
+            writeSample(out, "_bucket", "le=\"" + formatDouble(bounds[i]) + "\"", std::to_string(cumulative));
+        }
+        cumulative += counts[bounds.size()].load(std::memory_order_relaxed);
+        writeSample(out, "_bucket", "le=\"+Inf\"", std::to_string(cumulative));
+        writeSample(out, "_sum", {}, formatDouble(sum.load(std::memory_order_relaxed)));
+        writeSample(out, "_count", {}, std::to_string(cumulative));
+    }
+
+    namespace metrics {
+        Gauge activeCalls("ntgcalls_active_calls", "Calls currently held by all instances");
+        Gauge activeReaders("ntgcalls_active_readers", "Media readers currently open");
+        Gauge eventQueueDepth("ntgcalls_event_queue_depth", "Events waiting to be delivered to callbacks");
+        Gauge mixerQueueDepth("ntgcalls_mixer_queue_depth", "Audio frames queued in threaded mixers");
+        Counter audioUnderruns("ntgcalls_audio_underruns_total", "Playout ticks where a remote audio source had no frame buffered");
+        Counter droppedAudioFrames("ntgcalls_dropped_frames_total", "Frames discarded before reaching their destination", "stream=\"audio\",reason=\"jitter_buffer\"");
+        Counter droppedVideoFrames("ntgcalls_dropped_frames_total", "Frames discarded before reaching their destination", "stream=\"video\",reason=\"static\"");
+        Counter rtpBytesSent("ntgcalls_rtp_sent_bytes_total", "RTP bytes handed to the transport before encryption");
+        Counter rtpBytesReceived("ntgcalls_rtp_received_bytes_total", "RTP bytes received from the transport before decryption");
+        Counter rtpPacketsSent("ntgcalls_rtp_sent_packets_total", "RTP packets handed to the transport");
+        Counter rtpPacketsReceived("ntgcalls_rtp_received_packets_total", "RTP packets received from the transport");
+        Counter certificatePoolHits("ntgcalls_certificate_pool_takes_total", "DTLS certificates handed out to connections", "result=\"hit\"");
+        Counter certificatePoolMisses("ntgcalls_certificate_pool_takes_total", "DTLS certificates handed out to connections", "result=\"miss\"");
+        Histogram joinLatency("ntgcalls_join_latency_seconds", "Time from starting a connection to it being established", {0.25, 0.5, 1, 2, 4, 8, 16, 32});
+    } // metrics
+} // wrtc
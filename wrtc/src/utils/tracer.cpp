@@ -0,0 +1,141 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <wrtc/utils/tracer.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <rtc_base/platform_thread_types.h>
+#include <rtc_base/thread.h>
+
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+#include <sys/prctl.h>
+#endif
+
+namespace wrtc {
+    namespace {
+        void writeEscaped(std::ostringstream& out, const std::string_view value) {
+            for (const char c : value) {
+                if (c == '"' || c == '\\') {
+                    out << '\\' << c;
+                } else if (static_cast<unsigned char>(c) >= 0x20) {
+                    out << c;
+                }
+            }
+        }
+
+        std::string currentThreadName() {
+            if (const auto thread = webrtc::Thread::Current(); thread && !thread->name().empty()) {
+                return thread->name();
+            }
+#if defined(IS_LINUX) || defined(IS_ANDROID)
+            char name[16] = {};
+            if (prctl(PR_GET_NAME, name) == 0) {
+                return name;
+            }
+#endif
+            return {};
+        }
+    }
+
+    std::atomic_bool Tracer::active = false;
+    std::atomic_size_t Tracer::capacity = kDefaultCapacity;
+    std::mutex Tracer::mutex;
+    std::vector<std::unique_ptr<Tracer::Ring>> Tracer::rings;
+
+    Tracer::RingHandle::~RingHandle() {
+        if (ring) {
+            std::lock_guard lock(mutex);
+            ring->retired = true;
+        }
+    }
+
+    void Tracer::setEnabled(const bool enable, const size_t eventsPerThread) {
+        capacity = std::max<size_t>(eventsPerThread, 1);
+        active = enable;
+    }
+
+    void Tracer::instant(const char* name, const int64_t arg) {
+        if (enabled()) {
+            record(name, webrtc::TimeMicros(), -1, arg);
+        }
+    }
+
+    void Tracer::record(const char* name, const int64_t start, const int64_t duration, const int64_t arg) {
+        auto* ring = currentRing();
+        const auto index = ring->head.load(std::memory_order_relaxed);
+        auto& slot = ring->slots[index % ring->capacity];
+        slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.duration.store(duration, std::memory_order_relaxed);
+        slot.arg.store(arg, std::memory_order_relaxed);
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+        ring->head.store(index + 1, std::memory_order_release);
+    }
+
+    Tracer::Ring* Tracer::currentRing() {
+        thread_local RingHandle handle;
+        if (handle.ring) {
+            return handle.ring;
+        }
+        const auto wanted = capacity.load();
+        std::lock_guard lock(mutex);
+        // Rings of exited threads are handed over instead of growing the registry with every short-lived thread
+        for (const auto& ring : rings) {
+            if (ring->retired && ring->capacity == wanted) {
+                ring->retired = false;
+                ring->base = ring->head.load(std::memory_order_relaxed);
+                handle.ring = ring.get();
+                break;
+            }
+        }
+        if (!handle.ring) {
+            auto ring = std::make_unique<Ring>();
+            ring->slots = std::make_unique<Slot[]>(wanted);
+            ring->capacity = wanted;
+            handle.ring = ring.get();
+            rings.push_back(std::move(ring));
+        }
+        handle.ring->threadId = static_cast<int64_t>(webrtc::CurrentThreadId());
+        handle.ring->threadName = currentThreadName();
+        return handle.ring;
+    }
+
+    std::string Tracer::exportJson() {
+        std::ostringstream out;
+        out << R"({"displayTimeUnit":"ms","traceEvents":[{"name":"process_name","ph":"M","pid":1,"args":{"name":"ntgcalls"}})";
+        std::lock_guard lock(mutex);
+        for (const auto& ring : rings) {
+            out << R"(,{"name":"thread_name","ph":"M","pid":1,"tid":)" << ring->threadId << R"(,"args":{"name":")";
+            writeEscaped(out, ring->threadName);
+            out << R"("}})";
+            const auto head = ring->head.load(std::memory_order_acquire);
+            const auto first = std::max(ring->base, head > ring->capacity ? head - ring->capacity : 0);
+            for (auto index = first; index < head; index++) {
+                const auto& slot = ring->slots[index % ring->capacity];
+                const auto sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto name = slot.name.load(std::memory_order_relaxed);
+                const auto start = slot.start.load(std::memory_order_relaxed);
+                const auto duration = slot.duration.load(std::memory_order_relaxed);
+                const auto arg = slot.arg.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                // Skip slots the owner overwrote while they were being copied
+                if (sequence != index * 2 + 2 || slot.sequence.load(std::memory_order_relaxed) != sequence || !name) {
+                    continue;
+                }
+                out << R"(,{"name":")" << name << R"(","cat":"media","pid":1,"tid":)" << ring->threadId << R"(,"ts":)" << start;
+                if (duration >= 0) {
+                    out << R"(,"ph":"X","dur":)" << duration;
+                } else {
+                    out << R"(,"ph":"i","s":"t")";
+                }
+                out << R"(,"args":{"arg":)" << arg << "}}";
+            }
+        }
+        out << "]}";
+        return out.str();
+    }
+} // wrtc
@@ -0,0 +1,78 @@
+//
+// Created by Laky64 on 19/10/26.
+//
+
+#include <wrtc/video_factory/traced_video_codec.hpp>
+#include <wrtc/utils/tracer.hpp>
+
+namespace wrtc {
+    TracedVideoEncoder::TracedVideoEncoder(std::unique_ptr<webrtc::VideoEncoder> encoder): encoder(std::move(encoder)) {}
+
+    void TracedVideoEncoder::SetFecControllerOverride(webrtc::FecControllerOverride* fecControllerOverride) {
+        encoder->SetFecControllerOverride(fecControllerOverride);
+    }
+
+    int32_t TracedVideoEncoder::InitEncode(const webrtc::VideoCodec* codecSettings, const Settings& settings) {
+        return encoder->InitEncode(codecSettings, settings);
+    }
+
+    int32_t TracedVideoEncoder::RegisterEncodeCompleteCallback(webrtc::EncodedImageCallback* callback) {
+        return encoder->RegisterEncodeCompleteCallback(callback);
+    }
+
+    int32_t TracedVideoEncoder::Release() {
+        return encoder->Release();
+    }
+
+    int32_t TracedVideoEncoder::Encode(const webrtc::VideoFrame& frame, const std::vector<webrtc::VideoFrameType>* frameTypes) {
+        WRTC_TRACE_SCOPE("video.encode", static_cast<int64_t>(frame.width()) * frame.height());
+        return encoder->Encode(frame, frameTypes);
+    }
+
+    void TracedVideoEncoder::SetRates(const RateControlParameters& parameters) {
+        encoder->SetRates(parameters);
+    }
+
+    void TracedVideoEncoder::OnPacketLossRateUpdate(const float packetLossRate) {
+        encoder->OnPacketLossRateUpdate(packetLossRate);
+    }
+
+    void TracedVideoEncoder::OnRttUpdate(const int64_t rttMs) {
+        encoder->OnRttUpdate(rttMs);
+    }
+
+    void TracedVideoEncoder::OnLossNotification(const LossNotification& lossNotification) {
+        encoder->OnLossNotification(lossNotification);
+    }
+
+    webrtc::VideoEncoder::EncoderInfo TracedVideoEncoder::GetEncoderInfo() const {
+        return encoder->GetEncoderInfo();
+    }
+
+    TracedVideoDecoder::TracedVideoDecoder(std::unique_ptr<webrtc::VideoDecoder> decoder): decoder(std::move(decoder)) {}
+
+    bool TracedVideoDecoder::Configure(const Settings& settings) {
+        return decoder->Configure(settings);
+    }
+
+    int32_t TracedVideoDecoder::Decode(const webrtc::EncodedImage& inputImage, const bool missingFrames, const int64_t renderTimeMs) {
+        WRTC_TRACE_SCOPE("video.decode", static_cast<int64_t>(inputImage.size()));
+        return decoder->Decode(inputImage, missingFrames, renderTimeMs);
+    }
+
+    int32_t TracedVideoDecoder::RegisterDecodeCompleteCallback(webrtc::DecodedImageCallback* callback) {
+        return decoder->RegisterDecodeCompleteCallback(callback);
+    }
+
+    int32_t TracedVideoDecoder::Release() {
+        return decoder->Release();
+    }
+
+    webrtc::VideoDecoder::DecoderInfo TracedVideoDecoder::GetDecoderInfo() const {
+        return decoder->GetDecoderInfo();
+    }
+
+    const char* TracedVideoDecoder::ImplementationName() const {
+        return decoder->ImplementationName();
+    }
+} // wrtc
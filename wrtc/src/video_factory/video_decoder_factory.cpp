@@ -3,6 +3,8 @@
 //
 
 #include <wrtc/video_factory/video_decoder_factory.hpp>
+#include <wrtc/utils/tracer.hpp>
+#include <wrtc/video_factory/traced_video_codec.hpp>
 
 namespace wrtc {
     // TODO: Needed template like this:
@@ -13,7 +15,16 @@ namespace wrtc {
         for (const auto& enc : decoders) {
             for (auto supported_formats = formats_[n++]; const auto& f : supported_formats) {
                 if (f.IsSameCodec(format)) {
+#ifdef NTG_TRACING
+                    auto codec = enc.CreateVideoCodec(env, format);
+                    // Only codecs created while tracing is on pay for the decorator
+                    if (codec && Tracer::enabled()) {
+                        return std::make_unique<TracedVideoDecoder>(std::move(codec));
+                    }
+                    return codec;
+#else
                     return enc.CreateVideoCodec(env, format);
+#endif
                 }
             }
         }